@@ -6,6 +6,8 @@
 #include "Animation/AnimationStepMovement.hpp"
 #include "Animation/AnimationStepRotation.hpp"
 
+class BinaryReader;
+class BinaryWriter;
 class SceneNode;
 
 class Animation
@@ -51,6 +53,11 @@ class Animation
         //void pause();
         void stop();
 
+        // Write and read the progress of the animation (see WorldSnapshot), 
+        // the steps and listeners are not stored
+        void saveState(BinaryWriter &writer) const;
+        void loadState(BinaryReader &reader);
+
         void setOnAnimationStartedListener(std::function<void()> listener);
         void setOnAnimationCompletedListener(std::function<void()> listener);
         void setOnAnimationStoppedListener(std::function<void()> listener);
@@ -0,0 +1,22 @@
+#ifndef COLLISIONBENCHMARK_HPP
+#define COLLISIONBENCHMARK_HPP
+#include <SFML/Graphics.hpp>
+#include <string>
+
+class CollisionWorld;
+
+// Micro benchmarks of the collision tests, which can be started from the debug
+// console. Each function returns a short report of the measured times
+namespace CollisionBenchmark
+{
+    // Test every pair of a fixed set of random rects for the given number of 
+    // rounds with the oriented box SAT and the vertices SAT
+    std::string runRectRect(std::size_t rounds);
+    // Run the given number of random segment casts against the level, segment 
+    // casts against all layers, circle casts and area queries in the area of
+    // the world
+    std::string runRaycast(const CollisionWorld &world, sf::FloatRect area, 
+            std::size_t rounds);
+};
+
+#endif // COLLISIONBENCHMARK_HPP
@@ -15,6 +15,7 @@ class CollisionCircle : public CollisionShape
         float getRadius() const;
 
         virtual void draw(sf::RenderTarget &target, sf::RenderStates states) const;
+        virtual CollisionShapeTypes getShapeType() const;
 
         virtual CollisionInfo isColliding(CollisionShape &collider);
 
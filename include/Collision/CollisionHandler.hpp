@@ -18,8 +18,41 @@ class CollisionHandler
         //explicit CollisionHandler(SceneNode *sceneGraph);
         static CollisionInfo isColliding(CollisionCircle &objA, CollisionCircle &objB);
         static CollisionInfo isColliding(CollisionRect &objA, CollisionRect &objB);
+        // The separating axis is the index of the axis (0 to 3) which separated 
+        // the rects in the last test or -1. This axis is tested first and is 
+        // updated with the result of this test
+        static CollisionInfo isColliding(CollisionRect &objA, CollisionRect &objB,
+                int &separatingAxis);
         static CollisionInfo isColliding(CollisionCircle &objA, CollisionRect &objB);
         static CollisionInfo isColliding(CollisionRect &objA, CollisionCircle &objB);
+        // SAT test of two rects with its vertices and all edge normals, which is
+        // slower then the test with the oriented boxes. It is kept as reference 
+        // for the collision benchmark
+        static CollisionInfo isCollidingVerticesSAT(CollisionRect &objA, 
+                CollisionRect &objB);
+
+        // Swept tests for continuous collision detection. The moving shape is at 
+        // its end position, the obstacle is not moving. When the moving shape 
+        // hits the obstacle on the way, true is returned and the time of impact
+        // is set to the part of the way (0 to 1) which can be moved without
+        // collision. When the shapes already collide at the start false is 
+        // returned, because this is handled by the discrete test.
+        static bool sweep(CollisionCircle &moving, sf::Vector2f displacement,
+                CollisionRect &obstacle, float &timeOfImpact);
+        static bool sweep(CollisionRect &moving, sf::Vector2f displacement,
+                CollisionRect &obstacle, float &timeOfImpact);
+        // Ray tests, the direction has to be normalized. When the ray hits the
+        // shape before the max distance, true is returned and the distance and
+        // the surface normal at the hit point are set. A ray which starts 
+        // inside of the shape hits it at distance 0.
+        // The box can be enlarged by the inflation, which is used for circle 
+        // casts (The corners stay sharp, so it is a bit conservative there)
+        static bool raycast(const OrientedBox &box, float inflation, 
+                sf::Vector2f origin, sf::Vector2f direction, float maxDistance, 
+                float &distance, sf::Vector2f &normal);
+        static bool raycast(sf::Vector2f center, float radius, 
+                sf::Vector2f origin, sf::Vector2f direction, float maxDistance, 
+                float &distance, sf::Vector2f &normal);
 
     private:
 
@@ -32,6 +65,11 @@ class CollisionHandler
                 sf::Vector2f &dir);
 
         // For SAT
+        // Create the collision info of colliding shapes with the axis of the
+        // smallest overlap
+        static CollisionInfo createSATCollisionInfo(CollisionShape &objA, 
+                CollisionShape &objB, sf::Vector2f dirVecAB, float overlap, 
+                sf::Vector2f collisionAxis);
         static std::pair<float, float> getProjectionSAT(
                 sf::Vector2f axis, const std::vector<sf::Vector2f> &Vertices);
         // Return the perpendicular, normalized vectors to edges of the shape, 
@@ -1,6 +1,7 @@
 #ifndef COLLISIONINFO_HPP
 #define COLLISIONINFO_HPP
 #include <SFML/Graphics.hpp>
+#include "Collision/EnumContactStates.hpp"
 
 class SceneNode;
 
@@ -14,6 +15,7 @@ class CollisionInfo
         sf::Vector2f m_resolveDirSecond;
         SceneNode *const m_collidedFirst;
         SceneNode *const m_collidedSecond;
+        ContactStates m_contactState;
 
     public:
         explicit CollisionInfo(const bool isCollision);
@@ -26,6 +28,8 @@ class CollisionInfo
         sf::Vector2f getResolveDirOfSecond() const;
         SceneNode* getCollidedFirst() const;
         SceneNode* getCollidedSecond() const;
+        ContactStates getContactState() const;
+        void setContactState(ContactStates contactState);
 };
 
 #endif // COLLISIONINFO_HPP
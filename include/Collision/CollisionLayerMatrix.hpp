@@ -0,0 +1,62 @@
+#ifndef COLLISIONLAYERMATRIX_HPP
+#define COLLISIONLAYERMATRIX_HPP
+#include "Collision/CollisionInfo.hpp"
+#include "Collision/EnumCollisionLayers.hpp"
+#include <functional>
+
+class SceneNode;
+
+/* Stores which collision layers interact with each other and which handler 
+ * is called for their collisions. The broadphase only creates pairs of 
+ * interacting layers, so e.g. level tiles are never tested against each other.
+ * A handler gets the nodes always in the order of the layers which were 
+ * passed to setInteraction().
+ */
+class CollisionLayerMatrix
+{
+    public:
+        using Handler = std::function<void(SceneNode*, SceneNode*, 
+                CollisionInfo&)>;
+        // Used by the queries of the collision world to select the layers
+        static const unsigned int ALL_LAYERS{ ~0u };
+
+    private:
+        static const std::size_t LayerCnt{ 
+            static_cast<std::size_t>(CollisionLayers::COUNT) };
+
+        struct Cell
+        {
+            bool interacts;
+            // The nodes have to be swapped before calling the handler
+            bool isSwapped;
+            Handler handler;
+        };
+
+        Cell m_cells[LayerCnt][LayerCnt];
+
+    public:
+        CollisionLayerMatrix();
+
+        // Get the layer of a node with the given types. When a node has more 
+        // types the layer with the highest priority is used:
+        // PROJECTILE, WEAPON, SHIELD, WARRIOR, LEVEL
+        static CollisionLayers getLayer(unsigned int types);
+        // Get the bit of the layer in a layer mask
+        static unsigned int getLayerMask(CollisionLayers layer);
+
+        // Let the layers interact, the handler can be empty
+        void setInteraction(CollisionLayers layerA, CollisionLayers layerB, 
+                Handler handler);
+        void removeInteraction(CollisionLayers layerA, CollisionLayers layerB);
+        bool interacts(CollisionLayers layerA, CollisionLayers layerB) const;
+
+        // Call the handler of the layers of the collided nodes. Returns false 
+        // when there is no handler
+        bool dispatch(CollisionInfo &collisionInfo) const;
+
+    private:
+        Cell& getCell(CollisionLayers layerA, CollisionLayers layerB);
+        const Cell& getCell(CollisionLayers layerA, CollisionLayers layerB) const;
+};
+
+#endif // COLLISIONLAYERMATRIX_HPP
@@ -2,6 +2,7 @@
 #define COLLISIONRECT_HPP
 #include <SFML/Graphics.hpp>
 #include "Collision/CollisionShape.hpp"
+#include "Collision/OrientedBox.hpp"
 #include "Components/SceneNode.hpp"
 
 class CollisionRect : public CollisionShape
@@ -11,6 +12,10 @@ class CollisionRect : public CollisionShape
         float m_width;
         float m_height;
         std::vector<sf::Vector2f> m_vertices;
+        // The box in world coordinates, which is computed once per collision 
+        // frame
+        OrientedBox m_orientedBox;
+        unsigned int m_orientedBoxFrame;
     public:
 
         explicit CollisionRect(sf::Vector2f rectSize);
@@ -20,11 +25,18 @@ class CollisionRect : public CollisionShape
         // Determine where the vertices of the rect are and put them into the m_vertices vector.
         // The vertices are added clockwise.
         void computeVertices();
+        // Compute the vertices by rotating every vertex like before the 
+        // oriented boxes, only used as reference by the CollisionBenchmark
+        void computeVerticesReference();
         std::vector<sf::Vector2f> getVertices() const;
+        // Get the rect in world coordinates. The box is only recomputed when the
+        // CollisionShape::collisionFrame changed since the last call
+        const OrientedBox& getOrientedBox();
 
         sf::Vector2f support();
 
         virtual void draw(sf::RenderTarget &target, sf::RenderStates states) const;
+        virtual CollisionShapeTypes getShapeType() const;
 
         virtual CollisionInfo isColliding(CollisionShape &collider);
 
@@ -2,6 +2,7 @@
 #define COLLISIONSHAPE_HPP
 #include <SFML/Graphics.hpp>
 #include <Collision/CollisionInfo.hpp>
+#include "Collision/EnumCollisionShapeTypes.hpp"
 #include "Components/SceneNode.hpp"
 
 class SceneNode;
@@ -13,12 +14,16 @@ class CollisionShape : public sf::Transformable, public sf::Drawable
 {
     public:
         static bool drawCollisionShapes;
+        // Is increased before each collision check of the scene, so shapes can
+        // cache data which depends on the world transform for one check
+        static unsigned int collisionFrame;
     protected:
         SceneNode *m_parent;
     public:
         CollisionShape();
 
         virtual void draw(sf::RenderTarget &target, sf::RenderStates states) const = 0;
+        virtual CollisionShapeTypes getShapeType() const = 0;
 
         // The World position depends on the parent position (the position is the relative position to the parents position)
         sf::Transform getWorldTransform() const;
@@ -0,0 +1,137 @@
+#ifndef COLLISIONWORLD_HPP
+#define COLLISIONWORLD_HPP
+#include <SFML/Graphics.hpp>
+#include "Collision/CollisionInfo.hpp"
+#include "Collision/CollisionLayerMatrix.hpp"
+#include "Collision/ContactCache.hpp"
+#include "Collision/NarrowPhaseBatch.hpp"
+#include "Collision/TileGrid.hpp"
+#include <vector>
+
+class SceneNode;
+class CollisionShape;
+
+/* Finds the collisions of the scene in two phases. The broadphase sorts the
+ * bounding boxes of all collision shapes along the x axis and only pairs
+ * whose boxes overlap (sort and sweep) are passed to the narrowphase, which
+ * tests them in batches grouped by shape types.
+ * A pair is only tested, when at least one of the nodes is active and the 
+ * layers of the nodes interact.
+ * The pairs are tracked from frame to frame by the ContactCache, so every
+ * collision info contains if the contact begins or stays.
+ * The world can also be queried with rays, circle casts and areas (e.g. for 
+ * the line of sight of the AI). The queries use the state of the last 
+ * update(), so moved nodes are found at their positions of the last collision
+ * check.
+ */
+class CollisionWorld
+{
+    public:
+        // A fast moving node, which would have passed through an obstacle
+        // in the last frame
+        struct SweepHit
+        {
+            SceneNode *node;
+            SceneNode *obstacle;
+            // The part of the movement (0 to 1) until the node hits the 
+            // obstacle
+            float timeOfImpact;
+        };
+
+        struct RayHit
+        {
+            SceneNode *node;
+            // The distance from the origin of the ray to the hit point
+            float distance;
+            sf::Vector2f point;
+            // The normal of the surface at the hit point
+            sf::Vector2f normal;
+        };
+
+    private:
+        struct Entry
+        {
+            SceneNode *node;
+            CollisionShape *shape;
+            CollisionLayers layer;
+            // The node is stored in the tile grid
+            bool isTile;
+            // The axis aligned bounding box of the shape in world coordinates
+            float minX;
+            float minY;
+            float maxX;
+            float maxY;
+        };
+
+        SceneNode *m_sceneGraph;
+        std::vector<SceneNode*> m_nodes;
+        std::vector<Entry> m_entries;
+        CollisionLayerMatrix m_layerMatrix;
+        NarrowPhaseBatch m_narrowPhase;
+        TileGrid m_tileGrid;
+        ContactCache m_contactCache;
+        std::size_t m_broadPhasePairCnt;
+
+    public:
+        CollisionWorld();
+
+        // Collect the collision shapes of the scene graph and compute their
+        // bounding boxes. Has to be called, after the nodes were moved
+        void update(SceneNode &sceneGraph);
+        // Add the collision infos of all colliding pairs to the container
+        void findCollisions(std::vector<CollisionInfo> &collisionData);
+
+        // Check with swept tests if active nodes which are moved further than 
+        // half of their size in the last frame, hit a passive node on the way.
+        // Only the first hit of each node is added to the container
+        void findSweepHits(std::vector<SweepHit> &sweepHits);
+        // Remove the nodes which will be removed from the scene graph (Or 
+        // their parents will), so the queries dont use them anymore
+        void removeDestroyed();
+        // Forget the contacts of the last frames, has to be called when the 
+        // nodes were changed from outside (e.g. by restoring a snapshot)
+        void clearContacts();
+
+        // Find the first node hit by the ray. The direction has to be 
+        // normalized and only nodes in the layers of the mask are tested 
+        // (see CollisionLayerMatrix::getLayerMask())
+        bool raycast(sf::Vector2f origin, sf::Vector2f direction, 
+                float maxDistance, RayHit &hit, 
+                unsigned int layerMask = CollisionLayerMatrix::ALL_LAYERS) const;
+        // Find the first node between the two points
+        bool segmentCast(sf::Vector2f from, sf::Vector2f to, RayHit &hit, 
+                unsigned int layerMask = CollisionLayerMatrix::ALL_LAYERS) const;
+        // Find the first node hit by a circle which moves between the points.
+        // The hit point is the center of the circle when it hits the node
+        bool circleCast(sf::Vector2f from, sf::Vector2f to, float radius, 
+                RayHit &hit, 
+                unsigned int layerMask = CollisionLayerMatrix::ALL_LAYERS) const;
+        // Add the nodes whose bounding boxes overlap the area
+        void queryArea(const sf::FloatRect &area, std::vector<SceneNode*> &nodes, 
+                unsigned int layerMask = CollisionLayerMatrix::ALL_LAYERS) const;
+
+        // Get the number of pairs, which were passed to the narrowphase
+        std::size_t getBroadPhasePairCnt() const;
+        CollisionLayerMatrix& getLayerMatrix();
+        // The colliding tiles of the level, used to speed up the ray queries
+        TileGrid& getTileGrid();
+        const TileGrid& getTileGrid() const;
+        const ContactCache::Stats& getContactStats() const;
+
+    private:
+        void addToNarrowPhase(Entry &entryA, Entry &entryB, 
+                ContactCache::Entry &contact);
+        // Get the half of the smallest side of the shape
+        float getMinHalfSize(CollisionShape &shape) const;
+        bool sweep(Entry &moving, sf::Vector2f displacement, Entry &obstacle, 
+                float &timeOfImpact) const;
+        // Cast a circle along the ray, a ray cast is a cast with radius 0
+        bool cast(sf::Vector2f origin, sf::Vector2f direction, float maxDistance,
+                float radius, RayHit &hit, unsigned int layerMask) const;
+        // Cast against a single shape and update the hit, if it is closer
+        void castAgainst(SceneNode &node, CollisionShape &shape, 
+                sf::Vector2f origin, sf::Vector2f direction, float radius, 
+                RayHit &hit) const;
+};
+
+#endif // COLLISIONWORLD_HPP
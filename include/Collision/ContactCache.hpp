@@ -0,0 +1,70 @@
+#ifndef CONTACTCACHE_HPP
+#define CONTACTCACHE_HPP
+#include "Collision/CollisionInfo.hpp"
+#include <cstdint>
+#include <unordered_map>
+
+class SceneNode;
+
+/* Stores the pairs of the broadphase from frame to frame, so it is known if a
+ * contact begins, stays or ends. The game logic (e.g. weapon hits) can then 
+ * react only once to a contact instead of in every frame of the contact.
+ * For the rect pairs the last separating axis is stored, so the SAT test can 
+ * start with it, because when two shapes were separated in the last frame 
+ * they are most likely separated by the same axis in this frame.
+ * The pairs are identified by the ids of the nodes, not by their addresses, 
+ * because a new node can get the address of a destroyed node.
+ */
+class ContactCache
+{
+    public:
+        struct Entry
+        {
+            unsigned int lastSeenFrame;
+            unsigned int lastCollisionFrame;
+            // The sum of the contact epochs of the nodes when the contact began
+            unsigned int epoch;
+            bool isTouching;
+            // The index of the last separating axis of the SAT test or -1
+            int separatingAxis;
+        };
+
+        struct Stats
+        {
+            std::size_t pairCnt;
+            std::size_t beginCnt;
+            std::size_t stayCnt;
+            std::size_t endCnt;
+        };
+
+    private:
+        std::unordered_map<std::uint64_t, Entry> m_entries;
+        unsigned int m_frame;
+        Stats m_stats;
+
+    public:
+        ContactCache();
+
+        void beginFrame();
+        // Get the entry of the pair and mark it as seen in this frame. The 
+        // reference stays valid until endFrame() is called
+        Entry& getEntry(const SceneNode &nodeA, const SceneNode &nodeB);
+        // Set the contact state (begin or stay) of the collision
+        void addCollision(CollisionInfo &collisionInfo);
+        // Count the ended contacts and remove the pairs, which were not seen in
+        // this frame
+        void endFrame();
+        // Forget all pairs, so all actual contacts begin again (e.g. after a
+        // snapshot was restored)
+        void clear();
+
+        const Stats& getStats() const;
+
+    private:
+        static std::uint64_t getKey(const SceneNode &nodeA, 
+                const SceneNode &nodeB);
+        static unsigned int getEpoch(const SceneNode &nodeA, 
+                const SceneNode &nodeB);
+};
+
+#endif // CONTACTCACHE_HPP
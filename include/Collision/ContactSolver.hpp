@@ -0,0 +1,87 @@
+#ifndef CONTACTSOLVER_HPP
+#define CONTACTSOLVER_HPP
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class Entity;
+
+/* Resolves all contacts of a frame together instead of pushing the entities
+ * apart one contact after the other. The contacts are relaxed in several
+ * Gauss-Seidel iterations, each contact uses the corrections the other
+ * contacts already made in the same iteration. The correction of a contact 
+ * is split depending on the mass of the entities, the heavier one is moved 
+ * less. Static obstacles (like the level) are not moved at all.
+ * So a warrior which is pushed into a corner or between other warriors comes
+ * to rest in one frame.
+ */
+class ContactSolver
+{
+    public:
+        struct Stats
+        {
+            std::size_t contactCnt;
+            std::size_t bodyCnt;
+            // The number of iterations until the solver converged (or the 
+            // maximal number of iterations)
+            std::size_t iterations;
+            // The biggest penetration before and after solving
+            float initialPenetration;
+            float remainingPenetration;
+        };
+
+    private:
+        struct Body
+        {
+            Entity *entity;
+            float inverseMass;
+            // The sum of the corrections of all contacts of the body
+            sf::Vector2f correction;
+        };
+
+        struct Contact
+        {
+            // Index of the bodies in m_bodies, bodyB is NO_BODY for static
+            // obstacles
+            std::size_t bodyA;
+            std::size_t bodyB;
+            // Normalized direction in which bodyA has to be moved
+            sf::Vector2f normal;
+            float penetration;
+        };
+
+        static const std::size_t NO_BODY;
+
+        std::size_t m_maxIterations;
+        // Penetrations smaller than the tolerance count as resolved
+        float m_tolerance;
+        std::vector<Body> m_bodies;
+        std::vector<Contact> m_contacts;
+        Stats m_stats;
+
+    public:
+        ContactSolver(std::size_t maxIterations, float tolerance);
+
+        // The iterations are clamped to 1 to 64
+        void setMaxIterations(std::size_t maxIterations);
+        std::size_t getMaxIterations() const;
+
+        // Add the contact between two entities, the normal is the direction in
+        // which entityA have to be moved to resolve the contact
+        void addContact(Entity *entityA, Entity *entityB, sf::Vector2f normal, 
+                float penetration);
+        // Add the contact of an entity with a static obstacle
+        void addStaticContact(Entity *entity, sf::Vector2f normal, 
+                float penetration);
+
+        // Solve the added contacts, move the entities and remove the contacts
+        void solve();
+        // Get the statistics of the last solve() call
+        const Stats& getStats() const;
+
+    private:
+        std::size_t getBodyIndex(Entity *entity);
+        // Get the penetration of the contact with the actual corrections
+        float getCurrentPenetration(const Contact &contact) const;
+};
+
+#endif // CONTACTSOLVER_HPP
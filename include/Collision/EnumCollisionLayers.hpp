@@ -0,0 +1,17 @@
+#ifndef ENUMCOLLISIONLAYERS_HPP
+#define ENUMCOLLISIONLAYERS_HPP
+
+// Every node with a collision shape is in exactly one layer, which is derived
+// from its WorldObjectTypes (see CollisionLayerMatrix::getLayer())
+enum class CollisionLayers
+{
+    NONE,
+    LEVEL,
+    WARRIOR,
+    SHIELD,
+    WEAPON,
+    PROJECTILE,
+    COUNT
+};
+
+#endif // ENUMCOLLISIONLAYERS_HPP
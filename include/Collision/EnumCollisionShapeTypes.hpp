@@ -0,0 +1,12 @@
+#ifndef ENUMCOLLISIONSHAPETYPES_HPP
+#define ENUMCOLLISIONSHAPETYPES_HPP
+
+// Used to sort the shapes into batches without the double dispatch of the
+// CollisionShape::isColliding() methods
+enum class CollisionShapeTypes
+{
+    CIRCLE,
+    RECT
+};
+
+#endif // ENUMCOLLISIONSHAPETYPES_HPP
@@ -0,0 +1,19 @@
+#ifndef ENUMCONTACTSTATES_HPP
+#define ENUMCONTACTSTATES_HPP
+
+/*
+ *  The state of a contact between two SceneNodes, which is determined by the
+ *  ContactCache.
+ *  "BEGIN" means the nodes collide in this frame, but not in the frame before
+ *  (or a new contact epoch was started, e.g. by a new attack of a weapon).
+ *  "STAY" means the nodes already collided in the frame before.
+ */
+
+enum class ContactStates
+{
+    NONE,
+    BEGIN,
+    STAY
+};
+
+#endif // ENUMCONTACTSTATES_HPP
@@ -0,0 +1,87 @@
+#ifndef NARROWPHASEBATCH_HPP
+#define NARROWPHASEBATCH_HPP
+#include <SFML/Graphics.hpp>
+#include "Collision/CollisionCircle.hpp"
+#include "Collision/CollisionInfo.hpp"
+#include "Collision/CollisionRect.hpp"
+#include <vector>
+
+class SceneNode;
+
+/* Tests the candidate pairs of the broadphase in batches, one batch for each
+ * combination of shape types. The shape data of the circle-circle and
+ * circle-rect pairs is stored as structure of arrays, so four pairs are tested
+ * at once with SSE (When SSE2 is not available a scalar loop is used).
+ * Only for the pairs which collide a CollisionInfo is created, with the same
+ * content as CollisionHandler::isColliding() creates it.
+ * The containers keep their memory between the frames, so after the first
+ * frames the batch dont allocate.
+ */
+class NarrowPhaseBatch
+{
+    private:
+        struct CircleCircleBatch
+        {
+            std::vector<float> posXA;
+            std::vector<float> posYA;
+            std::vector<float> radiusA;
+            std::vector<float> posXB;
+            std::vector<float> posYB;
+            std::vector<float> radiusB;
+            std::vector<SceneNode*> nodeA;
+            std::vector<SceneNode*> nodeB;
+        };
+
+        struct CircleRectBatch
+        {
+            std::vector<float> circlePosX;
+            std::vector<float> circlePosY;
+            std::vector<float> circleRadius;
+            std::vector<float> rectPosX;
+            std::vector<float> rectPosY;
+            // The local x axis of the rect (The y axis is perpendicular to it)
+            std::vector<float> rectAxisX;
+            std::vector<float> rectAxisY;
+            std::vector<float> rectHalfWidth;
+            std::vector<float> rectHalfHeight;
+            std::vector<SceneNode*> circleNode;
+            std::vector<SceneNode*> rectNode;
+        };
+
+        struct RectRectPair
+        {
+            CollisionRect *rectA;
+            CollisionRect *rectB;
+            // The last separating axis of the pair (Can be nullptr)
+            int *separatingAxis;
+        };
+
+        CircleCircleBatch m_circleCircle;
+        CircleRectBatch m_circleRect;
+        std::vector<RectRectPair> m_rectRect;
+        // Indices of the pairs which collide, filled by the kernels
+        std::vector<std::size_t> m_hits;
+
+    public:
+        // Remove all pairs, the memory is kept
+        void clear();
+        void addCircleCircle(CollisionCircle &circleA, CollisionCircle &circleB);
+        void addCircleRect(CollisionCircle &circle, CollisionRect &rect);
+        // The separating axis is used to start the SAT test with it and gets
+        // updated by the test (see CollisionHandler::isColliding())
+        void addRectRect(CollisionRect &rectA, CollisionRect &rectB, 
+                int *separatingAxis = nullptr);
+        // Get the number of added pairs
+        std::size_t getPairCnt() const;
+
+        // Test all added pairs and add the collision infos of the colliding
+        // pairs to the container
+        void evaluate(std::vector<CollisionInfo> &collisionData);
+
+    private:
+        void evaluateCircleCircle(std::vector<CollisionInfo> &collisionData);
+        void evaluateCircleRect(std::vector<CollisionInfo> &collisionData);
+        void evaluateRectRect(std::vector<CollisionInfo> &collisionData);
+};
+
+#endif // NARROWPHASEBATCH_HPP
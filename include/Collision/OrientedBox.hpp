@@ -0,0 +1,30 @@
+#ifndef ORIENTEDBOX_HPP
+#define ORIENTEDBOX_HPP
+#include <SFML/Graphics.hpp>
+
+/* A rotated rect in world coordinates, represented through its center, the
+ * half of its width and height and its two (normalized) local axes.
+ * Is used instead of the four vertices for the SAT collision test between 
+ * rects, because for rects only the two axes per shape are unique and the 
+ * projection of the box on an axis can be computed directly.
+ */
+struct OrientedBox
+{
+    sf::Vector2f center;
+    sf::Vector2f halfExtents;
+    // The direction of the local x axis (width) and y axis (height)
+    sf::Vector2f axisX;
+    sf::Vector2f axisY;
+
+    OrientedBox();
+    OrientedBox(sf::Vector2f center, sf::Vector2f halfExtents, 
+            float rotationDegree);
+
+    // Get the half length of the projection of the box onto the (normalized) 
+    // axis
+    float getProjectionRadius(sf::Vector2f axis) const;
+    // Get the vertices clockwise, beginning with the top left vertex
+    void getVertices(sf::Vector2f (&vertices)[4]) const;
+};
+
+#endif // ORIENTEDBOX_HPP
@@ -0,0 +1,45 @@
+#ifndef TILEGRID_HPP
+#define TILEGRID_HPP
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class SceneNode;
+
+/* Stores the colliding tiles of the level in a uniform grid, so a ray only 
+ * has to visit the cells it passes (DDA) instead of testing every tile.
+ * The grid starts at (0, 0) like the tiles of the level.
+ */
+class TileGrid
+{
+    private:
+        sf::Vector2f m_tileSize;
+        int m_columns;
+        int m_rows;
+        std::vector<SceneNode*> m_tiles;
+
+    public:
+        TileGrid();
+
+        void create(sf::Vector2f tileSize, int columns, int rows);
+        void clear();
+        bool isEmpty() const;
+        // Set the node of the tile which contains the position
+        void setTile(sf::Vector2f position, SceneNode *node);
+        // Returns nullptr when there is no tile at the position
+        SceneNode* getTile(sf::Vector2f position) const;
+        sf::FloatRect getBounds() const;
+
+        // Visit the tiles along the ray in the order they are passed. The 
+        // visitor is called with the node of the tile and the traversal stops 
+        // when the visitor returns true. Returns true if it was stopped
+        template <typename Visitor>
+        bool traverse(sf::Vector2f origin, sf::Vector2f direction, 
+                float maxDistance, Visitor visitor) const;
+
+    private:
+        SceneNode* getTile(int column, int row) const;
+};
+
+#include "Collision/TileGrid.inl"
+
+#endif // TILEGRID_HPP
@@ -0,0 +1,57 @@
+#include <cmath>
+#include <limits>
+
+template <typename Visitor>
+bool TileGrid::traverse(sf::Vector2f origin, sf::Vector2f direction, 
+        float maxDistance, Visitor visitor) const
+{
+    if (isEmpty())
+    {
+        return false;
+    }
+    const float Infinity{ std::numeric_limits<float>::infinity() };
+    int column{ static_cast<int>(std::floor(origin.x / m_tileSize.x)) };
+    int row{ static_cast<int>(std::floor(origin.y / m_tileSize.y)) };
+    const int StepX{ direction.x > 0.f ? 1 : (direction.x < 0.f ? -1 : 0) };
+    const int StepY{ direction.y > 0.f ? 1 : (direction.y < 0.f ? -1 : 0) };
+    // The distance on the ray to the next vertical and horizontal cell border
+    float nextX{ StepX == 0 ? Infinity : 
+        ((column + (StepX > 0 ? 1 : 0)) * m_tileSize.x - origin.x) / 
+            direction.x };
+    float nextY{ StepY == 0 ? Infinity : 
+        ((row + (StepY > 0 ? 1 : 0)) * m_tileSize.y - origin.y) / 
+            direction.y };
+    // The distance on the ray to cross a whole cell
+    const float DeltaX{ StepX == 0 ? Infinity : 
+        m_tileSize.x / std::abs(direction.x) };
+    const float DeltaY{ StepY == 0 ? Infinity : 
+        m_tileSize.y / std::abs(direction.y) };
+    float distance{ 0.f };
+    while (distance <= maxDistance)
+    {
+        // The ray left the grid and does not come back
+        if ((column < 0 && StepX <= 0) || (column >= m_columns && StepX >= 0) ||
+                (row < 0 && StepY <= 0) || (row >= m_rows && StepY >= 0))
+        {
+            return false;
+        }
+        SceneNode *tile{ getTile(column, row) };
+        if (tile && visitor(*tile))
+        {
+            return true;
+        }
+        if (nextX < nextY)
+        {
+            distance = nextX;
+            nextX += DeltaX;
+            column += StepX;
+        }
+        else
+        {
+            distance = nextY;
+            nextY += DeltaY;
+            row += StepY;
+        }
+    }
+    return false;
+}
@@ -1,19 +1,15 @@
 #ifndef ENTITY_HPP
 #define ENTITY_HPP
 #include <SFML/Graphics.hpp>
+#include "Components/EntityStore.hpp"
 #include "Components/SceneNode.hpp"
 
+// The velocities, the direction and the mass are stored in the EntityStore
 class Entity : public SceneNode
 {
     protected:
-        // The velocity with which the entity can move
-        float m_velocity;
-        // The current velocity of the entity
-        float m_currentVelocity;
-        // The current direction of the entity
-        // The mass of the entity
-        float m_mass;
-        sf::Vector2f m_currentDirection;
+        EntityStore &m_store;
+        const EntityStore::Handle m_storeHandle;
         float m_width;
         float m_height;
     
@@ -21,6 +17,7 @@ class Entity : public SceneNode
         explicit Entity(RenderLayers layer);
         virtual ~Entity();
 
+        // The velocity with which the entity can move
         void setVelocity(float velocity);
         float getVelocity() const;
         void setCurrentVelocity(float currentVelocity);
@@ -29,6 +26,9 @@ class Entity : public SceneNode
         void setMass(float mass);
         void setCurrentDirection(sf::Vector2f currentDirection);
         sf::Vector2f getCurrentDirection() const;
+        // When true the entity moves every frame with its velocity along its 
+        // current direction (see EntityStore::integrateMovement())
+        void setIsMovingByItself(bool isMovingByItself);
 
         float getWidth() const;
         void setWidth(float width);
@@ -40,6 +40,8 @@ class Entity : public SceneNode
    protected:
         virtual void updateCurrent(float dt);
         virtual void onCommandCurrent(const Command &command, float dt);
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
 };
 
 #endif // ENTITY_HPP
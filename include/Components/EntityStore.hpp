@@ -0,0 +1,108 @@
+#ifndef ENTITYSTORE_HPP
+#define ENTITYSTORE_HPP
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class BinaryReader;
+class BinaryWriter;
+class Entity;
+
+/* Stores the simulation state of all entities in contiguous arrays (structure
+ * of arrays), so the per frame work is done by systems in tight loops instead 
+ * of virtual calls on every node:
+ * - integrateMovement() moves the entities, which move by themselves along 
+ *   their direction (e.g. projectiles)
+ * - regenerateStamina() fills up the stamina of the warriors
+ * The transforms stay in the scene nodes, because the scene graph composes 
+ * them for the hierarchy and rendering, the movement system writes the moves 
+ * back in one pass.
+ * An entity only keeps a handle, which is valid as long as the entity exists.
+ * When an entity is removed the last entity is moved into its slot, so the 
+ * arrays stay packed.
+ * Every screen owns the store of its world. The entities are added to the 
+ * store of the actual Scope of the thread, like the nodes are created in the
+ * arena of the NodeArena::Scope.
+ */
+class EntityStore : private sf::NonCopyable
+{
+    public:
+        typedef std::size_t Handle;
+
+        // Makes the store the one the created entities are added to for the
+        // lifetime of the scope
+        class Scope
+        {
+            private:
+                EntityStore *m_previousStore;
+
+            public:
+                explicit Scope(EntityStore &store);
+                ~Scope();
+        };
+
+    private:
+        static thread_local EntityStore *currentStore;
+
+        // Maps the handles to the indices in the arrays
+        std::vector<std::size_t> m_indices;
+        std::vector<Handle> m_freeHandles;
+
+        // All arrays have the same size
+        std::vector<Handle> m_handles;
+        std::vector<Entity*> m_entities;
+        std::vector<float> m_directionX;
+        std::vector<float> m_directionY;
+        std::vector<float> m_velocity;
+        std::vector<float> m_currentVelocity;
+        std::vector<float> m_mass;
+        // If the entity is moved by integrateMovement() (char instead of bool,
+        // because std::vector<bool> is no real array)
+        std::vector<char> m_isIntegrated;
+        std::vector<float> m_health;
+        std::vector<float> m_maxHealth;
+        std::vector<float> m_stamina;
+        std::vector<float> m_maxStamina;
+        std::vector<float> m_staminaRate;
+
+    public:
+        // The store of the actual scope, there has to be one
+        static EntityStore& getCurrent();
+
+        Handle add(Entity &entity);
+        void remove(Handle handle);
+        std::size_t getEntityCnt() const;
+
+        sf::Vector2f getDirection(Handle handle) const;
+        void setDirection(Handle handle, sf::Vector2f direction);
+        float getVelocity(Handle handle) const;
+        void setVelocity(Handle handle, float velocity);
+        float getCurrentVelocity(Handle handle) const;
+        void setCurrentVelocity(Handle handle, float currentVelocity);
+        float getMass(Handle handle) const;
+        void setMass(Handle handle, float mass);
+        bool isIntegrated(Handle handle) const;
+        void setIsIntegrated(Handle handle, bool isIntegrated);
+
+        float getHealth(Handle handle) const;
+        void setHealth(Handle handle, float health);
+        float getMaxHealth(Handle handle) const;
+        void setMaxHealth(Handle handle, float maxHealth);
+        float getStamina(Handle handle) const;
+        void setStamina(Handle handle, float stamina);
+        float getMaxStamina(Handle handle) const;
+        void setMaxStamina(Handle handle, float maxStamina);
+        // The stamina which is regenerated per second
+        void setStaminaRate(Handle handle, float staminaRate);
+
+        // Write and read the values of the entity, which change during a 
+        // match (The mass and the maximums are set once by the config)
+        void saveEntity(Handle handle, BinaryWriter &writer) const;
+        void loadEntity(Handle handle, BinaryReader &reader);
+
+        // Move the integrated entities with their velocity along their 
+        // direction
+        void integrateMovement(float dt);
+        void regenerateStamina(float dt);
+};
+
+#endif // ENTITYSTORE_HPP
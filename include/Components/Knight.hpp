@@ -35,7 +35,7 @@ class Knight : public Warrior
              
 
     public:
-        Knight(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, const int health, 
+        Knight(RenderLayers layer, const WarriorArchetype &archetype, SoundPlayer &sound, const int health, 
                 const std::string &textureId,
                 const ResourceHolder<sf::Texture> &textureHolder,
                 const SpriteSheetMapHolder &spriteSheetMapHolder, 
@@ -59,6 +59,8 @@ class Knight : public Warrior
     protected:
 
         virtual void weaponAdded();
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
     private:
         virtual void updateCurrent(float dt);
         virtual void updateAI(float dt);
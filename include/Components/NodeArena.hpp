@@ -0,0 +1,97 @@
+#ifndef NODEARENA_HPP
+#define NODEARENA_HPP
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+class SceneNode;
+class NodeArena;
+
+// Deletes a node, which was created by the NodeArena or with new
+struct NodeDeleter
+{
+    // nullptr when the node was created with new
+    NodeArena *arena;
+    // The size which was allocated for the node
+    std::size_t size;
+
+    NodeDeleter();
+    NodeDeleter(NodeArena *arena, std::size_t size);
+    // Nodes created with std::make_unique can be passed to attachChild()
+    template <typename T>
+    NodeDeleter(const std::default_delete<T>&);
+
+    void operator()(SceneNode *node) const;
+};
+
+template <typename T>
+using NodePtr = std::unique_ptr<T, NodeDeleter>;
+
+/* Allocates the scene nodes of a screen in big chunks, so the nodes which are
+ * created together (e.g. the body parts of a warrior) lie next to each other 
+ * in memory, which helps the traversal of the scene graph. Freed nodes are 
+ * kept in free lists for their size and are reused by the next node of the 
+ * same size (e.g. the fireballs). All chunks are released at once, when the 
+ * arena is destroyed.
+ * The nodes are created by create(), which uses the arena of the actual 
+ * Scope of the thread. When there is no arena, the node is created with new.
+ * The arena is not thread safe, only the thread which opened the Scope uses it.
+ */
+class NodeArena : private sf::NonCopyable
+{
+    public:
+        // Makes the arena the one used by create() for the lifetime of the 
+        // scope
+        class Scope
+        {
+            private:
+                NodeArena *m_previousArena;
+
+            public:
+                explicit Scope(NodeArena &arena);
+                ~Scope();
+        };
+
+    private:
+        static const std::size_t CHUNK_SIZE{ 64 * 1024 };
+        // The sizes are rounded up to this, which is the alignment too
+        static const std::size_t GRANULARITY{ 16 };
+        // Bigger nodes are created with new
+        static const std::size_t MAX_NODE_SIZE{ 4096 };
+
+        // The first bytes of a free block point to the next free block
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        static thread_local NodeArena *currentArena;
+
+        std::vector<char*> m_chunks;
+        char *m_chunkPos;
+        char *m_chunkEnd;
+        std::vector<FreeBlock*> m_freeLists;
+        std::size_t m_usedBytes;
+
+    public:
+        NodeArena();
+        ~NodeArena();
+
+        // Create the node in the arena of the actual scope or with new
+        template <typename T, typename... Args>
+        static NodePtr<T> create(Args&&... args);
+
+        void* allocate(std::size_t size);
+        void deallocate(void *ptr, std::size_t size);
+
+        // The bytes used by living nodes
+        std::size_t getUsedBytes() const;
+        std::size_t getChunkCnt() const;
+
+    private:
+        static std::size_t getBlockSize(std::size_t size);
+};
+
+#include "Components/NodeArena.inl"
+
+#endif // NODEARENA_HPP
@@ -0,0 +1,34 @@
+#include <new>
+#include <utility>
+
+template <typename T>
+NodeDeleter::NodeDeleter(const std::default_delete<T>&)
+: arena{ nullptr }
+, size{ 0 }
+{
+
+}
+
+template <typename T, typename... Args>
+NodePtr<T> NodeArena::create(Args&&... args)
+{
+    static_assert(alignof(T) <= GRANULARITY, 
+            "The node needs a bigger alignment than the arena provides");
+    NodeArena *arena{ currentArena };
+    if (!arena || sizeof(T) > MAX_NODE_SIZE)
+    {
+        return NodePtr<T>{ new T(std::forward<Args>(args)...), NodeDeleter{} };
+    }
+    void *memory{ arena->allocate(sizeof(T)) };
+    T *node{ nullptr };
+    try
+    {
+        node = new (memory) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        arena->deallocate(memory, sizeof(T));
+        throw;
+    }
+    return NodePtr<T>{ node, NodeDeleter{ arena, sizeof(T) } };
+}
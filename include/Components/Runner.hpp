@@ -41,7 +41,7 @@ class Runner : public Warrior
         sf::Vector2f m_dodgeDir;
 
     public:
-        Runner(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, const int health, 
+        Runner(RenderLayers layer, const WarriorArchetype &archetype, SoundPlayer &sound, const int health, 
                 const std::string &textureId,
                 const ResourceHolder<sf::Texture> &textureHolder,
                 const SpriteSheetMapHolder &spriteSheetMapHolder, 
@@ -53,6 +53,8 @@ class Runner : public Warrior
                 sf::RenderStates states) const;
     protected:
         virtual void weaponAdded();
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
     
     private:
         virtual void updateCurrent(float dt);
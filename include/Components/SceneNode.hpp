@@ -8,22 +8,31 @@
 #include "Collision/CollisionShape.hpp"
 #include "Components/EnumWorldObjectStatus.hpp"
 #include "Components/EnumWorldObjectTypes.hpp"
+#include "Components/NodeArena.hpp"
 #include "Input/Command.hpp"
 #include "Render/EnumRenderLayers.hpp"
 
+class BinaryReader;
+class BinaryWriter;
 class CollisionShape;
 class CollisionInfo;
+class DeferredActions;
+class JobSystem;
+class RenderSnapshot;
 
 class SceneNode : public sf::Transformable, /*public sf::Drawable,*/ public sf::NonCopyable
 {
     public:
-        typedef std::unique_ptr<SceneNode> Ptr;
+        typedef NodePtr<SceneNode> Ptr;
         typedef std::pair<SceneNode*, SceneNode*> Pair;
         //typedef std::tuple<SceneNode*, SceneNode*, CollisionInfo> Pair;
 
     private:
         //bool m_isRoot;
         std::string m_debugName;
+        // Unique id of the node, is used as key in the ContactCache (The
+        // address of a destroyed node can be reused by a new node)
+        unsigned int m_nodeId;
         
         RenderLayers m_layer;
         std::vector<Ptr> m_children;
@@ -47,10 +56,17 @@ class SceneNode : public sf::Transformable, /*public sf::Drawable,*/ public sf::
         bool m_isActive;
         // When its false,the collision check is ignored for this SceneNode
         bool m_isCollisionCheckOn;
+        // When the epoch changes, the contacts of the node start again with a
+        // begin event, even if the node stays in contact
+        unsigned int m_contactEpoch;
 
         sf::Vector2f m_lastPos;
         float m_lastRot;
         sf::Vector2f m_lastScal;
+        // Is false until the first safeCurrentTransform() after the node was
+        // created or attached, so a node which is placed after it was attached
+        // isnt drawn moving from its old position
+        bool m_hasLastTransform;
     public:
         SceneNode();
         SceneNode(RenderLayers layer);
@@ -59,6 +75,8 @@ class SceneNode : public sf::Transformable, /*public sf::Drawable,*/ public sf::
         
         void setDebugName(const std::string &debugName);
         const std::string& getDebugName() const;
+        unsigned int getNodeId() const;
+        RenderLayers getLayer() const;
 
         void attachChild(Ptr child);
         Ptr detachChild(const SceneNode& node);
@@ -75,6 +93,19 @@ class SceneNode : public sf::Transformable, /*public sf::Drawable,*/ public sf::
 
         // dt is the delta time
         void update(float dt);
+        // Update the node and spread the update of the children over the 
+        // threads of the job system. The children which cant be updated in
+        // parallel are updated first on this thread. Changes of the scene 
+        // graph have to be added to the deferred actions (see 
+        // DeferredActions::add()) and are executed by the caller afterwards.
+        // The scratch buffer of the caller keeps its memory between the frames
+        void updateParallel(float dt, JobSystem &jobSystem, 
+                DeferredActions &deferredActions, 
+                std::vector<std::size_t> &parallelChildren);
+        // Check if the update of the node (and its children) only changes its
+        // own state and only reads its own state, so it can run in parallel 
+        // with the update of its siblings
+        virtual bool canUpdateInParallel() const;
         void onCommand(const Command &command, float dt);
         // Get absolute world transform
         sf::Transform getWorldTransform() const;
@@ -92,12 +123,18 @@ class SceneNode : public sf::Transformable, /*public sf::Drawable,*/ public sf::
 
         CollisionShape* getCollisionShape() const;
         CollisionInfo isColliding(SceneNode &node) const;
+        // Check if the collision white lists and states of the nodes allow a 
+        // collision (The collision shapes are not tested)
+        bool canCollideWith(const SceneNode &node) const;
 
         bool isActive() const;
         void setIsActive(bool isActive);
 
         bool isCollisionCheckOn() const;
         void setIsCollisionCheckOn(bool isCollisionCheckOn);
+        unsigned int getContactEpoch() const;
+        // Start a new contact epoch, so the actual contacts begin again
+        void startNewContactEpoch();
         // Override transformables setRotation() method with virtual so we can modify it in classes
         virtual void setRotation(float angle);
         // Override transformables rotate() method with virtual so we can modify it in classes
@@ -113,29 +150,57 @@ class SceneNode : public sf::Transformable, /*public sf::Drawable,*/ public sf::
         void safeCurrentTransform();
         // Restore the last state of position, rotation and scale (the pos and rotation of the entity before last change)
         void restoreLastTransform();
-
-        void checkSceneCollision(SceneNode &sceneGraph, std::vector<CollisionInfo> &collisionData);
+        // Get the position, which was stored by the last safeCurrentTransform()
+        sf::Vector2f getLastPosition() const;
+        // Get how far the node was moved in world coordinates since the last
+        // safeCurrentTransform() (The movement of the parents is not included)
+        sf::Vector2f getWorldDisplacement() const;
+
+        // Add this node and all children to the container, which have a 
+        // collision shape, the collision check on and are not destroyed
+        void collectCollisionNodes(std::vector<SceneNode*> &nodes);
+        // Add this node and all children to the container, which are not 
+        // destroyed. The parents are added before their children
+        void collectNodes(std::vector<SceneNode*> &nodes);
         // Remove the children SceneNodes which are marked as destroyed
         void removeDestroyed();
+        // Get the number of SceneNodes in the subtree, including this node
+        std::size_t getNodeCount() const;
+
+        // Add the transforms at the last safeTransform() and now and the 
+        // sprites of the node and its children to the snapshot. The parent is
+        // the index of the parent node in the snapshot
+        void addToRenderSnapshot(RenderSnapshot &snapshot, 
+                std::size_t parent) const;
+
+        // Write and read the state of the node, which changes during a match
+        // (The children are not included, see WorldSnapshot)
+        void saveState(BinaryWriter &writer) const;
+        void loadState(BinaryReader &reader);
 
         // draw should not get overridden
         virtual void draw(RenderLayers layer, sf::RenderTarget &target, sf::RenderStates states) const final;
         //virtual void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
 
+    protected:
+        // Derived classes write their state after the state of their base 
+        // class and read it in the same order
+        virtual void saveCurrentState(BinaryWriter &writer) const;
+        virtual void loadCurrentState(BinaryReader &reader);
+
     private:
+        static unsigned int createNodeId();
 
         virtual void drawCurrent(sf::RenderTarget &target, sf::RenderStates states) const;
+        // Add what drawCurrent() draws to the snapshot
+        virtual void addCurrentToRenderSnapshot(RenderSnapshot &snapshot, 
+                std::size_t node) const;
         virtual void drawCollisionShape(sf::RenderTarget &target, sf::RenderStates states) const;
         void drawChildren(RenderLayers layer, sf::RenderTarget &target, sf::RenderStates states) const;
         virtual void updateCurrent(float dt);
         void updateChildren(float dt);
         virtual void onCommandCurrent(const Command &command, float dt);
         void onCommandChildren(const Command &command, float dt);
-        // Check if the given SceneGraph and its child collides with the ScneGraph and its nodes.
-        // CollisionPairs is used to check if the pair of colliding SceneNodes if allready added.
-        // In the collisionData vector are the collisionInfos and the SceneNodes stored, which are affected from the collision
-        void checkNodeCollision(SceneNode &node, std::set<Pair> &collisionPairs, std::vector<CollisionInfo> &collisionData);
-        void checkSceneCollision(SceneNode &sceneGraph, std::set<Pair> &collisionPairs, std::vector<CollisionInfo> &collisionData);
 };
 
 #endif // SCENENODE_HPP
@@ -44,6 +44,10 @@ class SpriteNode : public Entity
         virtual void updateCurrent(float dt);
         virtual void drawCurrent(sf::RenderTarget &target, 
                 sf::RenderStates states) const;
+        virtual void addCurrentToRenderSnapshot(RenderSnapshot &snapshot, 
+                std::size_t node) const override;
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
 
 };
 
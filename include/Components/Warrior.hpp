@@ -10,7 +10,8 @@
 #include "Sound/SoundPlayer.hpp"
 
 class Weapon;
-class ConfigManager;
+class CollisionWorld;
+struct WarriorArchetype;
 
 class Warrior : public Entity
 {
@@ -24,11 +25,7 @@ class Warrior : public Entity
         const ResourceHolder<sf::Texture> &m_textureHolder;
         const SpriteSheetMapHolder &m_spriteSheetMapHolder;
         
-        float m_maxHealth;
-        float m_currentHealth;
-
-        float m_maxStamina;
-        float m_currentStamina;
+        // The health and the stanima are stored in the EntityStore
         // The rate whith the stanima automatic fill up
         float m_stanimaRefreshRate;
         // Used to check if movement animation shout get updated
@@ -60,10 +57,12 @@ class Warrior : public Entity
         bool m_isAiActive;
         std::vector<Warrior*> &m_possibleTargetsInWord;
         Warrior *m_actualTarget;
+        // Used for the line of sight (Can be nullptr)
+        const CollisionWorld *m_collisionWorld;
 
 
     public:
-        Warrior(RenderLayers layer, const ConfigManager &config, 
+        Warrior(RenderLayers layer, const WarriorArchetype &archetype, 
                 SoundPlayer &sound, const float health, 
                 const std::string &textureId, 
                 const ResourceHolder<sf::Texture> &textureHolder,
@@ -91,6 +90,7 @@ class Warrior : public Entity
 
         void setIsAiActive(bool isAiActive);
         void setActualTarget(Warrior *target);
+        void setCollisionWorld(const CollisionWorld *collisionWorld);
         //int getDamage() const;
 
         bool isAlive() const;
@@ -100,6 +100,12 @@ class Warrior : public Entity
         void addStanima(float stanima);
 
         virtual void handleDamage(Weapon *weapon);
+        // Create a projectile of the warrior, which is not attached yet 
+        // (Is used to restore the projectiles of a snapshot). Returns nullptr
+        // when the warrior has no projectiles
+        virtual NodePtr<Weapon> createProjectile() const;
+        // The AI reads the position of the other warriors
+        virtual bool canUpdateInParallel() const override;
         
         virtual void drawCurrent(sf::RenderTarget &target, 
                 sf::RenderStates states) const;
@@ -114,10 +120,17 @@ class Warrior : public Entity
         virtual void updateAI(float dt);
         virtual void onCommandCurrent(const Command &command, float dt);
         void lookAt(sf::Vector2f pos);
+        // The stanima is filled up by the EntityStore, while its regenerating
+        void setIsStanimaRegenerating(bool isRegenerating);
+        // Check if there is no level object between the warrior and the node.
+        // Without collision world everything is in sight
+        bool isInLineOfSight(const SceneNode &node) const;
         virtual void weaponAdded();
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
 
     private:
-        void applyConfig(const ConfigManager &config);
+        void applyArchetype(const WarriorArchetype &archetype);
 };
 
 #endif // WARRIOR_HPP
@@ -19,6 +19,9 @@ class Weapon : public Item
         // Store the ids of the warriors which was attacked from the actual attacked
         // (That make it possible that only the first hit of a attack counts)
         std::set<std::string> m_hitIDs;
+        // The node id of the warrior which spawned the weapon (e.g. a 
+        // projectile) or 0, used to spawn it again when a snapshot is restored
+        unsigned int m_spawnerId;
 
     public:
         Weapon(RenderLayers layer, const float damage, const std::string &textureId, 
@@ -42,6 +45,13 @@ class Weapon : public Item
 
         // Creates a new attackID
         void startNewAttack();
+
+        void setSpawnerId(unsigned int spawnerId);
+        unsigned int getSpawnerId() const;
+
+    protected:
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
 };
 
 #endif // WEAPON_HPP
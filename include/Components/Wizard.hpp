@@ -27,7 +27,7 @@ class Wizard : public Warrior
         float m_currentHealColorStepTime;
         
     public:
-        Wizard(RenderLayers layer, const ConfigManager &config, SoundPlayer &sound, const int health, 
+        Wizard(RenderLayers layer, const WarriorArchetype &archetype, SoundPlayer &sound, const int health, 
                 const std::string &textureId, 
                 const ResourceHolder<sf::Texture> &textureHolder,
                 const SpriteSheetMapHolder &spriteSheetMapHolder, 
@@ -35,10 +35,14 @@ class Wizard : public Warrior
 
         virtual ~Wizard();
 
+        virtual NodePtr<Weapon> createProjectile() const override;
+
         virtual void drawCurrent(sf::RenderTarget &target, 
                 sf::RenderStates states) const;
     protected:
         virtual void weaponAdded();
+        virtual void saveCurrentState(BinaryWriter &writer) const override;
+        virtual void loadCurrentState(BinaryReader &reader) override;
     
     private:
         virtual void updateCurrent(float dt);
@@ -48,6 +52,8 @@ class Wizard : public Warrior
         void updateHealColor(float dt);
 
         void startFireballAttack();
+        // Create the fireball and attach it to the root node
+        void spawnFireball();
         void startHealing();
         void stopHealing();
         // Apply color to all sprites of wizard
@@ -0,0 +1,83 @@
+#ifndef CONFIGREGISTRY_HPP
+#define CONFIGREGISTRY_HPP
+#include <SFML/System.hpp>
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+/* Keeps the config files loaded, so every file is only read and parsed once.
+ * The values are converted to all types when the file is loaded and are
+ * accessed by handles, which are found once by their keys, so reading a value
+ * is only an index into a vector.
+ * The files can be reloaded, when they were changed on the disk
+ * (see reloadChanged()). The handles stay valid, a key which was removed from
+ * the file is treated as missing.
+ */
+class ConfigRegistry : private sf::NonCopyable
+{
+    public:
+        typedef std::size_t FileId;
+
+        struct Handle
+        {
+            FileId file;
+            std::size_t value;
+        };
+
+    private:
+        struct Value
+        {
+            bool isExisting;
+            std::string str;
+            bool isBool;
+            bool boolVal;
+            bool isInt;
+            int intVal;
+            bool isFloat;
+            float floatVal;
+        };
+
+        struct File
+        {
+            std::string fileName;
+            // The modification time of the loaded file
+            std::time_t modificationTime;
+            // Key, index of the value
+            std::map<std::string, std::size_t> keys;
+            std::vector<std::string> keyNames;
+            std::vector<Value> values;
+        };
+
+        std::vector<File> m_files;
+
+    public:
+        // Load the file, when it isnt loaded yet. Returns the id of the loaded
+        // file
+        FileId load(const std::string &fileName);
+        // The value of a missing key has a handle too, so the key is used,
+        // when a reload adds it
+        Handle getHandle(FileId file, const std::string &key);
+
+        bool isExisting(Handle handle) const;
+        const std::string& getString(Handle handle,
+                const std::string &defaultVal) const;
+        bool getBool(Handle handle, bool defaultVal) const;
+        int getInt(Handle handle, int defaultVal) const;
+        float getFloat(Handle handle, float defaultVal) const;
+
+        // Reload the files, which were changed since they were loaded.
+        // Returns the number of reloaded files
+        std::size_t reloadChanged();
+
+    private:
+        bool readFile(File &file);
+        void setValue(File &file, const std::string &key,
+                const std::string &str);
+        // Returns nullptr, when the key doesnt exist
+        const Value* findValue(Handle handle) const;
+        static std::time_t getModificationTime(const std::string &fileName);
+};
+
+#endif // CONFIGREGISTRY_HPP
@@ -0,0 +1,23 @@
+#ifndef WARRIORARCHETYPE_HPP
+#define WARRIORARCHETYPE_HPP
+#include "Config/ConfigRegistry.hpp"
+#include <string>
+
+/* The values of a warrior type compiled from its config file (e.g. 
+ * assets/warrior_config/knight.ini), so creating a warrior only copies them.
+ */
+struct WarriorArchetype
+{
+    float velocity;
+    float mass;
+    float health;
+    float stanima;
+    // The rate whith the stanima automatic fill up
+    float stanimaRefresh;
+
+    // Read the values of the config file, missing values get the defaults
+    static WarriorArchetype compile(ConfigRegistry &registry, 
+            const std::string &fileName);
+};
+
+#endif // WARRIORARCHETYPE_HPP
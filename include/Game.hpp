@@ -8,9 +8,12 @@
 #include "Components/EnumWorldObjectTypes.hpp"
 #include "Components/SceneNode.hpp"
 #include "Config/ConfigManager.hpp"
-#include "Input/QueueHelper.hpp"
+#include "Config/ConfigRegistry.hpp"
 #include "Input/InputHandler.hpp"
+#include "Input/InputSampler.hpp"
 #include "Input/EnumInputTypes.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Profiling/LatencyHistogram.hpp"
 #include "Render/RenderManager.hpp"
 #include "Resources/ResourceHolder.hpp"
 #include "Resources/SpriteSheetMapHolder.hpp"
@@ -30,6 +33,7 @@ class Game
 
     private:
         ConfigManager m_config;
+        ConfigRegistry m_configRegistry;
         // Options
         unsigned int m_screenHeight;
         unsigned int m_screenWidth;
@@ -54,6 +58,16 @@ class Game
         MusicPlayer m_music;
         SoundPlayer m_sound;
         sf::Text m_txtStatFPS;
+        // The time from sampling the inputs until they are handled
+        sf::Text m_txtStatInput;
+        LatencyHistogram m_inputLatency;
+        // Allocations per frame (only filled with ARENA_TRACK_ALLOCATIONS)
+        sf::Text m_txtStatAlloc;
+        // Print the allocation report once per second to the console
+        bool m_printAllocStats;
+        // Reload the changed config files once per second
+        bool m_isConfigReloading;
+        JobSystem m_jobSystem;
         Screen::Context m_context;
 
         bool m_isRunning;
@@ -64,6 +78,14 @@ class Game
       
         // Delta time
         float m_dt;
+        // The screens are updated with this fixed time step, 0 updates them
+        // once per frame with the delta time
+        float m_updateStepTime;
+        // When the updates take longer than the steps, the rest of the time
+        // is dropped, so the game slows down instead of falling further behind
+        int m_maxUpdatesPerFrame;
+        // The time which is not simulated yet
+        float m_updateTimeAccumulator;
         float m_fps;
         float m_averageFpsTime;
         float m_fpsInSec;
@@ -80,8 +102,11 @@ class Game
         LevelHolder m_levelHolder;
 
         // The game class handle all inputs which get later translated to commands
-        QueueHelper<Input> m_inputQueue;
+        InputQueue m_inputQueue;
         InputHandler m_inputHandler;
+        // Samples the real time input with a higher rate than the frame rate
+        // (Only when input_sample_rate is set)
+        InputSampler m_inputSampler;
 
         ScreenStack m_screenStack;
         // Actual shown screen
@@ -99,10 +124,19 @@ class Game
         void buildScene();
         
         void determineDeltaTime();
-        void handleInput();
-        void update();
+        void updateAllocationStats();
+        void updateInputStats();
+        // Handle the input and update the screens with fixed steps and set 
+        // how far the rendering is between the last two steps
+        void updateFixedSteps();
+        // The sampled inputs are handled until the time point, which is the 
+        // end of the update step
+        void handleInput(float dt, Input::Clock::time_point sampledUntil);
+        void update(float dt);
         void updateBackground(float dt);
         void render();
+        // Start a profiler capture or write the running capture to a file
+        void toggleTraceCapture();
 
     public:
         Game();
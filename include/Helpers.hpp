@@ -1,13 +1,18 @@
 #ifndef HELPERS_HPP
 #define HELPERS_HPP
 #include <SFML/Graphics.hpp>
+#include "Random/EnumRandomStreams.hpp"
 
 namespace Helpers
 {
+    // The random functions use the streams of the RandomService, so they are
+    // reproduced by seeding it
     // Get a random string of the given length with normal alphabet chars and numbers
-    std::string getRandomAlphaNumString(int length);
+    std::string getRandomAlphaNumString(int length, 
+            RandomStreams stream = RandomStreams::IDS);
     // Get random num between a (inclusive) and b (inclusive)
-    int getRandomNum(int a, int b);
+    int getRandomNum(int a, int b, 
+            RandomStreams stream = RandomStreams::GAMEPLAY);
     // Creates a random unique id with the given length. When it is not possible
     // to create a unique id return an empty string
     std::string createUniqueID(int lenth);
@@ -3,17 +3,23 @@
 #include <SFML/Graphics.hpp>
 #include "Input/EnumInputTypes.hpp"
 #include "Input/EnumInputDevice.hpp"
+#include <chrono>
 
 /* Stores a input, which is later translated to a platform
  * indepentend command. A Input can result in different commands, depending on
- * actual screen and world
+ * actual screen and world.
+ * Every input gets the time it was created (sampled) as timestamp.
  */
 class Input
 {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
     private:
         InputTypes m_inputType;
         InputDevice m_inputDevice;
         sf::Vector2f m_values;
+        Clock::time_point m_timestamp;
 
     public:
         Input(InputTypes inputType, InputDevice inputDevice);
@@ -27,6 +33,9 @@ class Input
 
         sf::Vector2f getValues() const;
         void setValue(sf::Vector2f values);
+
+        Clock::time_point getTimestamp() const;
+        void setTimestamp(Clock::time_point timestamp);
 };
 
 #endif // INPUT_HPP
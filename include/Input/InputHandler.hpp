@@ -2,8 +2,12 @@
 #define INPUTHANDLER_HPP
 #include <SFML/Graphics.hpp>
 #include <queue>
-#include "Input/QueueHelper.hpp"
 #include "Input/Input.hpp"
+#include "Input/RingBuffer.hpp"
+
+// The inputs are passed without locks and allocations from the thread 
+// which samples them to the thread which handles them
+typedef RingBuffer<Input, 1024> InputQueue;
 
 class InputHandler
 {
@@ -23,20 +27,28 @@ class InputHandler
         // Store inmodified events in enventQueue and store events which get 
         // translated to inputs in inputQueue
         void handleInput(std::queue<sf::Event> &eventQueue, 
-                QueueHelper<Input> &inputQueue);
-        
+                InputQueue &inputQueue);
 
-    private:
+        // The parts of handleInput(), so the keys and mouse buttons can be 
+        // sampled by the InputSampler. The events, the mouse position (which
+        // depends on the view of the window) and the joysticks (SFML updates 
+        // their state in pollEvent()) have to be handled by the thread of the
+        // window
         void handleEvents(std::queue<sf::Event> &eventQueue, 
-                QueueHelper<Input> &inputQueue);
+                InputQueue &inputQueue);
+        void handleMousePosInput(InputQueue &inputQueue);
+        void handleJoystickRealTimeInput(InputQueue &inputQueue);
+        // Keys and mouse buttons. Only one thread may call it
+        void handleKeyboardRealTimeInput(InputQueue &inputQueue);
+        void handleRealTimeInput(InputQueue &inputQueue);
+
+    private:
         void handleKeyboardEvents(sf::Event &event, 
-                QueueHelper<Input> &inputQueue);
+                InputQueue &inputQueue);
         void handleJoystickEvents(sf::Event &event, 
-                QueueHelper<Input> &inputQueue, unsigned int joystickId);
+                InputQueue &inputQueue, unsigned int joystickId);
 
-        void handleRealTimeInput(QueueHelper<Input> &inputQueue);
-        void handleKeyboardRealTimeInput(QueueHelper<Input> &inputQueue);
-        void handleJoystickRealTimeInput(QueueHelper<Input> &inputQueue, 
+        void handleJoystickRealTimeInput(InputQueue &inputQueue, 
                 unsigned int joystickId);
         
         char getRealTimeMouseBtnState(sf::Mouse::Button button);
@@ -0,0 +1,67 @@
+#ifndef INPUTSAMPLER_HPP
+#define INPUTSAMPLER_HPP
+#include <SFML/System.hpp>
+#include "Input/Input.hpp"
+#include "Input/InputHandler.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Samples the real time input of the keys and mouse buttons on its own
+ * thread with a fixed rate, which is higher than the frame rate. All inputs
+ * of one sample get the same timestamp and are passed through a ring buffer
+ * to the game thread, which takes them by timestamp for each update step.
+ * So a short key press between two frames is not lost and the input of a step
+ * is not older than the sample interval.
+ * While the sampler runs, the InputHandler must not handle the keys and
+ * mouse buttons on another thread (The events, the mouse position and the
+ * joysticks are still handled by the window thread, because SFML only 
+ * updates the joysticks in pollEvent()).
+ */
+class InputSampler : private sf::NonCopyable
+{
+    private:
+        InputHandler &m_inputHandler;
+        Input::Clock::duration m_sampleInterval;
+        // Filled by the sampler thread, drained by the game thread
+        InputQueue m_sampledInputs;
+        // The inputs of the current sample, only used by the sampler thread
+        InputQueue m_sampleBuffer;
+        // Only used by the game thread. The inputs which are already drained,
+        // but newer than the last requested time point
+        std::vector<Input> m_pendingInputs;
+        std::vector<Input> m_mergedInputs;
+        std::vector<std::pair<InputTypes, InputDevice>> m_mergedTypes;
+        std::thread m_thread;
+        std::atomic<bool> m_isStopping;
+        std::atomic<std::uint64_t> m_sampleCnt;
+
+    public:
+        // A sample rate of 0 or less disables the sampler, then start() 
+        // does nothing
+        InputSampler(InputHandler &inputHandler, int sampleRate);
+        ~InputSampler();
+
+        void start();
+        void stop();
+        bool isRunning() const;
+
+        // Add the inputs which were sampled until the time point to the 
+        // queue. The real time inputs of several samples are merged, so every
+        // input type of a device is only added once (with the latest values)
+        // and the movement is taken from the latest sample with movement
+        void takeInputs(Input::Clock::time_point until, InputQueue &inputQueue);
+
+        std::uint64_t getSampleCnt() const;
+        // The number of inputs, which were lost because the game thread
+        // didnt take them fast enough
+        std::uint64_t getDroppedCnt() const;
+
+    private:
+        void run();
+        static bool isMovement(InputTypes inputType);
+};
+
+#endif // INPUTSAMPLER_HPP
@@ -0,0 +1,70 @@
+#ifndef RINGBUFFER_HPP
+#define RINGBUFFER_HPP
+#include <SFML/System.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/* A queue with a fixed capacity for one producer and one consumer thread.
+ * The producer only writes the head and the consumer only writes the tail,
+ * so neither push nor pop need a lock and after the construction the queue
+ * never allocates. When the queue is full, push() fails and the value is 
+ * dropped (The dropped values are counted).
+ * The consumer can drain all values at once, then the tail is only published
+ * once for the whole batch.
+ */
+template <typename T, std::size_t Capacity>
+class RingBuffer : private sf::NonCopyable
+{
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, 
+            "The capacity of the ring buffer has to be a power of two");
+
+    private:
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type 
+            Storage;
+        static const std::size_t IndexMask{ Capacity - 1 };
+        // Keep the indices on different cache lines, so the producer and 
+        // the consumer dont invalidate the line of each other
+        static const std::size_t CacheLineSize{ 64 };
+
+        // Written by the producer
+        std::atomic<std::size_t> m_head;
+        char m_headPadding[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+        // Written by the consumer
+        std::atomic<std::size_t> m_tail;
+        char m_tailPadding[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::uint64_t> m_droppedCnt;
+        Storage m_storage[Capacity];
+
+    public:
+        RingBuffer();
+        ~RingBuffer();
+
+        // Only used by the producer. Returns false when the queue is full
+        bool push(const T &value);
+
+        // Only used by the consumer. Returns false when the queue is empty
+        bool pop(T &value);
+        // Call the function for all values in the queue (Also the ones pushed
+        // while draining, up to the capacity) and remove them. Returns the 
+        // number of drained values
+        template <typename Function>
+        std::size_t drain(Function &&function);
+        // Remove all values
+        void clear();
+
+        // Can be outdated, when the other thread changes the queue
+        bool isEmpty() const;
+        std::size_t getSize() const;
+        std::size_t getCapacity() const;
+        // The number of values which were dropped, because the queue was full
+        std::uint64_t getDroppedCnt() const;
+
+    private:
+        T* getValue(std::size_t index);
+};
+
+#include "Input/RingBuffer.inl"
+
+#endif // RINGBUFFER_HPP
@@ -0,0 +1,108 @@
+#include <new>
+
+template <typename T, std::size_t Capacity>
+RingBuffer<T, Capacity>::RingBuffer()
+: m_head{ 0 }
+, m_tail{ 0 }
+, m_droppedCnt{ 0 }
+{
+
+}
+
+template <typename T, std::size_t Capacity>
+RingBuffer<T, Capacity>::~RingBuffer()
+{
+    clear();
+}
+
+template <typename T, std::size_t Capacity>
+bool RingBuffer<T, Capacity>::push(const T &value)
+{
+    const std::size_t Head{ m_head.load(std::memory_order_relaxed) };
+    if (Head - m_tail.load(std::memory_order_acquire) >= Capacity)
+    {
+        m_droppedCnt.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    new (&m_storage[Head & IndexMask]) T(value);
+    // The value has to be written, before the consumer sees the new head
+    m_head.store(Head + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, std::size_t Capacity>
+bool RingBuffer<T, Capacity>::pop(T &value)
+{
+    const std::size_t Tail{ m_tail.load(std::memory_order_relaxed) };
+    if (Tail == m_head.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    T *storedValue{ getValue(Tail) };
+    value = *storedValue;
+    storedValue->~T();
+    // The slot is free for the producer after the new tail is visible
+    m_tail.store(Tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, std::size_t Capacity>
+template <typename Function>
+std::size_t RingBuffer<T, Capacity>::drain(Function &&function)
+{
+    const std::size_t Tail{ m_tail.load(std::memory_order_relaxed) };
+    std::size_t head{ m_head.load(std::memory_order_acquire) };
+    std::size_t index{ Tail };
+    // Load the head again, when the values are used up, so values pushed 
+    // while draining are also drained. This ends after at most the capacity,
+    // because the producer gets no free slots before the tail is stored
+    while (index != head)
+    {
+        for (; index != head; index++)
+        {
+            T *storedValue{ getValue(index) };
+            function(*storedValue);
+            storedValue->~T();
+        }
+        head = m_head.load(std::memory_order_acquire);
+    }
+    m_tail.store(index, std::memory_order_release);
+    return index - Tail;
+}
+
+template <typename T, std::size_t Capacity>
+void RingBuffer<T, Capacity>::clear()
+{
+    drain([] (T&) {});
+}
+
+template <typename T, std::size_t Capacity>
+bool RingBuffer<T, Capacity>::isEmpty() const
+{
+    return getSize() == 0;
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t RingBuffer<T, Capacity>::getSize() const
+{
+    return m_head.load(std::memory_order_acquire) - 
+        m_tail.load(std::memory_order_acquire);
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t RingBuffer<T, Capacity>::getCapacity() const
+{
+    return Capacity;
+}
+
+template <typename T, std::size_t Capacity>
+std::uint64_t RingBuffer<T, Capacity>::getDroppedCnt() const
+{
+    return m_droppedCnt.load(std::memory_order_relaxed);
+}
+
+template <typename T, std::size_t Capacity>
+T* RingBuffer<T, Capacity>::getValue(std::size_t index)
+{
+    return reinterpret_cast<T*>(&m_storage[index & IndexMask]);
+}
@@ -0,0 +1,61 @@
+#ifndef DEFERREDACTIONS_HPP
+#define DEFERREDACTIONS_HPP
+#include <SFML/System.hpp>
+#include <functional>
+#include <vector>
+
+/* Collects actions which change shared state (e.g. spawning a node and 
+ * attaching it to the root) while the scene graph is updated by several
+ * threads. Every thread writes into its own buffer, so no locking is needed.
+ * After the update the buffers are merged and executed in the order of the 
+ * scopes in which the actions were added, so the result does not depend on 
+ * which thread updated which node.
+ * Outside of a scope the actions are executed immediately.
+ */
+class DeferredActions : private sf::NonCopyable
+{
+    public:
+        typedef std::function<void()> Action;
+
+        // Actions added by the thread during the lifetime of the scope are
+        // stored with the given order
+        class Scope
+        {
+            private:
+                DeferredActions *m_previousActions;
+                std::size_t m_previousOrder;
+
+            public:
+                Scope(DeferredActions &actions, std::size_t order);
+                ~Scope();
+        };
+
+    private:
+        struct Entry
+        {
+            std::size_t order;
+            Action action;
+        };
+
+        static thread_local DeferredActions *currentActions;
+        static thread_local std::size_t currentOrder;
+
+        // One buffer for each thread index of the job system
+        std::vector<std::vector<Entry>> m_buffers;
+        std::vector<Entry> m_merged;
+        std::size_t m_lastActionCnt;
+
+    public:
+        explicit DeferredActions(std::size_t threadCnt);
+
+        // Store the action, when the thread is in a scope, otherwise execute 
+        // it
+        static void add(Action action);
+        // Execute the stored actions of all threads and clear the buffers. 
+        // Has to be called when no thread adds actions anymore
+        void execute();
+        // The number of actions executed by the last execute()
+        std::size_t getLastActionCnt() const;
+};
+
+#endif // DEFERREDACTIONS_HPP
@@ -0,0 +1,85 @@
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+#include <SFML/System.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Runs jobs on a pool of worker threads. Every thread has its own queue, a
+ * thread adds its jobs to its own queue and takes them from the back, so it
+ * works on the jobs it added last (which data is still in the cache). When 
+ * the queue of a thread is empty, it steals the oldest job from the queue of
+ * another thread.
+ * The thread which waits for jobs (see wait()) helps to execute them, so it
+ * never blocks, even when there are no workers at all.
+ * Jobs are not allowed to throw.
+ */
+class JobSystem : private sf::NonCopyable
+{
+    public:
+        typedef std::function<void()> Job;
+        // The number of jobs which are not finished yet
+        typedef std::atomic<std::size_t> Counter;
+
+    private:
+        struct Task
+        {
+            Job job;
+            Counter *counter;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        // The index of the queue of the thread, 0 is used by all threads which
+        // are not workers (e.g. the main thread)
+        static thread_local std::size_t threadIndex;
+
+        std::vector<std::thread> m_workers;
+        // One queue for each worker and the first for the other threads
+        std::vector<std::unique_ptr<WorkQueue>> m_queues;
+        std::atomic<std::size_t> m_queuedCnt;
+        std::atomic<bool> m_isStopping;
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wakeCondition;
+
+    public:
+        // A negative worker count uses one worker less than the cpu has cores
+        explicit JobSystem(int workerCnt);
+        ~JobSystem();
+
+        // Add a job, the counter is increased by one and decreased again when
+        // the job is finished
+        void schedule(Job job, Counter &counter);
+        // Execute jobs until the counter reaches 0
+        void wait(Counter &counter);
+        // Call the function for every index from 0 to count - 1. The indices
+        // are split in batches of at least minBatchSize, the call returns 
+        // when all are finished
+        void parallelFor(std::size_t count, std::size_t minBatchSize, 
+                const std::function<void(std::size_t)> &function);
+
+        std::size_t getWorkerCnt() const;
+        // The number of threads which execute jobs (The workers and the one 
+        // which waits)
+        std::size_t getThreadCnt() const;
+        // The index of the calling thread, 0 for all threads which are not a
+        // worker of a job system
+        static std::size_t getThreadIndex();
+
+    private:
+        void runWorker(std::size_t index);
+        // Take a job from the own queue or steal one of another thread
+        bool tryGetTask(std::size_t index, Task &task);
+        void execute(Task &task);
+};
+
+#endif // JOBSYSTEM_HPP
@@ -28,6 +28,8 @@ struct Level
         };
 
         std::string name;
+        // The size of a tile, the tiles are placed in a grid of this size
+        sf::Vector2f tileSize;
         std::vector<TileData> tiles;
         std::unique_ptr<SpawnPoint> spawnPoint1;
         std::unique_ptr<SpawnPoint> spawnPoint2;
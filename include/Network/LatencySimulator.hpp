@@ -0,0 +1,51 @@
+#ifndef LATENCYSIMULATOR_HPP
+#define LATENCYSIMULATOR_HPP
+#include "Network/NetTransport.hpp"
+#include "Random/RandomStream.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/* Wraps a transport and sends its packets with a delay, a random jitter and
+ * a random loss, so the rollback networking can be tested on one machine 
+ * (With the loopback transport or with two games on the localhost). 
+ * The delayed packets are passed to the transport by the next send() or 
+ * receive(), ordered by the time when they are due, so the jitter can also 
+ * change the order of the packets.
+ */
+class LatencySimulator : public NetTransport
+{
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct DelayedPacket
+        {
+            Clock::time_point dueTime;
+            std::vector<char> data;
+        };
+
+        std::unique_ptr<NetTransport> m_transport;
+        // In seconds
+        const float m_delay;
+        const float m_jitter;
+        // The probability that a packet gets lost (0 to 1)
+        const float m_lossRate;
+        // Not a stream of the RandomService, so the game logic gets the same
+        // numbers with and without the simulator
+        RandomStream m_random;
+        // Sorted by the due time
+        std::vector<DelayedPacket> m_packets;
+
+    public:
+        LatencySimulator(std::unique_ptr<NetTransport> transport, float delay, 
+                float jitter, float lossRate);
+
+        virtual void send(const char *data, std::size_t size) override;
+        virtual bool receive(std::vector<char> &packet) override;
+
+    private:
+        // Pass the packets which are due to the transport
+        void sendDuePackets();
+};
+
+#endif // LATENCYSIMULATOR_HPP
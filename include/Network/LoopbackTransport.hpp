@@ -0,0 +1,30 @@
+#ifndef LOOPBACKTRANSPORT_HPP
+#define LOOPBACKTRANSPORT_HPP
+#include "Network/NetTransport.hpp"
+#include <deque>
+#include <vector>
+
+/* Passes the packets to another transport in the same process, so both 
+ * peers of a match can run in one game (e.g. with the LatencySimulator to 
+ * test the rollback networking without a network). Both ends have to be 
+ * used by the same thread.
+ */
+class LoopbackTransport : public NetTransport
+{
+    private:
+        LoopbackTransport *m_peer;
+        std::deque<std::vector<char>> m_packets;
+
+    public:
+        LoopbackTransport();
+        virtual ~LoopbackTransport();
+
+        // The packets sent by one transport are received by the other one
+        static void connect(LoopbackTransport &transportA, 
+                LoopbackTransport &transportB);
+
+        virtual void send(const char *data, std::size_t size) override;
+        virtual bool receive(std::vector<char> &packet) override;
+};
+
+#endif // LOOPBACKTRANSPORT_HPP
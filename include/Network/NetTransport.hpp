@@ -0,0 +1,20 @@
+#ifndef NETTRANSPORT_HPP
+#define NETTRANSPORT_HPP
+#include <cstddef>
+#include <vector>
+
+/* Sends and receives packets without a connection. Like with UDP the packets
+ * can get lost or arrive in another order, so the protocol on top has to 
+ * handle it. The transports never block.
+ */
+class NetTransport
+{
+    public:
+        virtual ~NetTransport() = default;
+
+        virtual void send(const char *data, std::size_t size) = 0;
+        // Get the next received packet, returns false when there is none
+        virtual bool receive(std::vector<char> &packet) = 0;
+};
+
+#endif // NETTRANSPORT_HPP
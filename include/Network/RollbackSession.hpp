@@ -0,0 +1,137 @@
+#ifndef ROLLBACKSESSION_HPP
+#define ROLLBACKSESSION_HPP
+#include <SFML/System.hpp>
+#include "Components/EnumWorldObjectTypes.hpp"
+#include "Input/Command.hpp"
+#include "Network/NetTransport.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/* Exchanges the commands of every simulation step with the remote peer, so 
+ * both games simulate the same match (Rollback networking).
+ * The local commands are delayed by a few steps (the input delay), so most of
+ * them arrive before the remote game simulates their step. When the remote
+ * commands of a step are missing, they are predicted from the last received 
+ * step. When the real commands arrive and differ from the prediction, the 
+ * game has to restore the state of that step and simulate the steps again 
+ * (see popRollbackStep()).
+ * Every packet contains all commands which the remote peer hasnt acked yet,
+ * so lost packets dont need to be sent again. The peers also exchange a 
+ * checksum of the confirmed steps to detect, when the games differ.
+ */
+class RollbackSession : private sf::NonCopyable
+{
+    public:
+        // The maximum number of steps which can be predicted
+        static const std::size_t BufferSize{ 64 };
+        static const std::uint64_t NoStep{ 
+            std::numeric_limits<std::uint64_t>::max() };
+
+        struct Stats
+        {
+            std::uint64_t sentPackets;
+            std::uint64_t receivedPackets;
+            std::uint64_t sentBytes;
+            std::uint64_t receivedBytes;
+            std::uint64_t predictions;
+            std::uint64_t mispredictions;
+            std::uint64_t rollbacks;
+            std::uint64_t maxRollbackDepth;
+            std::uint64_t resimulatedSteps;
+            // The steps where the game waited for the remote commands
+            std::uint64_t stalls;
+        };
+
+    private:
+        struct InputStep
+        {
+            std::uint64_t step;
+            bool isSet;
+            // The commands are a prediction (Only for remote steps)
+            bool isPredicted;
+            std::vector<Command> commands;
+        };
+
+        NetTransport &m_transport;
+        // The player controlled by the remote peer
+        const WorldObjectTypes m_remotePlayer;
+        const std::uint64_t m_inputDelay;
+        InputStep m_localSteps[BufferSize];
+        InputStep m_remoteSteps[BufferSize];
+        // The first step without local commands
+        std::uint64_t m_localEnd;
+        // The first step whose remote commands didnt arrive
+        std::uint64_t m_remoteEnd;
+        // The first local step which the remote peer didnt ack
+        std::uint64_t m_remoteAck;
+        // The remote step which was used for the last prediction
+        std::uint64_t m_lastRealRemoteStep;
+        // The earliest step which was predicted wrong
+        std::uint64_t m_rollbackStep;
+        // The checksums of the confirmed steps of both peers
+        std::uint64_t m_checksumSteps[BufferSize];
+        std::uint32_t m_checksums[BufferSize];
+        std::uint64_t m_remoteChecksumSteps[BufferSize];
+        std::uint32_t m_remoteChecksums[BufferSize];
+        // The last step with a local checksum, it is sent to the remote peer
+        std::uint64_t m_lastChecksumStep;
+        std::uint64_t m_desyncStep;
+        bool m_isConnected;
+        Stats m_stats;
+
+        BinaryWriter m_packet;
+        std::vector<char> m_receiveBuffer;
+
+    public:
+        RollbackSession(NetTransport &transport, WorldObjectTypes remotePlayer, 
+                std::size_t inputDelay);
+
+        // Returns false, when the remote peer didnt ack enough steps to add
+        // more commands (The game has to wait)
+        bool canAddLocalCommands() const;
+        // Add the local commands of the next input step, which is the current
+        // step plus the input delay
+        void addLocalCommands(const std::vector<Command> &commands);
+        // Send all commands, which the remote peer didnt ack
+        void send();
+        // Receive all packets of the transport
+        void receive();
+
+        // Get the local and the remote (or predicted) commands of the step. 
+        // Returns false, when the local commands of the step are missing
+        bool getCommands(std::uint64_t step, std::vector<Command> &commands);
+        // Get the earliest step, whose prediction was wrong and forget it. 
+        // Returns NoStep when no rollback is needed
+        std::uint64_t popRollbackStep();
+        // All steps before this step have the real commands of both peers
+        std::uint64_t getConfirmedStep() const;
+
+        // Set the checksum of the state after the confirmed step, it is 
+        // compared with the one of the remote peer
+        void setChecksum(std::uint64_t step, std::uint32_t checksum);
+        bool isDesynced() const;
+        std::uint64_t getDesyncStep() const;
+        // A packet of the remote peer was received
+        bool isConnected() const;
+
+        void countRollback(std::uint64_t depth);
+        void countStall();
+        const Stats& getStats() const;
+        std::string getReport() const;
+
+    private:
+        InputStep& getLocalStep(std::uint64_t step);
+        InputStep& getRemoteStep(std::uint64_t step);
+        void predictRemoteStep(std::uint64_t step);
+        bool isPredictable(const Command &command) const;
+        bool isSameCommands(const std::vector<Command> &commandsA,
+                const std::vector<Command> &commandsB) const;
+        // Compare the checksums of the step, when both are known
+        void compareChecksums(std::uint64_t step);
+};
+
+#endif // ROLLBACKSESSION_HPP
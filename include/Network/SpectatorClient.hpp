@@ -0,0 +1,78 @@
+#ifndef SPECTATORCLIENT_HPP
+#define SPECTATORCLIENT_HPP
+#include <SFML/Network.hpp>
+#include "Network/SpectatorState.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Receives the states of a SpectatorServer and acks them, so the viewer 
+ * can show the match without simulating it. The entities are interpolated 
+ * between the received states, so the viewer shows the match a bit in the
+ * past (the delay) and lost or late packets dont make the entities jump.
+ */
+class SpectatorClient : private sf::NonCopyable
+{
+    public:
+        // An entity of the interpolated state
+        struct ViewEntity
+        {
+            unsigned int id;
+            unsigned int types;
+            unsigned int spawnerId;
+            sf::Vector2f position;
+            float rotation;
+            float health;
+            float stanima;
+        };
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        sf::UdpSocket m_socket;
+        sf::IpAddress m_serverAddress;
+        unsigned short m_serverPort;
+        // The received states indexed by their sequence
+        SpectatorState m_states[SpectatorState::HistorySize];
+        // 0 when no state was received
+        std::uint32_t m_newestSequence;
+        // When the newest state was received, to estimate the time of the
+        // server
+        Clock::time_point m_newestReceiveTime;
+        Clock::time_point m_lastAckTime;
+        std::uint64_t m_receivedBytes;
+        std::uint64_t m_receivedStates;
+        std::uint64_t m_droppedStates;
+        Clock::time_point m_windowStart;
+        std::uint64_t m_windowBytes;
+        float m_bytesPerSecond;
+        BinaryWriter m_packet;
+        std::vector<char> m_receiveBuffer;
+
+    public:
+        SpectatorClient();
+
+        // Returns false, when no local port can be bound
+        bool open(const sf::IpAddress &serverAddress, unsigned short port);
+
+        // Receive the states and send the ack (Also to join the server)
+        void update();
+        // Get the entities at the time of the match (in seconds). Returns 
+        // false when no state was received yet
+        bool interpolate(double time, std::vector<ViewEntity> &entities) const;
+        // The estimated current time of the match on the server
+        double getServerTime() const;
+
+        bool hasState() const;
+        float getBytesPerSecond() const;
+        std::string getReport() const;
+
+    private:
+        void receiveStates();
+        void sendAck();
+};
+
+#endif // SPECTATORCLIENT_HPP
@@ -0,0 +1,74 @@
+#ifndef SPECTATORSERVER_HPP
+#define SPECTATORSERVER_HPP
+#include <SFML/Network.hpp>
+#include "Network/SpectatorState.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Streams the state of the match over UDP to the spectators, which run the
+ * SpectatorClient. A spectator joins by sending its acks to the port of the
+ * server and is dropped, when it doesnt send anything for a few seconds.
+ * Every spectator gets the states as delta to the last state it acked, so a 
+ * lost packet only makes the next deltas a bit larger. When the acked state
+ * is too old, the full state is sent.
+ */
+class SpectatorServer : private sf::NonCopyable
+{
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Client
+        {
+            sf::IpAddress address;
+            unsigned short port;
+            // 0 when the spectator didnt ack a state yet
+            std::uint32_t ackedSequence;
+            Clock::time_point lastPacketTime;
+            std::uint64_t sentBytes;
+            std::uint64_t sentStates;
+            std::uint64_t fullStates;
+            // The bytes of the current second
+            std::uint64_t windowBytes;
+            float bytesPerSecond;
+        };
+
+        sf::UdpSocket m_socket;
+        bool m_isOpen;
+        std::vector<Client> m_clients;
+        // The sent states indexed by their sequence
+        SpectatorState m_states[SpectatorState::HistorySize];
+        std::uint32_t m_sequence;
+        Clock::time_point m_windowStart;
+        BinaryWriter m_packet;
+        std::vector<char> m_receiveBuffer;
+
+    public:
+        SpectatorServer();
+
+        // Returns false, when the port cant be bound
+        bool open(unsigned short port);
+        bool isOpen() const;
+
+        // Get the state, which is sent by the next publish(). It is cleared
+        SpectatorState& beginState();
+        // Receive the acks of the spectators and send them the state
+        void publish();
+
+        std::size_t getClientCnt() const;
+        // The bytes per second sent to all spectators
+        float getBytesPerSecond() const;
+        // The bandwidth and the sent states of every spectator
+        std::string getReport() const;
+
+    private:
+        void receiveAcks();
+        // Find the client or add it, returns nullptr when there are too many
+        Client* findClient(const sf::IpAddress &address, unsigned short port);
+        void updateBandwidth();
+};
+
+#endif // SPECTATORSERVER_HPP
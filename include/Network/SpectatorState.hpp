@@ -0,0 +1,70 @@
+#ifndef SPECTATORSTATE_HPP
+#define SPECTATORSTATE_HPP
+#include <SFML/System.hpp>
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* What the spectators see of a match: the transforms of the warriors and the
+ * projectiles and the health and stanima of the warriors.
+ * The values are quantized and a state is written as delta to a base state, 
+ * which the spectator already has, so an entity which didnt change only 
+ * needs two bytes.
+ */
+struct SpectatorState
+{
+    // The packets of the server start with StateMagic, the ones of the 
+    // spectators with AckMagic
+    static const std::uint32_t StateMagic{ 0x53505341 };
+    static const std::uint32_t AckMagic{ 0x4B435341 };
+    static const std::uint8_t Version{ 1 };
+    // The number of states, which the server and the spectators keep as 
+    // base for the deltas
+    static const std::size_t HistorySize{ 32 };
+
+    struct Entity
+    {
+        unsigned int id;
+        // The WorldObjectTypes of the node
+        unsigned int types;
+        // The node which spawned the projectile (0 for warriors)
+        unsigned int spawnerId;
+        // In 1/8 pixel
+        std::int32_t posX;
+        std::int32_t posY;
+        // In 1/65536 of a full turn
+        std::uint16_t rotation;
+        // In 1/4
+        std::uint16_t health;
+        std::uint16_t stanima;
+
+        sf::Vector2f getPosition() const;
+        // In degrees
+        float getRotation() const;
+        float getHealth() const;
+        float getStanima() const;
+    };
+
+    // Increased by the server for every sent state
+    std::uint32_t sequence;
+    // The time of the match in milliseconds
+    std::uint64_t time;
+    // Sorted by the ids
+    std::vector<Entity> entities;
+
+    void clear();
+    // The entities have to be added ordered by their ids
+    void addEntity(unsigned int id, unsigned int types, unsigned int spawnerId,
+            sf::Vector2f pos, float rotation, float health, float stanima);
+    const Entity* findEntity(unsigned int id) const;
+
+    // The base can be nullptr, then all values are written
+    void writeDelta(const SpectatorState *base, BinaryWriter &writer) const;
+    // The base has to be the state which was used to write the delta.
+    // Returns false when the data is corrupt
+    bool readDelta(const SpectatorState *base, BinaryReader &reader);
+};
+
+#endif // SPECTATORSTATE_HPP
@@ -0,0 +1,35 @@
+#ifndef UDPTRANSPORT_HPP
+#define UDPTRANSPORT_HPP
+#include <SFML/Network.hpp>
+#include "Network/NetTransport.hpp"
+#include <vector>
+
+/* Sends the packets over a non blocking UDP socket to one remote peer. When
+ * the remote address is not known (sf::IpAddress::None), the sender of the
+ * first received packet becomes the remote peer, so the host dont need the 
+ * address of the client. Packets of other senders are ignored.
+ */
+class UdpTransport : public NetTransport
+{
+    private:
+        sf::UdpSocket m_socket;
+        sf::IpAddress m_remoteAddress;
+        unsigned short m_remotePort;
+        bool m_hasRemote;
+        // Large enough for every datagram, so it isnt resized per packet
+        std::vector<char> m_receiveBuffer;
+
+    public:
+        UdpTransport();
+
+        // Returns false, when the local port cant be bound
+        bool open(unsigned short localPort, const sf::IpAddress &remoteAddress,
+                unsigned short remotePort);
+
+        virtual void send(const char *data, std::size_t size) override;
+        virtual bool receive(std::vector<char> &packet) override;
+
+        bool hasRemote() const;
+};
+
+#endif // UDPTRANSPORT_HPP
@@ -0,0 +1,68 @@
+#ifndef ALLOCATIONTRACKER_HPP
+#define ALLOCATIONTRACKER_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Counts the heap allocations of the game by replacing the global operator new
+ * and delete. The tracking is only compiled in, when ARENA_TRACK_ALLOCATIONS is
+ * defined (see MY_CFLAGS in the Makefile), otherwise all functions are empty
+ * and the allocator of the standard library is used.
+ * Every allocation is attributed to the current scope of the allocating
+ * thread. ProfileZone sets the scope, so the allocations are reported per
+ * profiler zone (e.g. "MainGameScreen::handleCollision").
+ */
+class AllocationTracker
+{
+    public:
+        // The maximal number of different scopes which are tracked, allocations
+        // of further scopes are added to the scope "other"
+        static const std::size_t MAX_SCOPES{ 32 };
+
+        struct FrameStats
+        {
+            std::uint64_t allocations;
+            std::uint64_t bytes;
+            std::uint64_t deallocations;
+        };
+
+        // Make name to the scope of the current thread and return the
+        // previous one, which should be restored later with leaveScope()
+        static const char* enterScope(const char *name);
+        static void leaveScope(const char *previousName);
+
+        // Close the current frame, the counted allocations are then
+        // available with getLastFrame() and getLastFrameScope()
+        static void endFrame();
+        static const FrameStats& getLastFrame();
+        // Get the number of scopes, which had allocations in the last frame
+        static std::size_t getLastFrameScopeCnt();
+        // Get the scope with the index in the last frame, sorted by the
+        // number of allocated bytes
+        static const char* getLastFrameScope(std::size_t index,
+                FrameStats &stats);
+
+        // Frames which have more allocations than the budget are counted, a
+        // budget of 0 means that steady state gameplay should not allocate
+        static void setFrameBudget(std::uint64_t allocations);
+        static std::uint64_t getFramesOverBudget();
+
+        // Short report of the last frame for the stats overlay and the console
+        static std::string getReport(std::size_t maxScopes);
+
+        static bool isEnabled();
+};
+
+#ifndef ARENA_TRACK_ALLOCATIONS
+inline const char* AllocationTracker::enterScope(const char *name)
+{
+    return nullptr;
+}
+
+inline void AllocationTracker::leaveScope(const char *previousName)
+{
+
+}
+#endif // ARENA_TRACK_ALLOCATIONS
+
+#endif // ALLOCATIONTRACKER_HPP
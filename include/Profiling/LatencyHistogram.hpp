@@ -0,0 +1,45 @@
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Counts measured latencies in buckets which double their size, starting
+ * with the bucket below 1 ms up to the last bucket which contains everything
+ * above 32 ms. Used for the stats overlay, so it is not thread safe.
+ */
+class LatencyHistogram
+{
+    public:
+        static const std::size_t BUCKET_CNT{ 7 };
+
+    private:
+        std::array<std::uint64_t, BUCKET_CNT> m_buckets;
+        std::uint64_t m_cnt;
+        float m_totalMs;
+        float m_maxMs;
+
+    public:
+        LatencyHistogram();
+
+        // Add a latency in seconds
+        void add(float latency);
+        void clear();
+
+        std::uint64_t getCnt() const;
+        std::uint64_t getBucketCnt(std::size_t bucket) const;
+        // The upper bound of the bucket in milliseconds (The last bucket has
+        // no upper bound)
+        static float getBucketLimit(std::size_t bucket);
+        float getAverageMs() const;
+        float getMaxMs() const;
+        // Get the latency in milliseconds, below which the given part (0 to 1)
+        // of the latencies is. Only as exact as the buckets
+        float getPercentileMs(float percentile) const;
+
+        // One line for the stats overlay
+        std::string getReport(const std::string &name) const;
+};
+
+#endif // LATENCYHISTOGRAM_HPP
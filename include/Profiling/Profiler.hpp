@@ -0,0 +1,101 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Records timed zones, frame markers and counters while a capture is running
+ * and writes them as a Chrome trace-event JSON file, which can be opened in
+ * chrome://tracing or any other viewer understanding this format.
+ * All functions are static, so the profiler can be used from every place in
+ * the game without passing it around.
+ * The zone names have to be string literals (or otherwise stay valid until the
+ * capture is written), because only the pointer is stored while recording.
+ */
+class Profiler
+{
+    private:
+        typedef std::chrono::steady_clock ProfileClock;
+
+        enum class EventType
+        {
+            ZONE,
+            FRAME,
+            COUNTER
+        };
+
+        struct Event
+        {
+            EventType type;
+            const char *name;
+            // Start time in microseconds since the begin of the capture
+            std::int64_t start;
+            // Duration in microseconds (only used for zones)
+            std::int64_t duration;
+            // Value of a counter or the number of a frame
+            double value;
+            unsigned int threadId;
+        };
+
+        static std::atomic<bool> m_isCapturing;
+        static std::vector<Event> m_events;
+        static std::mutex m_eventsMutex;
+        static ProfileClock::time_point m_captureStart;
+        static std::uint64_t m_frameNumber;
+        static std::string m_lastTraceFile;
+
+    public:
+        static void startCapture();
+        // Stop the capture and write the recorded events to the given file.
+        // Returns false when there was no capture running or the file could not
+        // be written
+        static bool stopCapture(const std::string &fileName);
+        // Stop the capture and write it to a generated file name
+        static bool stopCapture();
+        static bool isCapturing();
+        // Returns the file name of the last written trace
+        static const std::string& getLastTraceFile();
+
+        // Mark the begin of a new frame
+        static void markFrame();
+        static std::uint64_t getFrameNumber();
+
+        // Record the value of a counter (e.g. the number of scene nodes)
+        static void setCounter(const char *name, double value);
+
+        // Get the current time, which is used for zones
+        static std::int64_t now();
+        static void addZone(const char *name, std::int64_t start,
+                std::int64_t end);
+
+    private:
+        static unsigned int getThreadId();
+        static void addEvent(const Event &event);
+        static bool writeTrace(const std::string &fileName,
+                const std::vector<Event> &events);
+};
+
+// Measure the time from construction to destruction and add it as zone to the
+// profiler. Usage: ProfileZone zone{ "Game::update" };
+// The zone is also the scope to which the AllocationTracker attributes heap
+// allocations
+class ProfileZone
+{
+    private:
+        const char *m_name;
+        std::int64_t m_start;
+        bool m_isRecording;
+        const char *m_previousAllocScope;
+
+    public:
+        explicit ProfileZone(const char *name);
+        ~ProfileZone();
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#endif // PROFILER_HPP
@@ -0,0 +1,20 @@
+#ifndef ENUMRANDOMSTREAMS_HPP
+#define ENUMRANDOMSTREAMS_HPP
+
+/* Every subsystem draws its random numbers from its own stream, so e.g. 
+ * creating an extra id doesnt change the numbers of the game logic
+ */
+enum class RandomStreams
+{
+    // The game logic, which has to be the same in a replay
+    GAMEPLAY,
+    AI,
+    // Ids of warriors, weapons and attacks
+    IDS,
+    // Only the presentation, e.g. the music choice
+    AUDIO,
+
+    COUNT
+};
+
+#endif // ENUMRANDOMSTREAMS_HPP
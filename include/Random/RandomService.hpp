@@ -0,0 +1,33 @@
+#ifndef RANDOMSERVICE_HPP
+#define RANDOMSERVICE_HPP
+#include "Random/EnumRandomStreams.hpp"
+#include "Random/RandomStream.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/* Owns one random stream per subsystem (see RandomStreams). All streams are
+ * seeded from one seed, so a match is reproduced by seeding the service with
+ * the seed of the match (e.g. from the config or a replay file).
+ * All functions are static like the ones of the Profiler. A stream must only
+ * be used by one thread at a time.
+ */
+class RandomService
+{
+    private:
+        static RandomStream m_streams[static_cast<std::size_t>(
+                RandomStreams::COUNT)];
+        static std::uint32_t m_seed;
+
+    public:
+        // Seed all streams, every stream gets its own sequence
+        static void seed(std::uint32_t seed);
+        // The seed of the last call to seed()
+        static std::uint32_t getSeed();
+        // Get a seed from the random device of the system. Slow, so only 
+        // used once per match
+        static std::uint32_t createSeed();
+
+        static RandomStream& getStream(RandomStreams stream);
+};
+
+#endif // RANDOMSERVICE_HPP
@@ -0,0 +1,45 @@
+#ifndef RANDOMSTREAM_HPP
+#define RANDOMSTREAM_HPP
+#include <cstdint>
+
+/* A small and fast random number generator (PCG32). The whole state are two
+ * 64 bit numbers, so it can be copied for snapshots and a call only needs a 
+ * multiplication and some shifts.
+ * Streams with the same seed but another stream id give independent numbers.
+ * The numbers are the same on every platform, unlike the distributions of 
+ * the standard library.
+ */
+class RandomStream
+{
+    public:
+        struct State
+        {
+            std::uint64_t state;
+            std::uint64_t increment;
+        };
+
+    private:
+        State m_state;
+
+    public:
+        RandomStream();
+        RandomStream(std::uint64_t seed, std::uint64_t streamId);
+
+        void seed(std::uint64_t seed, std::uint64_t streamId);
+
+        std::uint32_t getUInt32();
+        // Get a random num between a (inclusive) and b (inclusive), without 
+        // the bias of a modulo
+        int getInt(int a, int b);
+        // Get a random num between 0 (inclusive) and 1 (exclusive)
+        float getFloat();
+        // Get a random num between a (inclusive) and b (exclusive)
+        float getFloat(float a, float b);
+        // Returns true with the given probability (0 to 1)
+        bool getChance(float probability);
+
+        const State& getState() const;
+        void setState(const State &state);
+};
+
+#endif // RANDOMSTREAM_HPP
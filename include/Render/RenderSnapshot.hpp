@@ -0,0 +1,75 @@
+#ifndef RENDERSNAPSHOT_HPP
+#define RENDERSNAPSHOT_HPP
+#include <SFML/Graphics.hpp>
+#include <limits>
+#include <vector>
+#include "Render/EnumRenderLayers.hpp"
+
+/* Everything which is needed to draw the sprites of a scene, without access 
+ * to the scene nodes. It is filled by the simulation thread after a step and
+ * drawn by the render thread, while the simulation already computes the next
+ * step.
+ * Every node stores its position, rotation and scale from the begin and the
+ * end of the step, so the render thread can interpolate them (the rotation 
+ * the shorter way) and build the world transforms of the interpolated 
+ * nodes. The sprites are drawn with the transforms of their nodes.
+ */
+class RenderSnapshot
+{
+    public:
+        static const std::size_t NoParent{ 
+            std::numeric_limits<std::size_t>::max() };
+
+        struct Node
+        {
+            // The index of the parent node or NoParent. The parents are added
+            // before their children
+            std::size_t parent;
+            sf::Vector2f origin;
+            sf::Vector2f lastPosition;
+            float lastRotation;
+            sf::Vector2f lastScale;
+            sf::Vector2f position;
+            float rotation;
+            sf::Vector2f scale;
+        };
+
+        struct Sprite
+        {
+            RenderLayers layer;
+            const sf::Texture *texture;
+            sf::IntRect textureRect;
+            sf::Color color;
+            // The index of the node which draws the sprite
+            std::size_t node;
+            // The transform of the sprite in its node (e.g. the origin)
+            sf::Transform transform;
+        };
+
+    private:
+        std::vector<Node> m_nodes;
+        std::vector<Sprite> m_sprites;
+        // Only used by draw()
+        mutable std::vector<sf::Transform> m_worldTransforms;
+
+    public:
+        // Remove all nodes and sprites, the memory is kept
+        void clear();
+        // Returns the index of the node
+        std::size_t addNode(const Node &node);
+        void addSprite(const Sprite &sprite);
+        // Sort the sprites by their layers, the order inside a layer is kept
+        // (Has to be called before draw())
+        void sortByLayer();
+        std::size_t getSpriteCnt() const;
+
+        // Draw the sprites, interpolated between the last transform (0) and 
+        // the actual one (1)
+        void draw(sf::RenderTarget &target, sf::RenderStates states, 
+                float interpolation) const;
+
+    private:
+        static sf::Transform interpolate(const Node &node, float interpolation);
+};
+
+#endif // RENDERSNAPSHOT_HPP
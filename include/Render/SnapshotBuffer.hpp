@@ -0,0 +1,58 @@
+#ifndef SNAPSHOTBUFFER_HPP
+#define SNAPSHOTBUFFER_HPP
+#include <SFML/System.hpp>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/* Passes snapshots from one writer thread to one reader thread without that
+ * one of them has to wait for the other. The writer fills the back buffer and
+ * publishes it, the reader acquires the last published snapshot as front 
+ * buffer. Only the buffers are swapped under the lock, so T should be cheap
+ * to swap (e.g. contain vectors).
+ * When the writer publishes faster than the reader acquires, the older 
+ * snapshots are skipped. The number of published snapshots between two 
+ * acquires is the queue depth.
+ */
+template <typename T>
+class SnapshotBuffer : private sf::NonCopyable
+{
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Slot
+        {
+            T data;
+            Clock::time_point publishTime;
+        };
+
+        Slot m_back;
+        Slot m_ready;
+        Slot m_front;
+        std::mutex m_mutex;
+        // The snapshots which were published since the last acquire
+        std::size_t m_pendingCnt;
+        std::size_t m_lastQueueDepth;
+        std::uint64_t m_publishedCnt;
+
+    public:
+        SnapshotBuffer();
+
+        // Only used by the writer
+        T& getBackBuffer();
+        void publish();
+
+        // Only used by the reader. Returns false when there is no new snapshot
+        bool acquire();
+        const T& getFrontBuffer() const;
+        // Get how many seconds ago the front buffer was published
+        float getFrontAge() const;
+        // The number of snapshots which were published between the last two
+        // acquires (Everything above 1 was never shown)
+        std::size_t getLastQueueDepth() const;
+        std::uint64_t getPublishedCnt();
+};
+
+#include "Render/SnapshotBuffer.inl"
+
+#endif // SNAPSHOTBUFFER_HPP
@@ -0,0 +1,66 @@
+#include <utility>
+
+template <typename T>
+SnapshotBuffer<T>::SnapshotBuffer()
+: m_pendingCnt{ 0 }
+, m_lastQueueDepth{ 0 }
+, m_publishedCnt{ 0 }
+{
+    m_front.publishTime = Clock::now();
+}
+
+template <typename T>
+T& SnapshotBuffer<T>::getBackBuffer()
+{
+    return m_back.data;
+}
+
+template <typename T>
+void SnapshotBuffer<T>::publish()
+{
+    m_back.publishTime = Clock::now();
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    std::swap(m_back, m_ready);
+    m_pendingCnt++;
+    m_publishedCnt++;
+}
+
+template <typename T>
+bool SnapshotBuffer<T>::acquire()
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    if (m_pendingCnt == 0)
+    {
+        return false;
+    }
+    std::swap(m_ready, m_front);
+    m_lastQueueDepth = m_pendingCnt;
+    m_pendingCnt = 0;
+    return true;
+}
+
+template <typename T>
+const T& SnapshotBuffer<T>::getFrontBuffer() const
+{
+    return m_front.data;
+}
+
+template <typename T>
+float SnapshotBuffer<T>::getFrontAge() const
+{
+    return std::chrono::duration<float>(
+            Clock::now() - m_front.publishTime).count();
+}
+
+template <typename T>
+std::size_t SnapshotBuffer<T>::getLastQueueDepth() const
+{
+    return m_lastQueueDepth;
+}
+
+template <typename T>
+std::uint64_t SnapshotBuffer<T>::getPublishedCnt()
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    return m_publishedCnt;
+}
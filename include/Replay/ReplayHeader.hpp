@@ -0,0 +1,25 @@
+#ifndef REPLAYHEADER_HPP
+#define REPLAYHEADER_HPP
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <cstdint>
+#include <string>
+
+/* The start of a replay file, it contains everything which is needed to 
+ * build the same match again.
+ */
+struct ReplayHeader
+{
+    // The seed of the random numbers (see RandomService::seed())
+    std::uint32_t randomSeed;
+    std::uint8_t gameMode;
+    std::string levelId;
+    std::uint32_t player1Warrior;
+    std::uint32_t player2Warrior;
+
+    void write(BinaryWriter &writer) const;
+    // Returns false when the data is no replay or has another version
+    bool read(BinaryReader &reader);
+};
+
+#endif // REPLAYHEADER_HPP
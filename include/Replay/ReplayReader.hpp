@@ -0,0 +1,49 @@
+#ifndef REPLAYREADER_HPP
+#define REPLAYREADER_HPP
+#include "Input/Command.hpp"
+#include "Replay/ReplayHeader.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Reads the steps of a file written by the ReplayWriter. The whole file is
+ * loaded at once, so reading the steps doesnt wait for the disk and the 
+ * replay can run at maximum speed.
+ */
+class ReplayReader
+{
+    public:
+        struct Tick
+        {
+            float dt;
+            std::vector<Command> commands;
+            // The checksum of the state after the recorded step
+            std::uint32_t stateChecksum;
+        };
+
+    private:
+        std::vector<char> m_data;
+        BinaryReader m_reader;
+        ReplayHeader m_header;
+        // Where the first step starts
+        std::size_t m_ticksBegin;
+        bool m_isOpen;
+
+    public:
+        ReplayReader();
+
+        // Returns false when the file cant be read or is no replay
+        bool open(const std::string &fileName);
+        bool isOpen() const;
+        const ReplayHeader& getHeader() const;
+
+        // Returns false at the end of the replay or when the file is corrupt
+        bool readTick(Tick &tick);
+        // Start again with the first step
+        void rewind();
+        // False when the file ended in the middle of a step
+        bool isValid() const;
+};
+
+#endif // REPLAYREADER_HPP
@@ -0,0 +1,43 @@
+#ifndef REPLAYWRITER_HPP
+#define REPLAYWRITER_HPP
+#include <SFML/System.hpp>
+#include "Input/Command.hpp"
+#include "Replay/ReplayHeader.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/* Records the commands of every simulation step of a match into a file, so
+ * the match can be simulated again with the ReplayReader.
+ * A step is stored as its delta time, the commands and a checksum of the 
+ * state after the step, which is used to find the first step where the 
+ * replayed simulation differs (e.g. between two builds).
+ */
+class ReplayWriter : private sf::NonCopyable
+{
+    private:
+        std::ofstream m_file;
+        // The commands of the current step
+        BinaryWriter m_commands;
+        std::uint64_t m_commandCnt;
+        BinaryWriter m_tick;
+        std::uint64_t m_tickCnt;
+
+    public:
+        ReplayWriter();
+
+        // Returns false when the file cant be written
+        bool open(const std::string &fileName, const ReplayHeader &header);
+        void close();
+        bool isOpen() const;
+
+        // Both do nothing, when the writer is not open
+        void addCommand(const Command &command);
+        // Write the step with the commands added since the last step
+        void endTick(float dt, std::uint32_t stateChecksum);
+
+        std::uint64_t getTickCnt() const;
+};
+
+#endif // REPLAYWRITER_HPP
@@ -1,19 +1,35 @@
 #ifndef MAINGAMESCREEN_HPP
 #define MAINGAMESCREEN_HPP
 #include "libs/GUI-SFML/include/GUI-SFML.hpp"
+#include "Collision/CollisionWorld.hpp"
+#include "Collision/ContactSolver.hpp"
 #include "Components/Warrior.hpp"
 #include "Components/EnumWorldObjectTypes.hpp"
 #include "Components/SceneNode.hpp"
-#include "Input/QueueHelper.hpp"
+#include "Config/WarriorArchetype.hpp"
 #include "Input/Input.hpp"
 #include "Input/Command.hpp"
+#include "Input/RingBuffer.hpp"
+#include "Jobs/DeferredActions.hpp"
 #include "Level/Level.hpp"
+#include "Network/NetTransport.hpp"
+#include "Network/RollbackSession.hpp"
+#include "Network/SpectatorClient.hpp"
+#include "Network/SpectatorServer.hpp"
 #include "Render/RenderManager.hpp"
+#include "Render/RenderSnapshot.hpp"
+#include "Render/SnapshotBuffer.hpp"
+#include "Replay/ReplayReader.hpp"
+#include "Replay/ReplayWriter.hpp"
 #include "Resources/ResourceHolder.hpp"
 #include "Resources/SpriteSheetMapHolder.hpp"
 #include "Screens/Screen.hpp"
+#include "Snapshot/WorldSnapshot.hpp"
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <SFML/Graphics.hpp>
 
 class MainGameScreen : public Screen
@@ -31,13 +47,52 @@ class MainGameScreen : public Screen
             std::string levelId;
             WorldObjectTypes player1Warrior;
             WorldObjectTypes player2Warrior;
+            // When set, the match of the replay file is simulated again and
+            // the other data is taken from the file
+            std::string replayFile;
 
             GameData(GameMode gameMode, std::string levelId, 
                     WorldObjectTypes player1Warrior, 
-                    WorldObjectTypes player2Warrior);
+                    WorldObjectTypes player2Warrior, 
+                    std::string replayFile = "");
         };
 
     private:
+        // Set by net_mode, only two player matches can be played over the 
+        // network
+        enum class NetMode
+        {
+            NONE,
+            // The host controls player 1, the client player 2
+            HOST,
+            CLIENT,
+            // Player 2 is controlled by a second session in this game, whose
+            // packets are delayed by the latency simulator
+            LOOPBACK
+        };
+
+        // The state of a simulation step, which is shown by the gui
+        struct HudState
+        {
+            bool isPlayer1InGame;
+            bool isPlayer2InGame;
+            float player1Health;
+            float player1Stanima;
+            float player2Health;
+            float player2Stanima;
+            bool hasCameraCenter;
+            // The camera center at the begin and the end of the step
+            sf::Vector2f lastCameraCenter;
+            sf::Vector2f cameraCenter;
+        };
+
+        // Passed from the simulation thread to the render thread
+        struct FrameState
+        {
+            RenderSnapshot scene;
+            HudState hud;
+        };
+
         bool m_showCollisionInfo;
         
         sf::RenderWindow &m_window;
@@ -65,9 +120,103 @@ class MainGameScreen : public Screen
         // Warriors which are in the game
         std::vector<Warrior*> m_possibleTargetWarriors;
            
-        QueueHelper<Command> m_commandQueue;
+        // Filled while handling the inputs, drained by the simulation
+        RingBuffer<Command, 1024> m_commandQueue;
+        // Finds the collisions between the SceneNodes of the scene graph
+        CollisionWorld m_collisionWorld;
+        // Resolves the contacts between warriors and with the level
+        ContactSolver m_contactSolver;
+        // Update the top level nodes of the scene on the threads of the job
+        // system
+        bool m_isParallelUpdateOn;
+        // Changes of the scene graph during the parallel update
+        DeferredActions m_deferredActions;
+        // The indices of the children of the root, which are updated in
+        // parallel
+        std::vector<std::size_t> m_parallelChildren;
+
+        // Run the simulation on its own thread with a fixed step, while this
+        // thread draws the snapshots of the steps
+        const bool m_isPipelined;
+        const float m_simStepTime;
+        std::thread m_simThread;
+        // Held by the simulation thread during a step, the other thread has
+        // to lock it to change the simulation (e.g. to add commands)
+        std::mutex m_simMutex;
+        std::mutex m_simTimeMutex;
+        std::condition_variable m_simTimeCondition;
+        // The time which the simulation has to catch up
+        float m_simTimeBudget;
+        bool m_isSimStopping;
+        SnapshotBuffer<FrameState> m_frameBuffer;
+        // How far the shown snapshot is interpolated
+        float m_snapshotInterpolation;
+        // Only used by the thread which runs the simulation
+        sf::Vector2f m_cameraCenter;
+        // The hud state which is shown, the camera is placed by it
+        HudState m_shownHud;
+        // Used to interpolate the scene between the last two updates, when
+        // the simulation runs on this thread
+        RenderSnapshot m_renderSnapshot;
+
+        // Records the commands of the match (When record_replay is set)
+        ReplayWriter m_replayWriter;
+        // The match is replayed from the file of the game data
+        bool m_isReplay;
+        bool m_isReplayDone;
+        ReplayReader m_replayReader;
+        // The step which is currently replayed
+        ReplayReader::Tick m_replayTick;
+        // The number of simulated steps of the match
+        std::uint64_t m_simStep;
+        // Filled by the console command SNAPSHOT SAVE
+        WorldSnapshot m_quickSave;
+
+        // Rollback networking, the simulation runs with the fixed step and 
+        // steps are simulated again, when the remote commands were predicted
+        // wrong
+        const NetMode m_netMode;
+        WorldObjectTypes m_localPlayer;
+        std::unique_ptr<NetTransport> m_netTransport;
+        std::unique_ptr<RollbackSession> m_netSession;
+        // Sends the commands of player 2 in loopback mode
+        std::unique_ptr<NetTransport> m_loopbackTransport;
+        std::unique_ptr<RollbackSession> m_loopbackSession;
+        // The number of steps which can be predicted, before the game waits
+        // for the remote commands
+        std::uint64_t m_maxRollback;
+        // The states before the last steps, indexed by the step
+        std::vector<WorldSnapshot> m_rollbackSnapshots;
+        float m_netTimeBudget;
+        // The commands of the simulated step (Local and remote)
+        std::vector<Command> m_netCommands;
+        std::vector<Command> m_localCommands;
+        std::vector<Command> m_loopbackCommands;
+
+        // Streams the match to the spectators (spectator_mode=server)
+        std::unique_ptr<SpectatorServer> m_spectatorServer;
+        // Shows the match of a server instead of simulating it
+        // (spectator_mode=viewer)
+        std::unique_ptr<SpectatorClient> m_spectatorClient;
+        // The time between two streamed states
+        float m_spectatorInterval;
+        // The viewer shows the match this time in the past, so it can
+        // interpolate between the received states
+        float m_spectatorDelay;
+        // The time of the match, the streamed states are stamped with it
+        double m_matchTime;
+        double m_lastSpectatorTime;
+        std::vector<SceneNode*> m_spectatorScratch;
+        std::vector<SpectatorClient::ViewEntity> m_spectatorView;
+        // The nodes of the viewer with the ids of the nodes on the server
+        std::vector<std::pair<unsigned int, SceneNode*>> m_spectatorNodes;
 
         sf::FloatRect m_worldBounds;
+        // Compiled once per match, so creating a warrior (also by a restore)
+        // doesnt read the config files
+        WarriorArchetype m_knightArchetype;
+        WarriorArchetype m_runnerArchetype;
+        WarriorArchetype m_wizardArchetype;
         Warrior *m_warriorPlayer1;
         Warrior *m_warriorPlayer2;
 
@@ -88,8 +237,17 @@ class MainGameScreen : public Screen
         //void controlWorldEntities();
         void handleCommands(float dt);
         virtual bool update(float dt);
+        // Run one step of the game logic
+        void simulate(float dt);
+        // Update the nodes of the scene graph, serial or in parallel
+        void updateSceneGraph(float dt);
 
         void handleCollision(float dt);
+        // Save the state of the match, has to be called between two steps
+        // (When the simulation runs on its own thread, it has to be locked)
+        void saveSnapshot(WorldSnapshot &snapshot);
+        // Returns false, when not the complete state could be restored
+        bool restoreSnapshot(WorldSnapshot &snapshot);
 
         virtual void render();
     
@@ -98,19 +256,85 @@ class MainGameScreen : public Screen
         void loadInputDeviceData();
         InputDevice stringToInputDevice();
         // Create a warrior of the given type
-        std::unique_ptr<Warrior> createWarrior(WorldObjectTypes warriorType);
+        NodePtr<Warrior> createWarrior(WorldObjectTypes warriorType);
         void buildGuiElements();
         void buildLevel();
         
-        SceneNode* getSceneNodeOfType(SceneNode::Pair sceneNodePair, 
-                WorldObjectTypes type);
-        bool matchesCategories(SceneNode::Pair &colliders, unsigned int type1, 
-                unsigned int type2);
+        // Set which collision layers interact and their handlers
+        void buildCollisionLayers();
+        // Remove the destroyed nodes from the scene graph, the collision world
+        // and the targets of the warriors
+        void removeDestroyedNodes();
+        // Create the nodes of a restored snapshot, which dont exist anymore
+        SceneNode::Ptr createSnapshotNode(unsigned int types, 
+                SceneNode *spawner);
+        // Save and restore the match the given times and report the size 
+        // and the times
+        std::string runSnapshotBenchmark(std::size_t rounds);
+        // Stop the fast moving nodes at the point where they hit an obstacle
+        void handleSweepHits(
+                const std::vector<CollisionWorld::SweepHit> &sweepHits);
         void resolveEntityCollisions(SceneNode *sceneNodeFirst, 
                 SceneNode *sceneNodeSecond, CollisionInfo &collisionInfo);
+        void handleWeaponHit(SceneNode *weaponNode, SceneNode *warriorNode, 
+                CollisionInfo &collisionInfo);
+        void handleLevelContact(SceneNode *warriorNode, SceneNode *levelNode, 
+                CollisionInfo &collisionInfo);
+        void handleProjectileImpact(SceneNode *projectileNode, 
+                SceneNode *levelNode, CollisionInfo &collisionInfo);
         
-        void updateCamera(float dt);
+        // Give the simulation thread time and show its last snapshot
+        void updatePipelined(float dt);
+        void runSimulation();
+        void stopSimulationThread();
+        // Lock the simulation, when it runs on its own thread
+        std::unique_lock<std::mutex> lockSimulation();
+        void buildFrameState(FrameState &frameState);
+        void buildHudState(HudState &hud);
+        void applyHudState(const HudState &hud, float dt);
+        // Place the camera between the last two camera centers of the hud
+        void updateCamera(float interpolation);
+        // Draw the scene between the last two updates
+        void drawScene(sf::RenderTarget &target, float interpolation);
+        // Returns false, when there is no warrior to follow
+        bool getCameraCenter(sf::Vector2f &center) const;
+        // Open the replay of the game data or start recording the match
+        void setupReplay();
+        static NetMode readNetMode(const ConfigManager &config, 
+                const GameData &gameData);
+        // Open the transports and the sessions of the net mode
+        void setupNetwork();
+        // Simulate the steps of the passed time, when the remote commands 
+        // arrive in time
+        void updateNetwork(float dt);
+        // Returns false, when the game has to wait for the remote peer
+        bool advanceNetStep();
+        // Simulate the current step with the commands of the session
+        void simulateNetStep();
+        // Restore the state before the step and simulate the steps until the
+        // current step again
+        void rollback(std::uint64_t step);
+        static bool isSpectatorViewer(const ConfigManager &config);
+        // Start the server or connect the viewer
+        void setupSpectators();
+        // Send the warriors and projectiles to the spectators, when the 
+        // interval passed
+        void publishSpectatorState();
+        // Show the received match instead of simulating it
+        void updateSpectatorView(float dt);
+        // Move the nodes of the scene to the interpolated state, create the 
+        // missing ones and destroy the ones which are gone
+        void applySpectatorView();
+        SceneNode* findSpectatorNode(unsigned int serverId) const;
+        // Simulate all steps of the replay as fast as possible and compare 
+        // the states with the recorded ones
+        void runReplay();
+        // A hash of the warriors and the number of nodes, to find the step
+        // where a replay differs from the recorded match
+        std::uint32_t computeStateChecksum() const;
+        // Forget the players which were removed
         void handleWinner();
+        void showWinner(const HudState &hud);
 
         // Check if the player is still in game
         bool isStillPlayer1InGame();
@@ -4,7 +4,9 @@
 #include <memory>
 #include <map>
 #include "Components/Warrior.hpp"
+#include "Components/EntityStore.hpp"
 #include "Components/EnumWorldObjectTypes.hpp"
+#include "Components/NodeArena.hpp"
 #include "Components/SceneNode.hpp"
 #include "Config/ConfigManager.hpp"
 #include "Render/RenderManager.hpp"
@@ -16,6 +18,8 @@
 #include "Input/Command.hpp"
 
 
+class ConfigRegistry;
+class JobSystem;
 class MusicPlayer;
 class SoundPlayer;
 class ScreenStack;
@@ -28,6 +32,8 @@ class Screen : private sf::NonCopyable
         struct Context
         {
             ConfigManager *config;
+            // The other config files, each is only loaded once
+            ConfigRegistry *configRegistry;
             sf::RenderWindow *window;
             sf::View gameView;
             sf::View guiView;
@@ -40,8 +46,11 @@ class Screen : private sf::NonCopyable
             SoundPlayer *sound;
             // The color changing baclground
             sf::RectangleShape *background;
+            // Runs the jobs of the screens on the worker threads
+            JobSystem *jobSystem;
 
             Context(ConfigManager *config,
+                    ConfigRegistry *configRegistry,
                     sf::RenderWindow *window, 
                     ResourceHolder<sf::Font> *fontHolder,
                     ResourceHolder<sf::Texture> *textureHolder, 
@@ -50,7 +59,8 @@ class Screen : private sf::NonCopyable
                     LevelHolder *levelHolder,
                     MusicPlayer *music,
                     SoundPlayer *sound,
-                    sf::RectangleShape *background);
+                    sf::RectangleShape *background,
+                    JobSystem *jobSystem);
 
             Context();
         };
@@ -60,8 +70,17 @@ class Screen : private sf::NonCopyable
         Context &m_context;
         ScreenStack *m_screenStack;
 
+        // The entities of the scene graph. Has to be declared before the 
+        // scene graph, so the entities are removed before the store is gone
+        EntityStore m_entityStore;
+        // Has to be declared before the scene graph, so the nodes are destroyed
+        // before the arena releases their memory
+        NodeArena m_nodeArena;
         SceneNode m_sceneGraph;
         RenderManager m_renderManager;
+        // How far the rendered frame is between the last two updates (0 is 
+        // the state before the last update, 1 the state after it)
+        float m_renderInterpolation;
 
         //QueueHelper<Input> *m_inputQueue;
         //QueueHelper<Command> m_commandQueue;
@@ -76,6 +95,7 @@ class Screen : private sf::NonCopyable
         Context getContext();
         
         virtual void windowSizeChanged();
+        void setRenderInterpolation(float interpolation);
         // return false when no lower screen should handle the input
         virtual bool handleInput(Input &input, float dt);
         virtual bool handleEvent(sf::Event &event, float dt);
@@ -67,6 +67,8 @@ class ScreenStack : private sf::NonCopyable
         
         // Called when the window size changed
         void windowSizeChanged();
+        // Set how far the next rendered frame is between the last two updates
+        void setRenderInterpolation(float interpolation);
     private:
         Screen::Ptr createScreen(ScreenID screenID);
         // With this method we can change the stack safety.
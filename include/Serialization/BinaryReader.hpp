@@ -0,0 +1,45 @@
+#ifndef BINARYREADER_HPP
+#define BINARYREADER_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Reads the values written by the BinaryWriter from a byte buffer, which has
+ * to stay valid while reading. 
+ * Reading behind the end of the buffer doesnt throw, the reader becomes 
+ * invalid and returns 0 for all following values. So the data can be read
+ * completely and is only checked once with isValid().
+ */
+class BinaryReader
+{
+    private:
+        const char *m_data;
+        std::size_t m_size;
+        std::size_t m_pos;
+        bool m_isValid;
+
+    public:
+        BinaryReader(const char *data, std::size_t size);
+
+        std::uint8_t readUInt8();
+        std::uint16_t readUInt16();
+        std::uint32_t readUInt32();
+        std::uint64_t readUInt64();
+        std::uint64_t readVarUInt();
+        std::int64_t readVarInt();
+        float readFloat();
+        bool readBool();
+        std::string readString();
+        // Returns false when there are not enough bytes left
+        bool readBytes(char *data, std::size_t size);
+        // Skip the bytes without reading them, returns false when there are 
+        // not enough bytes left
+        bool skipBytes(std::size_t size);
+
+        bool isValid() const;
+        bool isAtEnd() const;
+        std::size_t getPosition() const;
+        std::size_t getRemainingSize() const;
+};
+
+#endif // BINARYREADER_HPP
@@ -0,0 +1,38 @@
+#ifndef BINARYWRITER_HPP
+#define BINARYWRITER_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Appends values in a compact little endian format to a byte buffer, so the
+ * files and packets are the same on every platform. Unsigned integers can be
+ * written as variable length integers, which need one byte below 128.
+ * The buffer keeps its memory when it is cleared.
+ */
+class BinaryWriter
+{
+    private:
+        std::vector<char> m_buffer;
+
+    public:
+        void writeUInt8(std::uint8_t value);
+        void writeUInt16(std::uint16_t value);
+        void writeUInt32(std::uint32_t value);
+        void writeUInt64(std::uint64_t value);
+        void writeVarUInt(std::uint64_t value);
+        // Zigzag encoded, so small negative values are small too (e.g. deltas)
+        void writeVarInt(std::int64_t value);
+        void writeFloat(float value);
+        void writeBool(bool value);
+        // The length is written as variable length integer before the chars
+        void writeString(const std::string &value);
+        void writeBytes(const char *data, std::size_t size);
+
+        const std::vector<char>& getBuffer() const;
+        const char* getData() const;
+        std::size_t getSize() const;
+        void clear();
+};
+
+#endif // BINARYWRITER_HPP
@@ -0,0 +1,80 @@
+#ifndef WORLDSNAPSHOT_HPP
+#define WORLDSNAPSHOT_HPP
+#include "Components/SceneNode.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/* The complete state of a match in a compact versioned binary form: the
+ * random streams and every node of the scene graph (transform, values of the
+ * EntityStore, animations, attacks, hit ids, ...). It is the base for quick
+ * saves, rollbacks and the offline analysis of matches.
+ * The nodes are written in the order of the scene graph (parents before their
+ * children) and are identified by their node ids. A restore loads the states
+ * into the nodes which still exist, destroys the nodes which were created
+ * after the snapshot and creates the missing nodes (e.g. fireballs which
+ * already hit something or killed warriors) again with the node factory.
+ * The buffers keep their memory, so after the first snapshot saving and
+ * restoring dont allocate (except for the created nodes).
+ */
+class WorldSnapshot
+{
+    public:
+        // Create a node with the types of the saved node. The spawner is the
+        // node which spawned the saved node or nullptr. Returns nullptr, when
+        // the node cant be created
+        typedef std::function<SceneNode::Ptr(unsigned int types,
+                SceneNode *spawner)> NodeFactory;
+
+    private:
+        BinaryWriter m_writer;
+        // The state of the current node, it is added with its size to the
+        // snapshot, so a restore can skip nodes
+        BinaryWriter m_nodeWriter;
+        std::uint64_t m_step;
+        std::size_t m_nodeCnt;
+
+        // Only used while saving and restoring
+        std::vector<SceneNode*> m_nodes;
+        // The nodes of the scene graph sorted by their ids
+        std::vector<std::pair<unsigned int, SceneNode*>> m_nodesById;
+        std::vector<char> m_isNodeRestored;
+        // The saved ids of the nodes created by this restore
+        std::vector<std::pair<unsigned int, SceneNode*>> m_createdNodes;
+        // The saved ids and the ids of the nodes created by the restores of
+        // this data, so restoring it again (e.g. for a rollback) reuses them
+        std::vector<std::pair<unsigned int, unsigned int>> m_createdIds;
+        // The children of the last created node, which were created with it
+        std::vector<SceneNode*> m_createdSubtree;
+
+    public:
+        WorldSnapshot();
+
+        // Save the scene graph and the random streams, the step is the
+        // number of simulated steps of the match
+        void save(SceneNode &sceneGraph, std::uint64_t step);
+        // Returns false, when the data is invalid or not all nodes could be
+        // restored (The nodes which could be restored have the saved state)
+        bool restore(SceneNode &sceneGraph, const NodeFactory &nodeFactory);
+
+        // Replace the data, e.g. with a snapshot of a file. The data is only
+        // checked by restore()
+        void setData(const char *data, std::size_t size);
+        const char* getData() const;
+        std::size_t getSize() const;
+        bool isEmpty() const;
+        // The step of the last save() or restore()
+        std::uint64_t getStep() const;
+        std::size_t getNodeCnt() const;
+
+    private:
+        // Find a node by its id in the snapshot
+        SceneNode* findNode(unsigned int nodeId) const;
+        void markAsRestored(const SceneNode *node);
+        void addCreatedNode(unsigned int savedId, SceneNode *node);
+};
+
+#endif // WORLDSNAPSHOT_HPP
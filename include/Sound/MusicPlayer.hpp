@@ -2,23 +2,86 @@
 #define MUSICPLAYER_HPP
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+/* Plays the music with a few streams, which are opened on a loader thread, 
+ * so changing the track never waits for the file. When a track is played, 
+ * the tracks which will likely follow it (see setFollowUps()) are opened in 
+ * the background and the new track is crossfaded with the old one.
+ * A track which isnt opened yet starts, as soon as the loader opened it.
+ * The opened streams are kept, until their slot is needed for another track.
+ */
 class MusicPlayer : private sf::NonCopyable
 {
     private:
-        sf::Music m_music;
+        enum class StreamState
+        {
+            EMPTY,
+            // Opened by the loader thread, must not be touched by the others
+            LOADING,
+            READY,
+            PLAYING,
+            FADING_OUT,
+            FAILED
+        };
+
+        struct Stream
+        {
+            sf::Music music;
+            std::string id;
+            std::string fileName;
+            StreamState state;
+            // The volume of the crossfade (0 to 1)
+            float fade;
+            // The least recently used ready stream is replaced first
+            std::uint64_t lastUse;
+        };
+
+        static const std::size_t StreamCnt{ 4 };
+
+        Stream m_streams[StreamCnt];
         // Identifer, filename
         std::map<std::string, std::string> m_fileNames;
+        // The tracks which are opened, when the track is played
+        std::map<std::string, std::vector<std::string>> m_followUps;
+        // The current track, also when it is still loaded
         std::string m_currentPlayed;
+        Stream *m_current;
+        // Starts, when it is loaded
+        Stream *m_pending;
+        float m_fadeTime;
         float m_volume;
+        bool m_isPaused;
+        std::uint64_t m_useCnt;
+
+        std::thread m_loaderThread;
+        // Protects the states of the streams and the load queue
+        std::mutex m_mutex;
+        std::condition_variable m_loadCondition;
+        std::deque<Stream*> m_loadQueue;
+        bool m_isStopping;
 
     public:
         MusicPlayer();
+        ~MusicPlayer();
 
-        void play(const std::string &id);
-        void stop();
+        // Crossfade from the current track to the track in the fade time 
+        // (in seconds)
+        void play(const std::string &id, float fadeTime = 1.f);
+        // Fade out the current track
+        void stop(float fadeTime = 1.f);
+        // Open the track in the background, so it can be played immediately
+        void preload(const std::string &id);
+        // Has to be called every frame, starts the loaded tracks and fades
+        void update(float dt);
         // Returns an empty string (""), when nothing is played
         std::string getCurrentId() const;
 
@@ -27,6 +90,20 @@ class MusicPlayer : private sf::NonCopyable
         float getVolume() const;
 
         void add(const std::string &id, const std::string &fileName);
+        // Set the tracks which are preloaded, when the track is played (e.g.
+        // the game themes after the menu theme)
+        void setFollowUps(const std::string &id, 
+                const std::vector<std::string> &followUps);
+
+    private:
+        void runLoader();
+        // The mutex has to be locked by the following functions
+        // Find the stream of the track or start loading it. Returns nullptr 
+        // when all streams are in use
+        Stream* requestStream(const std::string &id);
+        Stream* findFreeStream();
+        void startStream(Stream &stream);
+        void applyVolume(Stream &stream);
 };
 
 #endif // MUSICPLAYER_HPP
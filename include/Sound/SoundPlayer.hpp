@@ -2,25 +2,111 @@
 #define SOUNDPLAYER_HPP
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "Resources/ResourceHolder.hpp"
 
+/* Plays the sound effects with a fixed pool of voices, so a busy match 
+ * cant create more sounds than the audio device has sources.
+ * Every sound has a priority and a maximum number of instances. When the 
+ * sound already plays that often, its oldest instance is restarted. When all
+ * voices play, the voice with the lowest priority (then the quietest, then 
+ * the oldest) is stolen, but only from sounds with the same or a lower 
+ * priority. The same sound is only started once per frame.
+ * Sounds with a position are attenuated and panned relative to the listener
+ * (the camera center) and are not started at all, when they are out of the
+ * audible range.
+ */
 class SoundPlayer : private sf::NonCopyable
 {
+    public:
+        static const std::size_t VoiceCnt{ 32 };
+
     private:
+        // Published as profiler counters by update()
+        struct Stats
+        {
+            std::size_t activeVoices;
+            std::uint64_t playedSounds;
+            // Not started, because the sound was started in the same frame
+            std::uint64_t coalescedSounds;
+            std::uint64_t stolenVoices;
+            // Not started, because all voices played more important sounds
+            std::uint64_t droppedSounds;
+            // Not started, because they were out of the audible range
+            std::uint64_t culledSounds;
+        };
+
+        struct SoundInfo
+        {
+            const sf::SoundBuffer *buffer;
+            int priority;
+            std::size_t maxInstances;
+            // The frame where the sound was started the last time
+            std::uint64_t lastPlayFrame;
+        };
+
+        struct Voice
+        {
+            sf::Sound sound;
+            // The index of the played sound info
+            std::size_t soundIndex;
+            int priority;
+            // Increased for every started voice, used to find the oldest one
+            std::uint64_t startOrder;
+            // The attenuation by the distance (0 to 1)
+            float gain;
+        };
+
         ResourceHolder<sf::SoundBuffer> m_soundHolder;
-        std::list<sf::Sound> m_sounds;
+        std::vector<SoundInfo> m_soundInfos;
+        std::map<std::string, std::size_t> m_soundIndices;
+        // Created once, the voices are reused
+        std::vector<Voice> m_voices;
+        std::uint64_t m_frame;
+        std::uint64_t m_startOrder;
+        Stats m_stats;
         float m_volume;
+        sf::Vector2f m_listenerPosition;
+        // Sounds are attenuated from the quarter of the range and cant be 
+        // heard at the range
+        float m_audibleRange;
+        // No sounds are started, e.g. while the steps of a rollback are 
+        // simulated again
+        bool m_isMuted;
+        // The sounds can be played by the simulation thread
+        mutable std::mutex m_mutex;
 
     public:
         SoundPlayer();
         
-        void load(const std::string &id, const std::string file);
+        // Sounds with a higher priority can steal the voices of sounds with a
+        // lower priority
+        void load(const std::string &id, const std::string file, 
+                int priority = 0, std::size_t maxInstances = 4);
         void play(const std::string &id);
-        void removeStoppedSounds();
+        // Play the sound at the position in the world
+        void play(const std::string &id, sf::Vector2f position);
+        // Has to be called once per frame, counts the active voices and 
+        // publishes the stats as profiler counters
+        void update();
         void setVolume(float volume);
         float getVolume() const;
+        void setIsMuted(bool isMuted);
+        bool isMuted() const;
+        // Set where the positional sounds are heard (e.g. the camera center)
+        void setListener(sf::Vector2f position, float audibleRange);
+
+    private:
+        // The pan is the direction of the sound from left (-1) to right (1)
+        void start(const std::string &id, float gain, float pan);
+        // Get a voice for the sound or nullptr, when no voice can be used
+        Voice* findVoice(std::size_t soundIndex);
+        bool isActive(const Voice &voice) const;
 };
 
 #endif // SOUNDPLAYER_HPP
@@ -3,6 +3,8 @@
 #include "Calc.hpp"
 #include <cmath>
 #include "Components/SceneNode.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 
 Animation::Animation(SceneNode *parent, bool repeat)
 : m_repeat{ repeat }
@@ -208,6 +210,40 @@ void Animation::stop()
     }
 }
 
+void Animation::saveState(BinaryWriter &writer) const
+{
+    writer.writeBool(m_isRotationRunning);
+    writer.writeBool(m_isMovementRunning);
+    writer.writeVarUInt(m_actualRotationStep);
+    writer.writeFloat(m_rotated);
+    writer.writeVarUInt(m_actualMovementStep);
+    writer.writeFloat(m_moved);
+    writer.writeFloat(m_pastStartTime);
+}
+
+void Animation::loadState(BinaryReader &reader)
+{
+    m_isRotationRunning = reader.readBool();
+    m_isMovementRunning = reader.readBool();
+    m_actualRotationStep = reader.readVarUInt();
+    m_rotated = reader.readFloat();
+    m_actualMovementStep = reader.readVarUInt();
+    m_moved = reader.readFloat();
+    m_pastStartTime = reader.readFloat();
+    // A snapshot of another version of the animation could point behind the
+    // steps
+    if (m_actualRotationStep >= m_rotationSteps.size())
+    {
+        m_actualRotationStep = 0;
+        m_isRotationRunning = false;
+    }
+    if (m_actualMovementStep >= m_movementSteps.size())
+    {
+        m_actualMovementStep = 0;
+        m_isMovementRunning = false;
+    }
+}
+
 void Animation::setOnAnimationStartedListener(std::function<void()> listener)
 {
     m_onAnimationStarted = listener;
@@ -0,0 +1,158 @@
+#include "Collision/CollisionBenchmark.hpp"
+#include "Collision/CollisionHandler.hpp"
+#include "Collision/CollisionRect.hpp"
+#include "Collision/CollisionWorld.hpp"
+#include <chrono>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    typedef std::chrono::steady_clock BenchClock;
+
+    std::vector<std::unique_ptr<CollisionRect>> createRandomRects(
+            std::size_t rectCnt)
+    {
+        // Fixed seed, so every run tests the same rects
+        std::mt19937 mt(42);
+        std::uniform_real_distribution<float> posDist(0.f, 300.f);
+        std::uniform_real_distribution<float> sizeDist(10.f, 60.f);
+        std::uniform_real_distribution<float> rotDist(0.f, 360.f);
+        std::vector<std::unique_ptr<CollisionRect>> rects;
+        for (std::size_t i{ 0 }; i < rectCnt; i++)
+        {
+            std::unique_ptr<CollisionRect> rect{ new CollisionRect(
+                    { sizeDist(mt), sizeDist(mt) }) };
+            rect->setPosition(posDist(mt), posDist(mt));
+            rect->setRotation(rotDist(mt));
+            rects.push_back(std::move(rect));
+        }
+        return rects;
+    }
+
+    // Run the test for all pairs and return the time in milliseconds
+    template<typename Test>
+    double measure(std::vector<std::unique_ptr<CollisionRect>> &rects, 
+            std::size_t rounds, Test test, std::size_t &collisionCnt)
+    {
+        collisionCnt = 0;
+        BenchClock::time_point start{ BenchClock::now() };
+        for (std::size_t round{ 0 }; round < rounds; round++)
+        {
+            // Every round is a new frame, so the cached boxes are recomputed 
+            // like in the game
+            CollisionShape::collisionFrame++;
+            for (std::size_t i{ 0 }; i < rects.size(); i++)
+            {
+                for (std::size_t j{ i + 1 }; j < rects.size(); j++)
+                {
+                    if (test(*rects[i], *rects[j]).isCollision())
+                    {
+                        collisionCnt++;
+                    }
+                }
+            }
+        }
+        std::chrono::duration<double, std::milli> time{ 
+            BenchClock::now() - start };
+        return time.count();
+    }
+
+    // Run the query for all points and return the queries per second
+    template<typename Query>
+    double measureQueries(const std::vector<sf::Vector2f> &points, 
+            Query query, std::size_t &hitCnt)
+    {
+        hitCnt = 0;
+        BenchClock::time_point start{ BenchClock::now() };
+        for (std::size_t i{ 0 }; i + 1 < points.size(); i += 2)
+        {
+            if (query(points[i], points[i + 1]))
+            {
+                hitCnt++;
+            }
+        }
+        std::chrono::duration<double> time{ BenchClock::now() - start };
+        return time.count() > 0.0 ? (points.size() / 2) / time.count() : 0.0;
+    }
+}
+
+std::string CollisionBenchmark::runRectRect(std::size_t rounds)
+{
+    std::vector<std::unique_ptr<CollisionRect>> rects{ createRandomRects(64) };
+    std::size_t collisionCntBox{ 0 };
+    std::size_t collisionCntVertices{ 0 };
+    double timeBox{ measure(rects, rounds, 
+            [] (CollisionRect &a, CollisionRect &b) 
+            { 
+                return CollisionHandler::isColliding(a, b); 
+            }, collisionCntBox) };
+    double timeVertices{ measure(rects, rounds, 
+            [] (CollisionRect &a, CollisionRect &b) 
+            { 
+                return CollisionHandler::isCollidingVerticesSAT(a, b); 
+            }, collisionCntVertices) };
+    return "Rect-Rect " + std::to_string(rounds) + " rounds: oriented box " + 
+        std::to_string(timeBox) + " ms, vertices " + 
+        std::to_string(timeVertices) + " ms, speedup " + 
+        std::to_string(timeVertices / timeBox) + "x, collisions " + 
+        std::to_string(collisionCntBox) + "/" + 
+        std::to_string(collisionCntVertices);
+}
+
+std::string CollisionBenchmark::runRaycast(const CollisionWorld &world, 
+        sf::FloatRect area, std::size_t rounds)
+{
+    // Fixed seed, so every run casts the same segments
+    std::mt19937 mt(42);
+    std::uniform_real_distribution<float> xDist(area.left, 
+            area.left + area.width);
+    std::uniform_real_distribution<float> yDist(area.top, 
+            area.top + area.height);
+    std::vector<sf::Vector2f> points;
+    for (std::size_t i{ 0 }; i < rounds * 2; i++)
+    {
+        points.push_back({ xDist(mt), yDist(mt) });
+    }
+    const unsigned int LevelMask{ 
+        CollisionLayerMatrix::getLayerMask(CollisionLayers::LEVEL) };
+    std::size_t hitCntLevel{ 0 };
+    std::size_t hitCntAll{ 0 };
+    std::size_t hitCntCircle{ 0 };
+    std::size_t hitCntArea{ 0 };
+    CollisionWorld::RayHit hit;
+    std::vector<SceneNode*> nodes;
+    const double QueriesLevel{ measureQueries(points, 
+            [&] (sf::Vector2f from, sf::Vector2f to)
+            {
+                return world.segmentCast(from, to, hit, LevelMask);
+            }, hitCntLevel) };
+    const double QueriesAll{ measureQueries(points, 
+            [&] (sf::Vector2f from, sf::Vector2f to)
+            {
+                return world.segmentCast(from, to, hit);
+            }, hitCntAll) };
+    const double QueriesCircle{ measureQueries(points, 
+            [&] (sf::Vector2f from, sf::Vector2f to)
+            {
+                return world.circleCast(from, to, 10.f, hit);
+            }, hitCntCircle) };
+    const double QueriesArea{ measureQueries(points, 
+            [&] (sf::Vector2f from, sf::Vector2f to)
+            {
+                nodes.clear();
+                world.queryArea({ from, { 100.f, 100.f } }, nodes);
+                return !nodes.empty();
+            }, hitCntArea) };
+    return "Queries/s with " + std::to_string(rounds) + " rounds: segment level " + 
+        std::to_string(static_cast<long>(QueriesLevel)) + " (" + 
+        std::to_string(hitCntLevel) + " hits), segment all " + 
+        std::to_string(static_cast<long>(QueriesAll)) + " (" + 
+        std::to_string(hitCntAll) + " hits), circle " + 
+        std::to_string(static_cast<long>(QueriesCircle)) + " (" + 
+        std::to_string(hitCntCircle) + " hits), area " + 
+        std::to_string(static_cast<long>(QueriesArea)) + " (" + 
+        std::to_string(hitCntArea) + " hits)";
+}
@@ -24,6 +24,11 @@ void CollisionCircle::draw(sf::RenderTarget &target, sf::RenderStates states) co
     }
 }
 
+CollisionShapeTypes CollisionCircle::getShapeType() const
+{
+    return CollisionShapeTypes::CIRCLE;
+}
+
 CollisionInfo CollisionCircle::isColliding(CollisionShape &collider)
 {
     return collider.isColliding(*this);
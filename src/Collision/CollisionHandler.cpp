@@ -71,11 +71,62 @@ bool CollisionHandler::isColliding(CollisionRect &objA, CollisionRect &objB)
 }
 */
 
-// SAT algorithm
 CollisionInfo CollisionHandler::isColliding(CollisionRect &objA, CollisionRect &objB)
 {
-    objA.computeVertices();
-    objB.computeVertices();
+    int separatingAxis{ -1 };
+    return isColliding(objA, objB, separatingAxis);
+}
+
+// SAT algorithm with oriented boxes
+CollisionInfo CollisionHandler::isColliding(CollisionRect &objA, CollisionRect &objB,
+        int &separatingAxis)
+{
+    const OrientedBox &BoxA{ objA.getOrientedBox() };
+    const OrientedBox &BoxB{ objB.getOrientedBox() };
+    const sf::Vector2f DirVecAB{ BoxB.center - BoxA.center };
+    // The edges of rects are parallel to its axes, so only these 4 axes have to
+    // be tested (The other 4 edges of the rects are parallel to them)
+    const sf::Vector2f Axises[4]{ 
+        BoxA.axisX, BoxA.axisY, BoxB.axisX, BoxB.axisY };
+    // Start with the axis which separated the rects the last time
+    const int FirstAxis{ separatingAxis >= 0 && separatingAxis < 4 ? 
+        separatingAxis : 0 };
+    // Used provide collision information
+    // Use as standart an overlapwhich is to high that it cant occur in the game
+    float overlap = { 99999.f };
+    sf::Vector2f collisionAxis;
+    for (int i{ 0 }; i < 4; i++)
+    {
+        const int AxisIndex{ (FirstAxis + i) % 4 };
+        const sf::Vector2f &Axis{ Axises[AxisIndex] };
+        // The projections of the boxes are intervals around the projected 
+        // centers, so the overlap is the sum of the radii minus the distance
+        // of the centers on the axis
+        const float Distance{ std::abs(Calc::getVec2Scalar(DirVecAB, Axis)) };
+        const float OverlapTmp{ BoxA.getProjectionRadius(Axis) + 
+            BoxB.getProjectionRadius(Axis) - Distance };
+        // The projections are not intersecting, so we can seperate the shapes
+        if (OverlapTmp <= 0.f)
+        {
+            separatingAxis = AxisIndex;
+            return CollisionInfo(false);
+        }
+        if (OverlapTmp < overlap)
+        {
+            overlap = OverlapTmp;
+            collisionAxis = Axis;
+        }
+    }
+    separatingAxis = -1;
+    return createSATCollisionInfo(objA, objB, DirVecAB, overlap, collisionAxis);
+}
+
+// SAT algorithm over the vertices
+CollisionInfo CollisionHandler::isCollidingVerticesSAT(CollisionRect &objA, 
+        CollisionRect &objB)
+{
+    objA.computeVerticesReference();
+    objB.computeVerticesReference();
     std::vector<sf::Vector2f> verticesA = { objA.getVertices() };
     std::vector<sf::Vector2f> verticesB = { objB.getVertices() };
     // Store the axises to test
@@ -128,6 +179,16 @@ CollisionInfo CollisionHandler::isColliding(CollisionRect &objA, CollisionRect &
     }
     const sf::Vector2f dirVecAB{ 
         objB.getWorldPosition() - objA.getWorldPosition() };
+    // If we were not able to create a seperate axis between the two shapes after 
+    // testing all axis there have to be an intersection
+    return createSATCollisionInfo(objA, objB, dirVecAB, overlap, collisionAxis);
+}
+
+// SAT
+CollisionInfo CollisionHandler::createSATCollisionInfo(CollisionShape &objA, 
+        CollisionShape &objB, sf::Vector2f dirVecAB, float overlap, 
+        sf::Vector2f collisionAxis)
+{
     sf::Vector2f directionA;
     sf::Vector2f directionB;
     // Angle is bigger then 90 degrees, vectors are not in the same direction.
@@ -145,9 +206,6 @@ CollisionInfo CollisionHandler::isColliding(CollisionRect &objA, CollisionRect &
         directionA = -collisionAxis;
         directionB = collisionAxis;
     }
-
-    // If we were not able to create a seperate axis between the two shapes after 
-    // testing all axis there have to be an intersection
     return CollisionInfo(true, overlap, directionA, directionB, objA.getParent(), 
             objB.getParent());
 }
@@ -208,6 +266,198 @@ CollisionInfo CollisionHandler::isColliding(CollisionRect &objA, CollisionCircle
     return CollisionHandler::isColliding(objB, objA);;
 }
 
+// Ray cast of the circles center against the rect, which is enlarged by the
+// radius of the circle (At the corners the enlarged rect is a bit bigger than 
+// the real rounded shape, so the circle stops a bit earlier there)
+bool CollisionHandler::sweep(CollisionCircle &moving, sf::Vector2f displacement,
+        CollisionRect &obstacle, float &timeOfImpact)
+{
+    const OrientedBox &Box{ obstacle.getOrientedBox() };
+    const float Radius{ moving.getRadius() };
+    const sf::Vector2f StartWorld{ 
+        moving.getWorldPosition() - displacement - Box.center };
+    // Work in the local coordinate system of the rect, where it is axis aligned
+    const float Start[2]{ Calc::getVec2Scalar(StartWorld, Box.axisX), 
+        Calc::getVec2Scalar(StartWorld, Box.axisY) };
+    const float Dir[2]{ Calc::getVec2Scalar(displacement, Box.axisX), 
+        Calc::getVec2Scalar(displacement, Box.axisY) };
+    const float HalfExtents[2]{ 
+        Box.halfExtents.x + Radius, Box.halfExtents.y + Radius };
+    float enter{ 0.f };
+    float exit{ 1.f };
+    bool isStartInside{ true };
+    for (int axis{ 0 }; axis < 2; axis++)
+    {
+        if (std::abs(Start[axis]) >= HalfExtents[axis])
+        {
+            isStartInside = false;
+        }
+        if (Dir[axis] == 0.f)
+        {
+            // Moving parallel to the slab and outside of it, so no hit
+            if (std::abs(Start[axis]) >= HalfExtents[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        float slabEnter{ (-HalfExtents[axis] - Start[axis]) / Dir[axis] };
+        float slabExit{ (HalfExtents[axis] - Start[axis]) / Dir[axis] };
+        if (slabEnter > slabExit)
+        {
+            std::swap(slabEnter, slabExit);
+        }
+        enter = std::max(enter, slabEnter);
+        exit = std::min(exit, slabExit);
+        if (enter > exit)
+        {
+            return false;
+        }
+    }
+    if (isStartInside)
+    {
+        return false;
+    }
+    timeOfImpact = enter;
+    return true;
+}
+
+// Swept SAT: For every axis the time interval is determined in which the
+// projections overlap. The shapes collide in the intersection of all intervals
+bool CollisionHandler::sweep(CollisionRect &moving, sf::Vector2f displacement,
+        CollisionRect &obstacle, float &timeOfImpact)
+{
+    const OrientedBox &BoxA{ moving.getOrientedBox() };
+    const OrientedBox &BoxB{ obstacle.getOrientedBox() };
+    const sf::Vector2f DistVec{ BoxB.center - (BoxA.center - displacement) };
+    const sf::Vector2f Axises[4]{ 
+        BoxA.axisX, BoxA.axisY, BoxB.axisX, BoxB.axisY };
+    float enter{ -1.f };
+    float exit{ 1.f };
+    for (const sf::Vector2f &Axis : Axises)
+    {
+        const float Distance{ Calc::getVec2Scalar(DistVec, Axis) };
+        const float RadiusSum{ BoxA.getProjectionRadius(Axis) + 
+            BoxB.getProjectionRadius(Axis) };
+        const float Velocity{ Calc::getVec2Scalar(displacement, Axis) };
+        if (Velocity == 0.f)
+        {
+            if (std::abs(Distance) >= RadiusSum)
+            {
+                return false;
+            }
+            continue;
+        }
+        float axisEnter{ (Distance - RadiusSum) / Velocity };
+        float axisExit{ (Distance + RadiusSum) / Velocity };
+        if (axisEnter > axisExit)
+        {
+            std::swap(axisEnter, axisExit);
+        }
+        enter = std::max(enter, axisEnter);
+        exit = std::min(exit, axisExit);
+        if (enter > exit)
+        {
+            return false;
+        }
+    }
+    if (enter < 0.f)
+    {
+        return false;
+    }
+    timeOfImpact = enter;
+    return true;
+}
+
+// Slab test in the local coordinate system of the box
+bool CollisionHandler::raycast(const OrientedBox &box, float inflation, 
+        sf::Vector2f origin, sf::Vector2f direction, float maxDistance, 
+        float &distance, sf::Vector2f &normal)
+{
+    const sf::Vector2f OriginWorld{ origin - box.center };
+    const sf::Vector2f Axises[2]{ box.axisX, box.axisY };
+    const float Start[2]{ Calc::getVec2Scalar(OriginWorld, box.axisX), 
+        Calc::getVec2Scalar(OriginWorld, box.axisY) };
+    const float Dir[2]{ Calc::getVec2Scalar(direction, box.axisX), 
+        Calc::getVec2Scalar(direction, box.axisY) };
+    const float HalfExtents[2]{ 
+        box.halfExtents.x + inflation, box.halfExtents.y + inflation };
+    float enter{ 0.f };
+    float exit{ maxDistance };
+    // The axis of the slab which was entered last, -1 when the ray starts 
+    // inside of the box
+    int enterAxis{ -1 };
+    for (int axis{ 0 }; axis < 2; axis++)
+    {
+        if (Dir[axis] == 0.f)
+        {
+            if (std::abs(Start[axis]) > HalfExtents[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        float slabEnter{ (-HalfExtents[axis] - Start[axis]) / Dir[axis] };
+        float slabExit{ (HalfExtents[axis] - Start[axis]) / Dir[axis] };
+        if (slabEnter > slabExit)
+        {
+            std::swap(slabEnter, slabExit);
+        }
+        if (slabEnter > enter)
+        {
+            enter = slabEnter;
+            enterAxis = axis;
+        }
+        exit = std::min(exit, slabExit);
+        if (enter > exit)
+        {
+            return false;
+        }
+    }
+    distance = enter;
+    if (enterAxis < 0)
+    {
+        normal = -direction;
+    }
+    else
+    {
+        // The ray enters the slab on the side facing against its direction
+        normal = Dir[enterAxis] > 0.f ? 
+            -Axises[enterAxis] : Axises[enterAxis];
+    }
+    return true;
+}
+
+bool CollisionHandler::raycast(sf::Vector2f center, float radius, 
+        sf::Vector2f origin, sf::Vector2f direction, float maxDistance, 
+        float &distance, sf::Vector2f &normal)
+{
+    const sf::Vector2f ToOrigin{ origin - center };
+    const float C{ Calc::getVec2Scalar(ToOrigin, ToOrigin) - radius * radius };
+    if (C <= 0.f)
+    {
+        distance = 0.f;
+        normal = -direction;
+        return true;
+    }
+    // Solve |ToOrigin + t * direction| = radius
+    const float B{ Calc::getVec2Scalar(ToOrigin, direction) };
+    const float Discriminant{ B * B - C };
+    // The ray points away from the circle or misses it
+    if (B > 0.f || Discriminant < 0.f)
+    {
+        return false;
+    }
+    const float Distance{ -B - std::sqrt(Discriminant) };
+    if (Distance > maxDistance)
+    {
+        return false;
+    }
+    distance = Distance;
+    normal = Calc::normalizeVec2(ToOrigin + direction * Distance);
+    return true;
+}
+
 // SAT
 std::pair<float, float> CollisionHandler::getProjectionSAT(sf::Vector2f axis, 
         const std::vector<sf::Vector2f> &vertices)
@@ -268,7 +518,7 @@ bool CollisionHandler::areAxisProjectionsIntersectingSAT(
     const float MinA = { ProjectionA.first };
     const float MaxA = { ProjectionA.second };
     const float MinB = { ProjectionB.first };
-    const float MaxB = { ProjectionA.second };
+    const float MaxB = { ProjectionB.second };
     // Check if the projections are intersecting, when not the shapes qare not 
     // colliding because we can seperate the two shapes
     if ( (MinA < MaxB && MaxA < MinB) || (MinB < MaxA && MaxB < MinA) )
@@ -287,7 +537,7 @@ float CollisionHandler::getOverlapSAT(const std::pair<float, float> ProjectionA,
         const float MinA = { ProjectionA.first };
         const float MaxA = { ProjectionA.second };
         const float MinB = { ProjectionB.first };
-        const float MaxB = { ProjectionA.second };
+        const float MaxB = { ProjectionB.second };
         return std::min(MaxA, MaxB) - std::max(MinA, MinB);
     }
     return 0.f;
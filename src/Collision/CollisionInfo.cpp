@@ -8,6 +8,7 @@ CollisionInfo::CollisionInfo(const bool isCollision)
 , m_resolveDirSecond{ 0.f, 0.f }
 , m_collidedFirst{ nullptr }
 , m_collidedSecond { nullptr }
+, m_contactState{ ContactStates::NONE }
 {
 
 }
@@ -21,6 +22,7 @@ CollisionInfo::CollisionInfo(const bool isCollision, const float length, const s
 , m_resolveDirSecond{ resolveDirSecond }
 , m_collidedFirst{ collidedFirst }
 , m_collidedSecond{ collidedSecond }
+, m_contactState{ ContactStates::NONE }
 {
 
 }
@@ -54,3 +56,13 @@ SceneNode* CollisionInfo::getCollidedSecond() const
 {
     return m_collidedSecond;
 }
+
+ContactStates CollisionInfo::getContactState() const
+{
+    return m_contactState;
+}
+
+void CollisionInfo::setContactState(ContactStates contactState)
+{
+    m_contactState = contactState;
+}
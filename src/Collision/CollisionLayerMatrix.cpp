@@ -0,0 +1,114 @@
+#include "Collision/CollisionLayerMatrix.hpp"
+#include "Components/EnumWorldObjectTypes.hpp"
+#include "Components/SceneNode.hpp"
+
+CollisionLayerMatrix::CollisionLayerMatrix()
+{
+    for (std::size_t i{ 0 }; i < LayerCnt; i++)
+    {
+        for (std::size_t j{ 0 }; j < LayerCnt; j++)
+        {
+            m_cells[i][j].interacts = false;
+            m_cells[i][j].isSwapped = false;
+        }
+    }
+}
+
+CollisionLayers CollisionLayerMatrix::getLayer(unsigned int types)
+{
+    // A fireball is a weapon too, but it has to be handled as projectile
+    if (types & WorldObjectTypes::PROJECTILE)
+    {
+        return CollisionLayers::PROJECTILE;
+    }
+    if (types & WorldObjectTypes::WEAPON)
+    {
+        return CollisionLayers::WEAPON;
+    }
+    if (types & WorldObjectTypes::SHIELD)
+    {
+        return CollisionLayers::SHIELD;
+    }
+    if (types & WorldObjectTypes::WARRIOR)
+    {
+        return CollisionLayers::WARRIOR;
+    }
+    if (types & WorldObjectTypes::LEVEL)
+    {
+        return CollisionLayers::LEVEL;
+    }
+    return CollisionLayers::NONE;
+}
+
+unsigned int CollisionLayerMatrix::getLayerMask(CollisionLayers layer)
+{
+    return 1u << static_cast<unsigned int>(layer);
+}
+
+void CollisionLayerMatrix::setInteraction(CollisionLayers layerA, 
+        CollisionLayers layerB, Handler handler)
+{
+    Cell &cellAB{ getCell(layerA, layerB) };
+    cellAB.interacts = true;
+    cellAB.isSwapped = false;
+    cellAB.handler = handler;
+    if (layerA != layerB)
+    {
+        Cell &cellBA{ getCell(layerB, layerA) };
+        cellBA.interacts = true;
+        cellBA.isSwapped = true;
+        cellBA.handler = handler;
+    }
+}
+
+void CollisionLayerMatrix::removeInteraction(CollisionLayers layerA, 
+        CollisionLayers layerB)
+{
+    Cell &cellAB{ getCell(layerA, layerB) };
+    Cell &cellBA{ getCell(layerB, layerA) };
+    cellAB.interacts = false;
+    cellAB.handler = nullptr;
+    cellBA.interacts = false;
+    cellBA.handler = nullptr;
+}
+
+bool CollisionLayerMatrix::interacts(CollisionLayers layerA, 
+        CollisionLayers layerB) const
+{
+    return getCell(layerA, layerB).interacts;
+}
+
+bool CollisionLayerMatrix::dispatch(CollisionInfo &collisionInfo) const
+{
+    SceneNode *first{ collisionInfo.getCollidedFirst() };
+    SceneNode *second{ collisionInfo.getCollidedSecond() };
+    const Cell &LayerCell{ getCell(getLayer(first->getType()), 
+            getLayer(second->getType())) };
+    if (!LayerCell.interacts || !LayerCell.handler)
+    {
+        return false;
+    }
+    if (LayerCell.isSwapped)
+    {
+        LayerCell.handler(second, first, collisionInfo);
+    }
+    else
+    {
+        LayerCell.handler(first, second, collisionInfo);
+    }
+    return true;
+}
+
+CollisionLayerMatrix::Cell& CollisionLayerMatrix::getCell(
+        CollisionLayers layerA, CollisionLayers layerB)
+{
+    return m_cells[static_cast<std::size_t>(layerA)]
+        [static_cast<std::size_t>(layerB)];
+}
+
+const CollisionLayerMatrix::Cell& CollisionLayerMatrix::getCell(
+        CollisionLayers layerA, CollisionLayers layerB) const
+{
+    return m_cells[static_cast<std::size_t>(layerA)]
+        [static_cast<std::size_t>(layerB)];
+}
@@ -1,10 +1,13 @@
 #include "Collision/CollisionRect.hpp"
 #include "Collision/CollisionHandler.hpp"
 #include "Calc.hpp"
+#include <iterator>
 
 CollisionRect::CollisionRect(sf::Vector2f rectSize)
 : m_width{ rectSize.x }
 , m_height{ rectSize.y }
+// Not equal to the current frame, so the box is computed on the first use
+, m_orientedBoxFrame{ collisionFrame - 1 }
 {
 
 }
@@ -20,10 +23,21 @@ float CollisionRect::getHeight() const
 }
 
 void CollisionRect::computeVertices()
+{
+    // The vertices are computed from the oriented box, so the rotation is
+    // only applied once to the axes and not to every vertex
+    sf::Vector2f vertices[4];
+    getOrientedBox().getVertices(vertices);
+    // Add the vertices to the container
+    m_vertices.clear();
+    // Add vertices clockwise
+    m_vertices.insert(m_vertices.end(), std::begin(vertices), std::end(vertices));
+}
+
+void CollisionRect::computeVerticesReference()
 {
     const float Rotation = { getWorldRotation() };
     const sf::Vector2f Position = { getWorldPosition() };
-    //std::cout << "Rotation: " << Rotation << std::endl;
     // Compute the rects vertices as AABB
     const sf::Vector2f EdgeA = 
         { Position.x - m_width / 2.f, Position.y - m_height / 2.f };
@@ -51,6 +65,17 @@ void CollisionRect::computeVertices()
     m_vertices.push_back(EdgeDR);
 }
 
+const OrientedBox& CollisionRect::getOrientedBox()
+{
+    if (m_orientedBoxFrame != collisionFrame)
+    {
+        m_orientedBox = OrientedBox(getWorldPosition(), 
+                { m_width / 2.f, m_height / 2.f }, getWorldRotation());
+        m_orientedBoxFrame = collisionFrame;
+    }
+    return m_orientedBox;
+}
+
 std::vector<sf::Vector2f> CollisionRect::getVertices() const
 {
     return m_vertices;
@@ -68,6 +93,11 @@ void CollisionRect::draw(sf::RenderTarget &target, sf::RenderStates states) cons
     }
 }
 
+CollisionShapeTypes CollisionRect::getShapeType() const
+{
+    return CollisionShapeTypes::RECT;
+}
+
 CollisionInfo CollisionRect::isColliding(CollisionShape &collider)
 {
     return collider.isColliding(*this);
@@ -1,6 +1,7 @@
 #include "Collision/CollisionShape.hpp"
 
 bool CollisionShape::drawCollisionShapes{ false };
+unsigned int CollisionShape::collisionFrame{ 0 };
 
 CollisionShape::CollisionShape()
 : m_parent{ nullptr }
@@ -0,0 +1,416 @@
+#include "Collision/CollisionWorld.hpp"
+#include "Collision/CollisionCircle.hpp"
+#include "Collision/CollisionHandler.hpp"
+#include "Collision/CollisionRect.hpp"
+#include "Components/SceneNode.hpp"
+#include "Calc.hpp"
+#include <algorithm>
+#include <cmath>
+
+CollisionWorld::CollisionWorld()
+: m_sceneGraph{ nullptr }
+, m_broadPhasePairCnt{ 0 }
+{
+
+}
+
+void CollisionWorld::update(SceneNode &sceneGraph)
+{
+    m_sceneGraph = &sceneGraph;
+    m_nodes.clear();
+    m_entries.clear();
+    sceneGraph.collectCollisionNodes(m_nodes);
+    for (SceneNode *node : m_nodes)
+    {
+        // Nodes without an interacting layer can never collide
+        const CollisionLayers Layer{ 
+            CollisionLayerMatrix::getLayer(node->getType()) };
+        if (Layer == CollisionLayers::NONE)
+        {
+            continue;
+        }
+        CollisionShape *shape{ node->getCollisionShape() };
+        Entry entry;
+        entry.node = node;
+        entry.shape = shape;
+        entry.layer = Layer;
+        if (shape->getShapeType() == CollisionShapeTypes::CIRCLE)
+        {
+            const CollisionCircle *Circle{
+                static_cast<CollisionCircle*>(shape) };
+            const sf::Vector2f Pos{ Circle->getWorldPosition() };
+            const float Radius{ Circle->getRadius() };
+            entry.minX = Pos.x - Radius;
+            entry.minY = Pos.y - Radius;
+            entry.maxX = Pos.x + Radius;
+            entry.maxY = Pos.y + Radius;
+        }
+        else
+        {
+            const OrientedBox &Box{
+                static_cast<CollisionRect*>(shape)->getOrientedBox() };
+            // Half size of the box which encloses the rotated rect
+            const float ExtentX{ std::abs(Box.axisX.x) * Box.halfExtents.x +
+                std::abs(Box.axisY.x) * Box.halfExtents.y };
+            const float ExtentY{ std::abs(Box.axisX.y) * Box.halfExtents.x +
+                std::abs(Box.axisY.y) * Box.halfExtents.y };
+            entry.minX = Box.center.x - ExtentX;
+            entry.minY = Box.center.y - ExtentY;
+            entry.maxX = Box.center.x + ExtentX;
+            entry.maxY = Box.center.y + ExtentY;
+        }
+        const sf::Vector2f Center{ (entry.minX + entry.maxX) / 2.f, 
+            (entry.minY + entry.maxY) / 2.f };
+        entry.isTile = Layer == CollisionLayers::LEVEL && 
+            m_tileGrid.getTile(Center) == node;
+        m_entries.push_back(entry);
+    }
+    std::sort(m_entries.begin(), m_entries.end(),
+            [] (const Entry &a, const Entry &b)
+            {
+                return a.minX < b.minX;
+            });
+}
+
+void CollisionWorld::findCollisions(std::vector<CollisionInfo> &collisionData)
+{
+    m_narrowPhase.clear();
+    m_contactCache.beginFrame();
+    const std::size_t EntryCnt{ m_entries.size() };
+    for (std::size_t i{ 0 }; i < EntryCnt; i++)
+    {
+        Entry &entryA{ m_entries[i] };
+        // The entries are sorted by minX, so when the box of an entry begins
+        // after the end of the box of entryA, all following entries can not
+        // overlap with it
+        for (std::size_t j{ i + 1 }; j < EntryCnt &&
+                m_entries[j].minX <= entryA.maxX; j++)
+        {
+            Entry &entryB{ m_entries[j] };
+            if (entryB.minY > entryA.maxY || entryB.maxY < entryA.minY)
+            {
+                continue;
+            }
+            // Passive nodes dont move, so they cant collide with each other
+            if (!entryA.node->isActive() && !entryB.node->isActive())
+            {
+                continue;
+            }
+            if (!m_layerMatrix.interacts(entryA.layer, entryB.layer))
+            {
+                continue;
+            }
+            if (!entryA.node->canCollideWith(*entryB.node))
+            {
+                continue;
+            }
+            addToNarrowPhase(entryA, entryB, 
+                    m_contactCache.getEntry(*entryA.node, *entryB.node));
+        }
+    }
+    m_broadPhasePairCnt = m_narrowPhase.getPairCnt();
+    const std::size_t FirstNewCollision{ collisionData.size() };
+    m_narrowPhase.evaluate(collisionData);
+    for (std::size_t i{ FirstNewCollision }; i < collisionData.size(); i++)
+    {
+        m_contactCache.addCollision(collisionData[i]);
+    }
+    m_contactCache.endFrame();
+}
+
+void CollisionWorld::findSweepHits(std::vector<SweepHit> &sweepHits)
+{
+    for (Entry &moving : m_entries)
+    {
+        // Only the nodes which are attached to the root move by themselves, 
+        // the children move with them
+        if (!moving.node->isActive() || moving.node->getParent() != m_sceneGraph)
+        {
+            continue;
+        }
+        const sf::Vector2f Displacement{ moving.node->getWorldDisplacement() };
+        const float MinHalfSize{ getMinHalfSize(*moving.shape) };
+        // Slow nodes cant pass an obstacle in one frame, so the discrete test
+        // is enough
+        if (Displacement.x * Displacement.x + Displacement.y * Displacement.y <= 
+                MinHalfSize * MinHalfSize)
+        {
+            continue;
+        }
+        // The box which encloses the shape on the whole way
+        const float MinX{ moving.minX - std::max(0.f, Displacement.x) };
+        const float MaxX{ moving.maxX - std::min(0.f, Displacement.x) };
+        const float MinY{ moving.minY - std::max(0.f, Displacement.y) };
+        const float MaxY{ moving.maxY - std::min(0.f, Displacement.y) };
+        SweepHit firstHit{ moving.node, nullptr, 1.f };
+        for (Entry &obstacle : m_entries)
+        {
+            // The entries are sorted by minX
+            if (obstacle.minX > MaxX)
+            {
+                break;
+            }
+            if (obstacle.node->isActive() || obstacle.maxX < MinX || 
+                    obstacle.minY > MaxY || obstacle.maxY < MinY || 
+                    !m_layerMatrix.interacts(moving.layer, obstacle.layer) ||
+                    !moving.node->canCollideWith(*obstacle.node))
+            {
+                continue;
+            }
+            float timeOfImpact{ 1.f };
+            if (sweep(moving, Displacement, obstacle, timeOfImpact) && 
+                    timeOfImpact < firstHit.timeOfImpact)
+            {
+                firstHit.obstacle = obstacle.node;
+                firstHit.timeOfImpact = timeOfImpact;
+            }
+        }
+        if (firstHit.obstacle)
+        {
+            sweepHits.push_back(firstHit);
+        }
+    }
+}
+
+void CollisionWorld::removeDestroyed()
+{
+    auto destroyBegin = std::remove_if(m_entries.begin(), m_entries.end(), 
+            [] (const Entry &entry)
+            {
+                for (const SceneNode *node{ entry.node }; node; 
+                        node = node->getParent())
+                {
+                    if (node->isMarkedForRemoval())
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            });
+    m_entries.erase(destroyBegin, m_entries.end());
+    m_nodes.clear();
+}
+
+void CollisionWorld::clearContacts()
+{
+    m_contactCache.clear();
+}
+
+bool CollisionWorld::raycast(sf::Vector2f origin, sf::Vector2f direction, 
+        float maxDistance, RayHit &hit, unsigned int layerMask) const
+{
+    return cast(origin, direction, maxDistance, 0.f, hit, layerMask);
+}
+
+bool CollisionWorld::segmentCast(sf::Vector2f from, sf::Vector2f to, 
+        RayHit &hit, unsigned int layerMask) const
+{
+    const sf::Vector2f Segment{ to - from };
+    const float Length{ Calc::getVec2Length(Segment) };
+    const sf::Vector2f Direction{ Length > 0.f ? 
+        Segment / Length : sf::Vector2f{ 1.f, 0.f } };
+    return cast(from, Direction, Length, 0.f, hit, layerMask);
+}
+
+bool CollisionWorld::circleCast(sf::Vector2f from, sf::Vector2f to, 
+        float radius, RayHit &hit, unsigned int layerMask) const
+{
+    const sf::Vector2f Segment{ to - from };
+    const float Length{ Calc::getVec2Length(Segment) };
+    const sf::Vector2f Direction{ Length > 0.f ? 
+        Segment / Length : sf::Vector2f{ 1.f, 0.f } };
+    return cast(from, Direction, Length, radius, hit, layerMask);
+}
+
+void CollisionWorld::queryArea(const sf::FloatRect &area, 
+        std::vector<SceneNode*> &nodes, unsigned int layerMask) const
+{
+    const float MaxX{ area.left + area.width };
+    const float MaxY{ area.top + area.height };
+    for (const Entry &entry : m_entries)
+    {
+        // The entries are sorted by minX
+        if (entry.minX > MaxX)
+        {
+            break;
+        }
+        if (entry.maxX < area.left || entry.minY > MaxY || 
+                entry.maxY < area.top || 
+                (layerMask & CollisionLayerMatrix::getLayerMask(entry.layer)) == 0)
+        {
+            continue;
+        }
+        nodes.push_back(entry.node);
+    }
+}
+
+std::size_t CollisionWorld::getBroadPhasePairCnt() const
+{
+    return m_broadPhasePairCnt;
+}
+
+CollisionLayerMatrix& CollisionWorld::getLayerMatrix()
+{
+    return m_layerMatrix;
+}
+
+TileGrid& CollisionWorld::getTileGrid()
+{
+    return m_tileGrid;
+}
+
+const TileGrid& CollisionWorld::getTileGrid() const
+{
+    return m_tileGrid;
+}
+
+const ContactCache::Stats& CollisionWorld::getContactStats() const
+{
+    return m_contactCache.getStats();
+}
+
+void CollisionWorld::addToNarrowPhase(Entry &entryA, Entry &entryB, 
+        ContactCache::Entry &contact)
+{
+    const bool IsCircleA{
+        entryA.shape->getShapeType() == CollisionShapeTypes::CIRCLE };
+    const bool IsCircleB{
+        entryB.shape->getShapeType() == CollisionShapeTypes::CIRCLE };
+    if (IsCircleA && IsCircleB)
+    {
+        m_narrowPhase.addCircleCircle(
+                *static_cast<CollisionCircle*>(entryA.shape),
+                *static_cast<CollisionCircle*>(entryB.shape));
+    }
+    else if (IsCircleA)
+    {
+        m_narrowPhase.addCircleRect(
+                *static_cast<CollisionCircle*>(entryA.shape),
+                *static_cast<CollisionRect*>(entryB.shape));
+    }
+    else if (IsCircleB)
+    {
+        m_narrowPhase.addCircleRect(
+                *static_cast<CollisionCircle*>(entryB.shape),
+                *static_cast<CollisionRect*>(entryA.shape));
+    }
+    else
+    {
+        m_narrowPhase.addRectRect(
+                *static_cast<CollisionRect*>(entryA.shape),
+                *static_cast<CollisionRect*>(entryB.shape), 
+                &contact.separatingAxis);
+    }
+}
+
+float CollisionWorld::getMinHalfSize(CollisionShape &shape) const
+{
+    if (shape.getShapeType() == CollisionShapeTypes::CIRCLE)
+    {
+        return static_cast<CollisionCircle&>(shape).getRadius();
+    }
+    const OrientedBox &Box{ static_cast<CollisionRect&>(shape).getOrientedBox() };
+    return std::min(Box.halfExtents.x, Box.halfExtents.y);
+}
+
+bool CollisionWorld::sweep(Entry &moving, sf::Vector2f displacement, 
+        Entry &obstacle, float &timeOfImpact) const
+{
+    // Only rects are used as static obstacles (The level tiles)
+    if (obstacle.shape->getShapeType() != CollisionShapeTypes::RECT)
+    {
+        return false;
+    }
+    CollisionRect &obstacleRect{ *static_cast<CollisionRect*>(obstacle.shape) };
+    if (moving.shape->getShapeType() == CollisionShapeTypes::CIRCLE)
+    {
+        return CollisionHandler::sweep(
+                *static_cast<CollisionCircle*>(moving.shape), displacement, 
+                obstacleRect, timeOfImpact);
+    }
+    return CollisionHandler::sweep(*static_cast<CollisionRect*>(moving.shape), 
+            displacement, obstacleRect, timeOfImpact);
+}
+
+bool CollisionWorld::cast(sf::Vector2f origin, sf::Vector2f direction, 
+        float maxDistance, float radius, RayHit &hit, 
+        unsigned int layerMask) const
+{
+    hit.node = nullptr;
+    hit.distance = maxDistance;
+    // The tiles are only visited in the cells the ray passes, so a thick cast
+    // could miss the tiles next to it
+    const bool UseTileGrid{ radius == 0.f && !m_tileGrid.isEmpty() && 
+        (layerMask & CollisionLayerMatrix::getLayerMask(CollisionLayers::LEVEL))
+            != 0 };
+    if (UseTileGrid)
+    {
+        // The cells are visited in the order of the ray, so the first hit tile
+        // is the nearest
+        m_tileGrid.traverse(origin, direction, maxDistance, 
+                [&] (SceneNode &tile)
+                {
+                    if (tile.getCollisionShape())
+                    {
+                        castAgainst(tile, *tile.getCollisionShape(), origin, 
+                                direction, radius, hit);
+                    }
+                    return hit.node != nullptr;
+                });
+    }
+    // Only the entries in the box around the (remaining) way can be hit
+    const sf::Vector2f End{ origin + direction * hit.distance };
+    const float MinX{ std::min(origin.x, End.x) - radius };
+    const float MaxX{ std::max(origin.x, End.x) + radius };
+    const float MinY{ std::min(origin.y, End.y) - radius };
+    const float MaxY{ std::max(origin.y, End.y) + radius };
+    for (const Entry &entry : m_entries)
+    {
+        // The entries are sorted by minX
+        if (entry.minX > MaxX)
+        {
+            break;
+        }
+        if (entry.maxX < MinX || entry.minY > MaxY || entry.maxY < MinY || 
+                (UseTileGrid && entry.isTile) || 
+                (layerMask & CollisionLayerMatrix::getLayerMask(entry.layer)) == 0)
+        {
+            continue;
+        }
+        castAgainst(*entry.node, *entry.shape, origin, direction, radius, hit);
+    }
+    if (hit.node)
+    {
+        hit.point = origin + direction * hit.distance;
+        return true;
+    }
+    return false;
+}
+
+void CollisionWorld::castAgainst(SceneNode &node, CollisionShape &shape, 
+        sf::Vector2f origin, sf::Vector2f direction, float radius, 
+        RayHit &hit) const
+{
+    float distance{ 0.f };
+    sf::Vector2f normal;
+    bool isHit{ false };
+    if (shape.getShapeType() == CollisionShapeTypes::CIRCLE)
+    {
+        CollisionCircle &circle{ static_cast<CollisionCircle&>(shape) };
+        isHit = CollisionHandler::raycast(circle.getWorldPosition(), 
+                circle.getRadius() + radius, origin, direction, hit.distance, 
+                distance, normal);
+    }
+    else
+    {
+        isHit = CollisionHandler::raycast(
+                static_cast<CollisionRect&>(shape).getOrientedBox(), radius, 
+                origin, direction, hit.distance, distance, normal);
+    }
+    if (isHit && (!hit.node || distance < hit.distance))
+    {
+        hit.node = &node;
+        hit.distance = distance;
+        hit.normal = normal;
+    }
+}
@@ -0,0 +1,95 @@
+#include "Collision/ContactCache.hpp"
+#include "Components/SceneNode.hpp"
+#include <algorithm>
+
+ContactCache::ContactCache()
+: m_frame{ 0 }
+, m_stats{ 0, 0, 0, 0 }
+{
+
+}
+
+void ContactCache::beginFrame()
+{
+    m_frame++;
+    m_stats = { 0, 0, 0, 0 };
+}
+
+ContactCache::Entry& ContactCache::getEntry(const SceneNode &nodeA, 
+        const SceneNode &nodeB)
+{
+    auto inserted = m_entries.insert({ getKey(nodeA, nodeB), 
+            { m_frame, 0, 0, false, -1 } });
+    Entry &entry{ inserted.first->second };
+    entry.lastSeenFrame = m_frame;
+    return entry;
+}
+
+void ContactCache::addCollision(CollisionInfo &collisionInfo)
+{
+    const SceneNode &NodeA{ *collisionInfo.getCollidedFirst() };
+    const SceneNode &NodeB{ *collisionInfo.getCollidedSecond() };
+    Entry &entry{ getEntry(NodeA, NodeB) };
+    const unsigned int Epoch{ getEpoch(NodeA, NodeB) };
+    if (entry.isTouching && entry.epoch == Epoch)
+    {
+        collisionInfo.setContactState(ContactStates::STAY);
+        m_stats.stayCnt++;
+    }
+    else
+    {
+        collisionInfo.setContactState(ContactStates::BEGIN);
+        m_stats.beginCnt++;
+    }
+    entry.isTouching = true;
+    entry.epoch = Epoch;
+    entry.lastCollisionFrame = m_frame;
+}
+
+void ContactCache::endFrame()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        Entry &entry{ it->second };
+        if (entry.isTouching && entry.lastCollisionFrame != m_frame)
+        {
+            entry.isTouching = false;
+            m_stats.endCnt++;
+        }
+        if (entry.lastSeenFrame != m_frame)
+        {
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    m_stats.pairCnt = m_entries.size();
+}
+
+void ContactCache::clear()
+{
+    m_entries.clear();
+    m_stats.pairCnt = 0;
+}
+
+const ContactCache::Stats& ContactCache::getStats() const
+{
+    return m_stats;
+}
+
+std::uint64_t ContactCache::getKey(const SceneNode &nodeA, 
+        const SceneNode &nodeB)
+{
+    // The same key independent of the order of the nodes
+    const std::uint64_t MinId{ std::min(nodeA.getNodeId(), nodeB.getNodeId()) };
+    const std::uint64_t MaxId{ std::max(nodeA.getNodeId(), nodeB.getNodeId()) };
+    return (MinId << 32) | MaxId;
+}
+
+unsigned int ContactCache::getEpoch(const SceneNode &nodeA, 
+        const SceneNode &nodeB)
+{
+    return nodeA.getContactEpoch() + nodeB.getContactEpoch();
+}
@@ -0,0 +1,143 @@
+#include "Collision/ContactSolver.hpp"
+#include "Components/Entity.hpp"
+#include "Calc.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // More iterations dont resolve the contacts noticeably better, but can
+    // stall a frame with many contacts
+    const std::size_t MaxIterationLimit{ 64 };
+}
+
+const std::size_t ContactSolver::NO_BODY{ 
+    std::numeric_limits<std::size_t>::max() };
+
+ContactSolver::ContactSolver(std::size_t maxIterations, float tolerance)
+: m_maxIterations{ 1 }
+, m_tolerance{ tolerance }
+, m_stats{ 0, 0, 0, 0.f, 0.f }
+{
+    setMaxIterations(maxIterations);
+}
+
+void ContactSolver::setMaxIterations(std::size_t maxIterations)
+{
+    // At least one iteration, so the contacts are resolved at all
+    m_maxIterations = std::min(std::max<std::size_t>(maxIterations, 1), 
+            MaxIterationLimit);
+}
+
+std::size_t ContactSolver::getMaxIterations() const
+{
+    return m_maxIterations;
+}
+
+void ContactSolver::addContact(Entity *entityA, Entity *entityB, 
+        sf::Vector2f normal, float penetration)
+{
+    const float NormalLength{ Calc::getVec2Length(normal) };
+    // Without a direction (e.g. the centers are on the same position) the 
+    // contact cant be resolved
+    if (NormalLength <= 0.f || penetration <= 0.f)
+    {
+        return;
+    }
+    const std::size_t BodyA{ getBodyIndex(entityA) };
+    const std::size_t BodyB{ entityB ? getBodyIndex(entityB) : NO_BODY };
+    m_contacts.push_back({ BodyA, BodyB, normal / NormalLength, penetration });
+}
+
+void ContactSolver::addStaticContact(Entity *entity, sf::Vector2f normal, 
+        float penetration)
+{
+    addContact(entity, nullptr, normal, penetration);
+}
+
+void ContactSolver::solve()
+{
+    m_stats = { m_contacts.size(), m_bodies.size(), 0, 0.f, 0.f };
+    for (const Contact &contact : m_contacts)
+    {
+        m_stats.initialPenetration = 
+            std::max(m_stats.initialPenetration, contact.penetration);
+    }
+    float remainingPenetration{ m_stats.initialPenetration };
+    while (m_stats.iterations < m_maxIterations && 
+            remainingPenetration > m_tolerance)
+    {
+        m_stats.iterations++;
+        remainingPenetration = 0.f;
+        for (const Contact &contact : m_contacts)
+        {
+            const float Penetration{ getCurrentPenetration(contact) };
+            if (Penetration <= 0.f)
+            {
+                continue;
+            }
+            Body &bodyA{ m_bodies[contact.bodyA] };
+            const float InverseMassB{ contact.bodyB != NO_BODY ? 
+                m_bodies[contact.bodyB].inverseMass : 0.f };
+            const float InverseMassSum{ bodyA.inverseMass + InverseMassB };
+            if (InverseMassSum <= 0.f)
+            {
+                continue;
+            }
+            // The lighter body gets the bigger part of the correction
+            bodyA.correction += contact.normal * 
+                (Penetration * bodyA.inverseMass / InverseMassSum);
+            if (contact.bodyB != NO_BODY)
+            {
+                m_bodies[contact.bodyB].correction -= contact.normal * 
+                    (Penetration * InverseMassB / InverseMassSum);
+            }
+        }
+        // Check how much penetration is left after this iteration
+        for (const Contact &contact : m_contacts)
+        {
+            remainingPenetration = std::max(remainingPenetration, 
+                    getCurrentPenetration(contact));
+        }
+    }
+    m_stats.remainingPenetration = remainingPenetration;
+
+    for (Body &body : m_bodies)
+    {
+        body.entity->move(body.correction);
+    }
+    m_bodies.clear();
+    m_contacts.clear();
+}
+
+const ContactSolver::Stats& ContactSolver::getStats() const
+{
+    return m_stats;
+}
+
+std::size_t ContactSolver::getBodyIndex(Entity *entity)
+{
+    // There are only a few bodies per frame, so a linear search is fast enough
+    for (std::size_t i{ 0 }; i < m_bodies.size(); i++)
+    {
+        if (m_bodies[i].entity == entity)
+        {
+            return i;
+        }
+    }
+    const float Mass{ entity->getMass() };
+    // Entities without mass are not moved by the solver
+    m_bodies.push_back({ entity, Mass > 0.f ? 1.f / Mass : 0.f, { 0.f, 0.f } });
+    return m_bodies.size() - 1;
+}
+
+float ContactSolver::getCurrentPenetration(const Contact &contact) const
+{
+    sf::Vector2f relativeCorrection{ m_bodies[contact.bodyA].correction };
+    if (contact.bodyB != NO_BODY)
+    {
+        relativeCorrection -= m_bodies[contact.bodyB].correction;
+    }
+    return contact.penetration - 
+        Calc::getVec2Scalar(relativeCorrection, contact.normal);
+}
@@ -0,0 +1,248 @@
+#include "Collision/NarrowPhaseBatch.hpp"
+#include "Collision/CollisionHandler.hpp"
+#include "Calc.hpp"
+#include <algorithm>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    // Add the indices of the lanes with a set bit in the mask to the hits
+    void addHits(int mask, std::size_t firstIndex,
+            std::vector<std::size_t> &hits)
+    {
+        while (mask != 0)
+        {
+            int lane{ 0 };
+            while ((mask & (1 << lane)) == 0)
+            {
+                lane++;
+            }
+            hits.push_back(firstIndex + lane);
+            mask &= ~(1 << lane);
+        }
+    }
+}
+
+void NarrowPhaseBatch::clear()
+{
+    m_circleCircle.posXA.clear();
+    m_circleCircle.posYA.clear();
+    m_circleCircle.radiusA.clear();
+    m_circleCircle.posXB.clear();
+    m_circleCircle.posYB.clear();
+    m_circleCircle.radiusB.clear();
+    m_circleCircle.nodeA.clear();
+    m_circleCircle.nodeB.clear();
+
+    m_circleRect.circlePosX.clear();
+    m_circleRect.circlePosY.clear();
+    m_circleRect.circleRadius.clear();
+    m_circleRect.rectPosX.clear();
+    m_circleRect.rectPosY.clear();
+    m_circleRect.rectAxisX.clear();
+    m_circleRect.rectAxisY.clear();
+    m_circleRect.rectHalfWidth.clear();
+    m_circleRect.rectHalfHeight.clear();
+    m_circleRect.circleNode.clear();
+    m_circleRect.rectNode.clear();
+
+    m_rectRect.clear();
+}
+
+void NarrowPhaseBatch::addCircleCircle(CollisionCircle &circleA,
+        CollisionCircle &circleB)
+{
+    const sf::Vector2f PosA{ circleA.getWorldPosition() };
+    const sf::Vector2f PosB{ circleB.getWorldPosition() };
+    m_circleCircle.posXA.push_back(PosA.x);
+    m_circleCircle.posYA.push_back(PosA.y);
+    m_circleCircle.radiusA.push_back(circleA.getRadius());
+    m_circleCircle.posXB.push_back(PosB.x);
+    m_circleCircle.posYB.push_back(PosB.y);
+    m_circleCircle.radiusB.push_back(circleB.getRadius());
+    m_circleCircle.nodeA.push_back(circleA.getParent());
+    m_circleCircle.nodeB.push_back(circleB.getParent());
+}
+
+void NarrowPhaseBatch::addCircleRect(CollisionCircle &circle,
+        CollisionRect &rect)
+{
+    const sf::Vector2f CirclePos{ circle.getWorldPosition() };
+    const OrientedBox &Box{ rect.getOrientedBox() };
+    m_circleRect.circlePosX.push_back(CirclePos.x);
+    m_circleRect.circlePosY.push_back(CirclePos.y);
+    m_circleRect.circleRadius.push_back(circle.getRadius());
+    m_circleRect.rectPosX.push_back(Box.center.x);
+    m_circleRect.rectPosY.push_back(Box.center.y);
+    m_circleRect.rectAxisX.push_back(Box.axisX.x);
+    m_circleRect.rectAxisY.push_back(Box.axisX.y);
+    m_circleRect.rectHalfWidth.push_back(Box.halfExtents.x);
+    m_circleRect.rectHalfHeight.push_back(Box.halfExtents.y);
+    m_circleRect.circleNode.push_back(circle.getParent());
+    m_circleRect.rectNode.push_back(rect.getParent());
+}
+
+void NarrowPhaseBatch::addRectRect(CollisionRect &rectA, CollisionRect &rectB,
+        int *separatingAxis)
+{
+    m_rectRect.push_back({ &rectA, &rectB, separatingAxis });
+}
+
+std::size_t NarrowPhaseBatch::getPairCnt() const
+{
+    return m_circleCircle.nodeA.size() + m_circleRect.circleNode.size() +
+        m_rectRect.size();
+}
+
+void NarrowPhaseBatch::evaluate(std::vector<CollisionInfo> &collisionData)
+{
+    evaluateCircleCircle(collisionData);
+    evaluateCircleRect(collisionData);
+    evaluateRectRect(collisionData);
+}
+
+void NarrowPhaseBatch::evaluateCircleCircle(
+        std::vector<CollisionInfo> &collisionData)
+{
+    const CircleCircleBatch &B{ m_circleCircle };
+    const std::size_t PairCnt{ B.nodeA.size() };
+    m_hits.clear();
+    std::size_t i{ 0 };
+#ifdef __SSE2__
+    // Compare the squared distance with the squared sum of the radii, so the
+    // square root is only needed for the colliding pairs
+    for (; i + 4 <= PairCnt; i += 4)
+    {
+        const __m128 DistX{ _mm_sub_ps(_mm_loadu_ps(&B.posXA[i]),
+                _mm_loadu_ps(&B.posXB[i])) };
+        const __m128 DistY{ _mm_sub_ps(_mm_loadu_ps(&B.posYA[i]),
+                _mm_loadu_ps(&B.posYB[i])) };
+        const __m128 DistSq{ _mm_add_ps(_mm_mul_ps(DistX, DistX),
+                _mm_mul_ps(DistY, DistY)) };
+        const __m128 RadiusSum{ _mm_add_ps(_mm_loadu_ps(&B.radiusA[i]),
+                _mm_loadu_ps(&B.radiusB[i])) };
+        const __m128 IsHit{ _mm_cmplt_ps(DistSq,
+                _mm_mul_ps(RadiusSum, RadiusSum)) };
+        addHits(_mm_movemask_ps(IsHit), i, m_hits);
+    }
+#endif
+    for (; i < PairCnt; i++)
+    {
+        const float DistX{ B.posXA[i] - B.posXB[i] };
+        const float DistY{ B.posYA[i] - B.posYB[i] };
+        const float RadiusSum{ B.radiusA[i] + B.radiusB[i] };
+        if (DistX * DistX + DistY * DistY < RadiusSum * RadiusSum)
+        {
+            m_hits.push_back(i);
+        }
+    }
+    for (std::size_t hit : m_hits)
+    {
+        const sf::Vector2f DistVec{
+            B.posXA[hit] - B.posXB[hit], B.posYA[hit] - B.posYB[hit] };
+        const float Overlap{ B.radiusA[hit] + B.radiusB[hit] -
+            std::sqrt(DistVec.x * DistVec.x + DistVec.y * DistVec.y) };
+        collisionData.push_back(CollisionInfo(true, Overlap, DistVec, -DistVec,
+                    B.nodeA[hit], B.nodeB[hit]));
+    }
+}
+
+void NarrowPhaseBatch::evaluateCircleRect(
+        std::vector<CollisionInfo> &collisionData)
+{
+    const CircleRectBatch &B{ m_circleRect };
+    const std::size_t PairCnt{ B.circleNode.size() };
+    m_hits.clear();
+    std::size_t i{ 0 };
+#ifdef __SSE2__
+    // Same as the scalar loop: the circle is moved into the local coordinate
+    // system of the rect and the nearest point on the rect is found by
+    // clamping
+    for (; i + 4 <= PairCnt; i += 4)
+    {
+        const __m128 DistX{ _mm_sub_ps(_mm_loadu_ps(&B.circlePosX[i]),
+                _mm_loadu_ps(&B.rectPosX[i])) };
+        const __m128 DistY{ _mm_sub_ps(_mm_loadu_ps(&B.circlePosY[i]),
+                _mm_loadu_ps(&B.rectPosY[i])) };
+        const __m128 AxisX{ _mm_loadu_ps(&B.rectAxisX[i]) };
+        const __m128 AxisY{ _mm_loadu_ps(&B.rectAxisY[i]) };
+        const __m128 LocalX{ _mm_add_ps(_mm_mul_ps(DistX, AxisX),
+                _mm_mul_ps(DistY, AxisY)) };
+        const __m128 LocalY{ _mm_sub_ps(_mm_mul_ps(DistY, AxisX),
+                _mm_mul_ps(DistX, AxisY)) };
+        const __m128 HalfWidth{ _mm_loadu_ps(&B.rectHalfWidth[i]) };
+        const __m128 HalfHeight{ _mm_loadu_ps(&B.rectHalfHeight[i]) };
+        const __m128 NearestX{ _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(),
+                    HalfWidth), _mm_min_ps(HalfWidth, LocalX)) };
+        const __m128 NearestY{ _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(),
+                    HalfHeight), _mm_min_ps(HalfHeight, LocalY)) };
+        const __m128 DiffX{ _mm_sub_ps(NearestX, LocalX) };
+        const __m128 DiffY{ _mm_sub_ps(NearestY, LocalY) };
+        const __m128 DistSq{ _mm_add_ps(_mm_mul_ps(DiffX, DiffX),
+                _mm_mul_ps(DiffY, DiffY)) };
+        const __m128 Radius{ _mm_loadu_ps(&B.circleRadius[i]) };
+        const __m128 IsHit{ _mm_cmplt_ps(DistSq, _mm_mul_ps(Radius, Radius)) };
+        addHits(_mm_movemask_ps(IsHit), i, m_hits);
+    }
+#endif
+    for (; i < PairCnt; i++)
+    {
+        const float DistX{ B.circlePosX[i] - B.rectPosX[i] };
+        const float DistY{ B.circlePosY[i] - B.rectPosY[i] };
+        const float LocalX{ DistX * B.rectAxisX[i] + DistY * B.rectAxisY[i] };
+        const float LocalY{ DistY * B.rectAxisX[i] - DistX * B.rectAxisY[i] };
+        const float DiffX{ Calc::clamp(LocalX, -B.rectHalfWidth[i],
+                B.rectHalfWidth[i]) - LocalX };
+        const float DiffY{ Calc::clamp(LocalY, -B.rectHalfHeight[i],
+                B.rectHalfHeight[i]) - LocalY };
+        if (DiffX * DiffX + DiffY * DiffY <
+                B.circleRadius[i] * B.circleRadius[i])
+        {
+            m_hits.push_back(i);
+        }
+    }
+    for (std::size_t hit : m_hits)
+    {
+        const float AxisX{ B.rectAxisX[hit] };
+        const float AxisY{ B.rectAxisY[hit] };
+        const float DistX{ B.circlePosX[hit] - B.rectPosX[hit] };
+        const float DistY{ B.circlePosY[hit] - B.rectPosY[hit] };
+        const float NearestX{ Calc::clamp(DistX * AxisX + DistY * AxisY,
+                -B.rectHalfWidth[hit], B.rectHalfWidth[hit]) };
+        const float NearestY{ Calc::clamp(DistY * AxisX - DistX * AxisY,
+                -B.rectHalfHeight[hit], B.rectHalfHeight[hit]) };
+        // Translate the nearest point back to world coordinates
+        const sf::Vector2f NearestPosWorld{
+            B.rectPosX[hit] + NearestX * AxisX - NearestY * AxisY,
+            B.rectPosY[hit] + NearestX * AxisY + NearestY * AxisX };
+        const sf::Vector2f Direction{
+            sf::Vector2f{ B.circlePosX[hit], B.circlePosY[hit] } -
+                NearestPosWorld };
+        const float Overlap{ B.circleRadius[hit] -
+            Calc::getVec2Length(Direction) };
+        collisionData.push_back(CollisionInfo(true, Overlap, Direction,
+                    -Direction, B.circleNode[hit], B.rectNode[hit]));
+    }
+}
+
+void NarrowPhaseBatch::evaluateRectRect(
+        std::vector<CollisionInfo> &collisionData)
+{
+    // The oriented box SAT is already cheap enough, so the rect pairs are not
+    // vectorized
+    for (const RectRectPair &Pair : m_rectRect)
+    {
+        int unusedAxis{ -1 };
+        int &separatingAxis{ Pair.separatingAxis ? 
+            *Pair.separatingAxis : unusedAxis };
+        CollisionInfo collisionInfo{ CollisionHandler::isColliding(
+                *Pair.rectA, *Pair.rectB, separatingAxis) };
+        if (collisionInfo.isCollision())
+        {
+            collisionData.push_back(collisionInfo);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#include "Collision/OrientedBox.hpp"
+#include "Calc.hpp"
+#include <cmath>
+
+OrientedBox::OrientedBox()
+: center{ 0.f, 0.f }
+, halfExtents{ 0.f, 0.f }
+, axisX{ 1.f, 0.f }
+, axisY{ 0.f, 1.f }
+{
+
+}
+
+OrientedBox::OrientedBox(sf::Vector2f center, sf::Vector2f halfExtents, 
+        float rotationDegree)
+: center{ center }
+, halfExtents{ halfExtents }
+{
+    // Same rotation as Calc::rotatePointAround() with the negative angle, but
+    // sin and cos are only computed once for both axes
+    const float Angle{ Calc::degToRad(rotationDegree) };
+    const float Sin{ std::sin(Angle) };
+    const float Cos{ std::cos(Angle) };
+    axisX = { Cos, Sin };
+    axisY = { -Sin, Cos };
+}
+
+float OrientedBox::getProjectionRadius(sf::Vector2f axis) const
+{
+    return halfExtents.x * std::abs(Calc::getVec2Scalar(axisX, axis)) + 
+        halfExtents.y * std::abs(Calc::getVec2Scalar(axisY, axis));
+}
+
+void OrientedBox::getVertices(sf::Vector2f (&vertices)[4]) const
+{
+    const sf::Vector2f HalfX{ axisX * halfExtents.x };
+    const sf::Vector2f HalfY{ axisY * halfExtents.y };
+    vertices[0] = center - HalfX - HalfY;
+    vertices[1] = center + HalfX - HalfY;
+    vertices[2] = center + HalfX + HalfY;
+    vertices[3] = center - HalfX + HalfY;
+}
@@ -0,0 +1,73 @@
+#include "Collision/TileGrid.hpp"
+
+TileGrid::TileGrid()
+: m_tileSize{ 0.f, 0.f }
+, m_columns{ 0 }
+, m_rows{ 0 }
+{
+
+}
+
+void TileGrid::create(sf::Vector2f tileSize, int columns, int rows)
+{
+    clear();
+    if (tileSize.x <= 0.f || tileSize.y <= 0.f || columns <= 0 || rows <= 0)
+    {
+        return;
+    }
+    m_tileSize = tileSize;
+    m_columns = columns;
+    m_rows = rows;
+    m_tiles.assign(static_cast<std::size_t>(columns * rows), nullptr);
+}
+
+void TileGrid::clear()
+{
+    m_tileSize = { 0.f, 0.f };
+    m_columns = 0;
+    m_rows = 0;
+    m_tiles.clear();
+}
+
+bool TileGrid::isEmpty() const
+{
+    return m_tiles.empty();
+}
+
+void TileGrid::setTile(sf::Vector2f position, SceneNode *node)
+{
+    if (isEmpty())
+    {
+        return;
+    }
+    const int Column{ static_cast<int>(std::floor(position.x / m_tileSize.x)) };
+    const int Row{ static_cast<int>(std::floor(position.y / m_tileSize.y)) };
+    if (Column >= 0 && Column < m_columns && Row >= 0 && Row < m_rows)
+    {
+        m_tiles[Row * m_columns + Column] = node;
+    }
+}
+
+SceneNode* TileGrid::getTile(sf::Vector2f position) const
+{
+    if (isEmpty())
+    {
+        return nullptr;
+    }
+    return getTile(static_cast<int>(std::floor(position.x / m_tileSize.x)), 
+            static_cast<int>(std::floor(position.y / m_tileSize.y)));
+}
+
+sf::FloatRect TileGrid::getBounds() const
+{
+    return { 0.f, 0.f, m_columns * m_tileSize.x, m_rows * m_tileSize.y };
+}
+
+SceneNode* TileGrid::getTile(int column, int row) const
+{
+    if (column < 0 || column >= m_columns || row < 0 || row >= m_rows)
+    {
+        return nullptr;
+    }
+    return m_tiles[row * m_columns + column];
+}
@@ -4,10 +4,8 @@
 
 Entity::Entity(RenderLayers layer)
 : SceneNode(layer)
-, m_velocity{ 0.f }
-, m_currentVelocity{ 0.f }
-, m_mass{ 0.f }
-, m_currentDirection{ 0.f, 0.f }
+, m_store{ EntityStore::getCurrent() }
+, m_storeHandle{ m_store.add(*this) }
 , m_width{ 0.f }
 , m_height{ 0.f }
 {
@@ -16,47 +14,52 @@ Entity::Entity(RenderLayers layer)
 
 Entity::~Entity()
 {
-
+    m_store.remove(m_storeHandle);
 }
 
 void Entity::setVelocity(float velocity)
 {
-    m_velocity = velocity;
+    m_store.setVelocity(m_storeHandle, velocity);
 }
 
 float Entity::getVelocity() const
 {
-    return m_velocity;
+    return m_store.getVelocity(m_storeHandle);
 }
 
 void Entity::setCurrentVelocity(float currentVelocity)
 {
-    m_currentVelocity = currentVelocity;
+    m_store.setCurrentVelocity(m_storeHandle, currentVelocity);
 }
 
 float Entity::getCurrentVelocity() const
 {
-    return m_currentVelocity;
+    return m_store.getCurrentVelocity(m_storeHandle);
 }
 
 void Entity::setCurrentDirection(sf::Vector2f currentDirection)
 {
-    m_currentDirection = currentDirection;
+    m_store.setDirection(m_storeHandle, currentDirection);
 }
 
 float Entity::getMass() const
 {
-    return m_mass;
+    return m_store.getMass(m_storeHandle);
 }
 
 void Entity::setMass(float mass)
 {
-    m_mass = mass;
+    m_store.setMass(m_storeHandle, mass);
 }
 
 sf::Vector2f Entity::getCurrentDirection() const
 {
-    return m_currentDirection;
+    return m_store.getDirection(m_storeHandle);
+}
+
+void Entity::setIsMovingByItself(bool isMovingByItself)
+{
+    m_store.setIsIntegrated(m_storeHandle, isMovingByItself);
 }
 
 float Entity::getWidth() const
@@ -86,7 +89,8 @@ void Entity::moveInActualDirection(const float length)
     {
         return;
     }
-    sf::Vector2f normalizedDir = { Calc::normalizeVec2<sf::Vector2f>(m_currentDirection) };
+    sf::Vector2f normalizedDir = { 
+        Calc::normalizeVec2<sf::Vector2f>(getCurrentDirection()) };
     move(normalizedDir.x * length, normalizedDir.y * length);
 }
 
@@ -109,7 +113,8 @@ sf::Vector2f Entity::getWorldCenterPosition() const
 
 void Entity::updateCurrent(float dt)
 {
-    moveInActualDirection(dt * m_velocity);
+    // The movement with the velocity is done by the EntityStore for all 
+    // entities at once
     /*
     m_currentVelocity.x = 0.f;
     m_currentVelocity.y = 0.f;
@@ -126,3 +131,15 @@ void Entity::onCommandCurrent(const Command &command, float dt)
 {
 
 }
+
+void Entity::saveCurrentState(BinaryWriter &writer) const
+{
+    SceneNode::saveCurrentState(writer);
+    m_store.saveEntity(m_storeHandle, writer);
+}
+
+void Entity::loadCurrentState(BinaryReader &reader)
+{
+    SceneNode::loadCurrentState(reader);
+    m_store.loadEntity(m_storeHandle, reader);
+}
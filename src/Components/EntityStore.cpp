@@ -0,0 +1,254 @@
+#include "Components/EntityStore.hpp"
+#include "Components/Entity.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+thread_local EntityStore *EntityStore::currentStore{ nullptr };
+
+EntityStore::Scope::Scope(EntityStore &store)
+: m_previousStore{ currentStore }
+{
+    currentStore = &store;
+}
+
+EntityStore::Scope::~Scope()
+{
+    currentStore = m_previousStore;
+}
+
+EntityStore& EntityStore::getCurrent()
+{
+    assert(currentStore && "Entities can only be created in a scope");
+    return *currentStore;
+}
+
+EntityStore::Handle EntityStore::add(Entity &entity)
+{
+    Handle handle{ m_indices.size() };
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
+    {
+        m_indices.push_back(0);
+    }
+    m_indices[handle] = m_entities.size();
+    m_handles.push_back(handle);
+    m_entities.push_back(&entity);
+    m_directionX.push_back(0.f);
+    m_directionY.push_back(0.f);
+    m_velocity.push_back(0.f);
+    m_currentVelocity.push_back(0.f);
+    m_mass.push_back(0.f);
+    m_isIntegrated.push_back(true);
+    m_health.push_back(0.f);
+    m_maxHealth.push_back(0.f);
+    m_stamina.push_back(0.f);
+    m_maxStamina.push_back(0.f);
+    m_staminaRate.push_back(0.f);
+    return handle;
+}
+
+void EntityStore::remove(Handle handle)
+{
+    assert(handle < m_indices.size());
+    const std::size_t Index{ m_indices[handle] };
+    const std::size_t Last{ m_entities.size() - 1 };
+    // Move the last entity into the free slot
+    m_handles[Index] = m_handles[Last];
+    m_entities[Index] = m_entities[Last];
+    m_directionX[Index] = m_directionX[Last];
+    m_directionY[Index] = m_directionY[Last];
+    m_velocity[Index] = m_velocity[Last];
+    m_currentVelocity[Index] = m_currentVelocity[Last];
+    m_mass[Index] = m_mass[Last];
+    m_isIntegrated[Index] = m_isIntegrated[Last];
+    m_health[Index] = m_health[Last];
+    m_maxHealth[Index] = m_maxHealth[Last];
+    m_stamina[Index] = m_stamina[Last];
+    m_maxStamina[Index] = m_maxStamina[Last];
+    m_staminaRate[Index] = m_staminaRate[Last];
+    m_indices[m_handles[Index]] = Index;
+
+    m_handles.pop_back();
+    m_entities.pop_back();
+    m_directionX.pop_back();
+    m_directionY.pop_back();
+    m_velocity.pop_back();
+    m_currentVelocity.pop_back();
+    m_mass.pop_back();
+    m_isIntegrated.pop_back();
+    m_health.pop_back();
+    m_maxHealth.pop_back();
+    m_stamina.pop_back();
+    m_maxStamina.pop_back();
+    m_staminaRate.pop_back();
+    m_freeHandles.push_back(handle);
+}
+
+std::size_t EntityStore::getEntityCnt() const
+{
+    return m_entities.size();
+}
+
+sf::Vector2f EntityStore::getDirection(Handle handle) const
+{
+    const std::size_t Index{ m_indices[handle] };
+    return { m_directionX[Index], m_directionY[Index] };
+}
+
+void EntityStore::setDirection(Handle handle, sf::Vector2f direction)
+{
+    const std::size_t Index{ m_indices[handle] };
+    m_directionX[Index] = direction.x;
+    m_directionY[Index] = direction.y;
+}
+
+float EntityStore::getVelocity(Handle handle) const
+{
+    return m_velocity[m_indices[handle]];
+}
+
+void EntityStore::setVelocity(Handle handle, float velocity)
+{
+    m_velocity[m_indices[handle]] = velocity;
+}
+
+float EntityStore::getCurrentVelocity(Handle handle) const
+{
+    return m_currentVelocity[m_indices[handle]];
+}
+
+void EntityStore::setCurrentVelocity(Handle handle, float currentVelocity)
+{
+    m_currentVelocity[m_indices[handle]] = currentVelocity;
+}
+
+float EntityStore::getMass(Handle handle) const
+{
+    return m_mass[m_indices[handle]];
+}
+
+void EntityStore::setMass(Handle handle, float mass)
+{
+    m_mass[m_indices[handle]] = mass;
+}
+
+bool EntityStore::isIntegrated(Handle handle) const
+{
+    return m_isIntegrated[m_indices[handle]] != 0;
+}
+
+void EntityStore::setIsIntegrated(Handle handle, bool isIntegrated)
+{
+    m_isIntegrated[m_indices[handle]] = isIntegrated;
+}
+
+float EntityStore::getHealth(Handle handle) const
+{
+    return m_health[m_indices[handle]];
+}
+
+void EntityStore::setHealth(Handle handle, float health)
+{
+    m_health[m_indices[handle]] = health;
+}
+
+float EntityStore::getMaxHealth(Handle handle) const
+{
+    return m_maxHealth[m_indices[handle]];
+}
+
+void EntityStore::setMaxHealth(Handle handle, float maxHealth)
+{
+    m_maxHealth[m_indices[handle]] = maxHealth;
+}
+
+float EntityStore::getStamina(Handle handle) const
+{
+    return m_stamina[m_indices[handle]];
+}
+
+void EntityStore::setStamina(Handle handle, float stamina)
+{
+    m_stamina[m_indices[handle]] = stamina;
+}
+
+float EntityStore::getMaxStamina(Handle handle) const
+{
+    return m_maxStamina[m_indices[handle]];
+}
+
+void EntityStore::setMaxStamina(Handle handle, float maxStamina)
+{
+    m_maxStamina[m_indices[handle]] = maxStamina;
+}
+
+void EntityStore::setStaminaRate(Handle handle, float staminaRate)
+{
+    m_staminaRate[m_indices[handle]] = staminaRate;
+}
+
+void EntityStore::saveEntity(Handle handle, BinaryWriter &writer) const
+{
+    const std::size_t Index{ m_indices[handle] };
+    writer.writeFloat(m_directionX[Index]);
+    writer.writeFloat(m_directionY[Index]);
+    writer.writeFloat(m_velocity[Index]);
+    writer.writeFloat(m_currentVelocity[Index]);
+    writer.writeBool(m_isIntegrated[Index] != 0);
+    writer.writeFloat(m_health[Index]);
+    writer.writeFloat(m_stamina[Index]);
+    writer.writeFloat(m_staminaRate[Index]);
+}
+
+void EntityStore::loadEntity(Handle handle, BinaryReader &reader)
+{
+    const std::size_t Index{ m_indices[handle] };
+    m_directionX[Index] = reader.readFloat();
+    m_directionY[Index] = reader.readFloat();
+    m_velocity[Index] = reader.readFloat();
+    m_currentVelocity[Index] = reader.readFloat();
+    m_isIntegrated[Index] = reader.readBool() ? 1 : 0;
+    m_health[Index] = reader.readFloat();
+    m_stamina[Index] = reader.readFloat();
+    m_staminaRate[Index] = reader.readFloat();
+}
+
+void EntityStore::integrateMovement(float dt)
+{
+    const std::size_t EntityCnt{ m_entities.size() };
+    for (std::size_t i{ 0 }; i < EntityCnt; i++)
+    {
+        // Most entities (e.g. the level tiles) have no velocity
+        if (!m_isIntegrated[i] || m_velocity[i] <= 0.f)
+        {
+            continue;
+        }
+        const float LengthSq{ m_directionX[i] * m_directionX[i] + 
+            m_directionY[i] * m_directionY[i] };
+        if (LengthSq <= 0.f)
+        {
+            continue;
+        }
+        // Normalize the direction and scale it with the way of this frame
+        const float Scale{ m_velocity[i] * dt / std::sqrt(LengthSq) };
+        m_entities[i]->move(m_directionX[i] * Scale, m_directionY[i] * Scale);
+    }
+}
+
+void EntityStore::regenerateStamina(float dt)
+{
+    // Entities without stamina have a max stamina and rate of 0
+    const std::size_t EntityCnt{ m_entities.size() };
+    for (std::size_t i{ 0 }; i < EntityCnt; i++)
+    {
+        m_stamina[i] = std::min(m_maxStamina[i], 
+                m_stamina[i] + m_staminaRate[i] * dt);
+    }
+}
@@ -4,13 +4,15 @@
 #include "Collision/CollisionRect.hpp"
 #include "Collision/CollisionHandler.hpp"
 #include "Calc.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 #include <iostream>
 
-Knight::Knight(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, const int health, const std::string &textureId,
+Knight::Knight(RenderLayers layer, const WarriorArchetype &archetype, SoundPlayer &sound, const int health, const std::string &textureId,
         const ResourceHolder<sf::Texture> &textureHolder,
         const SpriteSheetMapHolder &spriteSheetMapHolder, 
         std::vector<Warrior*> &possibleTargetsInWord)
-: Warrior(layer, config, sound, health, textureId, textureHolder, spriteSheetMapHolder, 
+: Warrior(layer, archetype, sound, health, textureId, textureHolder, spriteSheetMapHolder, 
         possibleTargetsInWord)
 , m_animCloseAttack{ nullptr, false }
 , m_WeaponDamage{ 30.f }
@@ -37,7 +39,7 @@ Knight::Knight(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, co
         stopCloseAttack();
     });
     
-    std::unique_ptr<Weapon> sword(new Weapon(RenderLayers::WEAPON, m_WeaponDamage, 
+    NodePtr<Weapon> sword(NodeArena::create<Weapon>(RenderLayers::WEAPON, m_WeaponDamage, 
                 textureHolder.get(textureId), 
                 spriteSheetMapHolder.getRectData(textureId, "sword")));
     sword->setOrigin(0.f, -10.f);
@@ -48,7 +50,7 @@ Knight::Knight(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, co
     attachChild(std::move(sword));
     
 
-    std::unique_ptr<Item> shield(new Item(RenderLayers::WEAPON, 
+    NodePtr<Item> shield(NodeArena::create<Item>(RenderLayers::WEAPON, 
                 textureHolder.get(textureId), 
                 spriteSheetMapHolder.getRectData(textureId, "shield")));
     shield->addType(WorldObjectTypes::SHIELD);
@@ -91,6 +93,8 @@ void Knight::drawCurrent(sf::RenderTarget &target, sf::RenderStates states) cons
 
 void Knight::updateCurrent(float dt)
 {
+    // The stanima is not filled up during the strong attack
+    setIsStanimaRegenerating(!m_isStrongAttackRunning);
     if(m_isStrongAttackRunning) 
     {
         m_curStrongAttackTime += dt;
@@ -125,9 +129,8 @@ void Knight::onCommandCurrent(const Command &command, float dt)
     Warrior::onCommandCurrent(command, dt);
     if (command.getWorldObjectType() & m_type)
     {
-        m_currentVelocity = 0.f;
-        m_currentDirection.x = 0.f;
-        m_currentDirection.y = 0.f;
+        setCurrentVelocity(0.f);
+        setCurrentDirection({ 0.f, 0.f });
         switch (command.getCommandType())
         {
             case CommandTypes::ACTION_1:
@@ -146,7 +149,7 @@ void Knight::onCommandCurrent(const Command &command, float dt)
                 break;
 
         }
-        moveInActualDirection(m_currentVelocity * dt);
+        moveInActualDirection(getCurrentVelocity() * dt);
     }
 }
 
@@ -168,10 +171,11 @@ void Knight::updateAI(float dt)
     else
     {
         // Follow target
-        m_currentVelocity = m_velocity;
-        m_currentDirection = m_actualTarget->getWorldPosition() - getWorldPosition();
+        setCurrentVelocity(getVelocity());
+        setCurrentDirection(
+                m_actualTarget->getWorldPosition() - getWorldPosition());
         m_isMoving = true;
-        moveInActualDirection(m_currentVelocity * dt);
+        moveInActualDirection(getCurrentVelocity() * dt);
     }
 }
 
@@ -179,14 +183,14 @@ void Knight::startCloseAttack()
 {
     if (m_weapon && !m_animCloseAttack.isRunning() &&
             !isBlocking() &&
-            m_currentStamina >= m_closeAttackStanima)
+            getCurrentStanima() >= m_closeAttackStanima)
     {
         m_animCloseAttack.start();
         m_weapon->setIsCollisionCheckOn(true);
         m_weapon->setDamageMultiplicator(m_closeAttackDamageMul);
         m_weapon->startNewAttack();
         removeStanima(m_closeAttackStanima);
-        m_sound.play("swoosh1");
+        m_sound.play("swoosh1", getWorldPosition());
     }
 }
 
@@ -200,7 +204,7 @@ void Knight::stopCloseAttack()
 
 void Knight::startStrongAttack()
 {
-    if (m_weapon && m_currentStamina >= m_strongAttackStanima)
+    if (m_weapon && getCurrentStanima() >= m_strongAttackStanima)
     {
         m_isStrongAttackRunning = true;
         m_curStrongAttackTime = 0.f;
@@ -212,7 +216,7 @@ void Knight::startStrongAttack()
         m_weapon->startNewAttack();
         removeStanima(m_strongAttackStanima);
         startBlocking();
-        m_sound.play("slashkut");
+        m_sound.play("slashkut", getWorldPosition());
     }
 }
 
@@ -275,3 +279,23 @@ void Knight::handleDamage(Weapon *weapon)
         Warrior::handleDamage(weapon);
     }
 }
+
+void Knight::saveCurrentState(BinaryWriter &writer) const
+{
+    Warrior::saveCurrentState(writer);
+    m_animCloseAttack.saveState(writer);
+    writer.writeBool(m_isStrongAttackRunning);
+    writer.writeFloat(m_curStrongAttackTime);
+    writer.writeFloat(m_strongAttackDir.x);
+    writer.writeFloat(m_strongAttackDir.y);
+}
+
+void Knight::loadCurrentState(BinaryReader &reader)
+{
+    Warrior::loadCurrentState(reader);
+    m_animCloseAttack.loadState(reader);
+    m_isStrongAttackRunning = reader.readBool();
+    m_curStrongAttackTime = reader.readFloat();
+    m_strongAttackDir.x = reader.readFloat();
+    m_strongAttackDir.y = reader.readFloat();
+}
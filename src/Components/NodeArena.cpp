@@ -0,0 +1,113 @@
+#include "Components/NodeArena.hpp"
+#include "Components/SceneNode.hpp"
+#include <cassert>
+
+thread_local NodeArena *NodeArena::currentArena{ nullptr };
+
+NodeDeleter::NodeDeleter()
+: arena{ nullptr }
+, size{ 0 }
+{
+
+}
+
+NodeDeleter::NodeDeleter(NodeArena *arena, std::size_t size)
+: arena{ arena }
+, size{ size }
+{
+
+}
+
+void NodeDeleter::operator()(SceneNode *node) const
+{
+    if (!arena)
+    {
+        delete node;
+        return;
+    }
+    // The pointer can point to a base part of the node, the memory begins at
+    // the most derived object
+    void *memory{ dynamic_cast<void*>(node) };
+    node->~SceneNode();
+    arena->deallocate(memory, size);
+}
+
+NodeArena::Scope::Scope(NodeArena &arena)
+: m_previousArena{ currentArena }
+{
+    currentArena = &arena;
+}
+
+NodeArena::Scope::~Scope()
+{
+    currentArena = m_previousArena;
+}
+
+NodeArena::NodeArena()
+: m_chunkPos{ nullptr }
+, m_chunkEnd{ nullptr }
+, m_freeLists(MAX_NODE_SIZE / GRANULARITY, nullptr)
+, m_usedBytes{ 0 }
+{
+
+}
+
+NodeArena::~NodeArena()
+{
+    // All nodes have to be destroyed before, otherwise they would point into
+    // freed memory
+    assert(m_usedBytes == 0);
+    for (char *chunk : m_chunks)
+    {
+        ::operator delete(chunk);
+    }
+}
+
+void* NodeArena::allocate(std::size_t size)
+{
+    const std::size_t BlockSize{ getBlockSize(size) };
+    m_usedBytes += BlockSize;
+    FreeBlock *&freeList{ m_freeLists[BlockSize / GRANULARITY - 1] };
+    if (freeList)
+    {
+        FreeBlock *block{ freeList };
+        freeList = block->next;
+        return block;
+    }
+    if (!m_chunkPos || m_chunkPos + BlockSize > m_chunkEnd)
+    {
+        // The rest of the old chunk is lost, but it is smaller than a node
+        char *chunk{ static_cast<char*>(::operator new(CHUNK_SIZE)) };
+        m_chunks.push_back(chunk);
+        m_chunkPos = chunk;
+        m_chunkEnd = chunk + CHUNK_SIZE;
+    }
+    void *memory{ m_chunkPos };
+    m_chunkPos += BlockSize;
+    return memory;
+}
+
+void NodeArena::deallocate(void *ptr, std::size_t size)
+{
+    const std::size_t BlockSize{ getBlockSize(size) };
+    m_usedBytes -= BlockSize;
+    FreeBlock *block{ static_cast<FreeBlock*>(ptr) };
+    FreeBlock *&freeList{ m_freeLists[BlockSize / GRANULARITY - 1] };
+    block->next = freeList;
+    freeList = block;
+}
+
+std::size_t NodeArena::getUsedBytes() const
+{
+    return m_usedBytes;
+}
+
+std::size_t NodeArena::getChunkCnt() const
+{
+    return m_chunks.size();
+}
+
+std::size_t NodeArena::getBlockSize(std::size_t size)
+{
+    return (size + GRANULARITY - 1) / GRANULARITY * GRANULARITY;
+}
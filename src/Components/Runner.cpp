@@ -4,14 +4,16 @@
 #include "Collision/CollisionRect.hpp"
 #include "Collision/CollisionHandler.hpp"
 #include "Calc.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 #include <iostream>
 
-Runner::Runner(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, const int health, 
+Runner::Runner(RenderLayers layer, const WarriorArchetype &archetype, SoundPlayer &sound, const int health, 
         const std::string &textureId,
         const ResourceHolder<sf::Texture> &textureHolder,
         const SpriteSheetMapHolder &spriteSheetMapHolder, 
         std::vector<Warrior*> &possibleTargetsInWord)
-: Warrior(layer, config, sound, health, textureId, textureHolder, spriteSheetMapHolder, 
+: Warrior(layer, archetype, sound, health, textureId, textureHolder, spriteSheetMapHolder, 
         possibleTargetsInWord)
 , m_animCloseAttack( nullptr, false )
 // Close Attack
@@ -45,7 +47,7 @@ Runner::Runner(RenderLayers layer, ConfigManager &config, SoundPlayer &sound, co
         stopCloseAttack();
     });
 
-    std::unique_ptr<Weapon> sword(new Weapon(RenderLayers::WEAPON, 10.f, 
+    NodePtr<Weapon> sword(NodeArena::create<Weapon>(RenderLayers::WEAPON, 10.f, 
                 textureHolder.get(textureId), 
                 spriteSheetMapHolder.getRectData(textureId, "sword")));
     sword->setPosition(0.f, 0.f);
@@ -78,6 +80,8 @@ void Runner::drawCurrent(sf::RenderTarget &target, sf::RenderStates states) cons
 
 void Runner::updateCurrent(float dt)
 {
+    // The stanima is not filled up during the special attacks
+    setIsStanimaRegenerating(!m_isDodging && !m_isRoundAttacking);
     if(m_isDodging) 
     {
         m_curDodgeTime += dt;
@@ -119,9 +123,8 @@ void Runner::onCommandCurrent(const Command &command, float dt)
     Warrior::onCommandCurrent(command, dt);
     if (command.getWorldObjectType() & m_type)
     {
-        m_currentVelocity = 0.f;
-        m_currentDirection.x = 0.f;
-        m_currentDirection.y = 0.f;
+        setCurrentVelocity(0.f);
+        setCurrentDirection({ 0.f, 0.f });
         switch (command.getCommandType())
         {
             case CommandTypes::ACTION_1:
@@ -137,7 +140,7 @@ void Runner::onCommandCurrent(const Command &command, float dt)
                 break;
 
         }
-        moveInActualDirection(m_currentVelocity * dt);
+        moveInActualDirection(getCurrentVelocity() * dt);
     }
 }
 
@@ -153,17 +156,19 @@ void Runner::updateAI(float dt)
     lookAt(m_actualTarget->getPosition());
     CollisionInfo collisionInfo = 
         m_closeCombatArea->isColliding(*m_actualTarget->getCollisionShape());
-    if (collisionInfo.isCollision())
+    // Dont attack through walls
+    if (collisionInfo.isCollision() && isInLineOfSight(*m_actualTarget))
     {
         startCloseAttack();
     }
     else
     {
         // Follow target
-        m_currentVelocity = m_velocity;
-        m_currentDirection = m_actualTarget->getWorldPosition() - getWorldPosition();
+        setCurrentVelocity(getVelocity());
+        setCurrentDirection(
+                m_actualTarget->getWorldPosition() - getWorldPosition());
         m_isMoving = true;
-        moveInActualDirection(m_currentVelocity * dt);
+        moveInActualDirection(getCurrentVelocity() * dt);
     }
 }
 
@@ -192,14 +197,14 @@ void Runner::makeInTransparent()
 void Runner::startCloseAttack()
 {
     if (m_weapon && !m_animCloseAttack.isRunning() && 
-            m_currentStamina >= m_closeAttackStanima)
+            getCurrentStanima() >= m_closeAttackStanima)
     {
         m_animCloseAttack.start();
         m_weapon->setIsCollisionCheckOn(true);
         m_weapon->setDamageMultiplicator(m_closeAttackDamageMul);
         m_weapon->startNewAttack();
         removeStanima(m_closeAttackStanima);
-        m_sound.play("swoosh1");
+        m_sound.play("swoosh1", getWorldPosition());
     }
 }
 
@@ -214,7 +219,7 @@ void Runner::stopCloseAttack()
 void Runner::startRoundAttack()
 {
     if (!m_isDodging && !m_isRoundAttacking && 
-            m_currentStamina >= m_roundAttackStanima && m_weapon)
+            getCurrentStanima() >= m_roundAttackStanima && m_weapon)
     {
         m_isRoundAttacking = true;
         m_roundAttackCurRot = 0.f;
@@ -224,7 +229,7 @@ void Runner::startRoundAttack()
         m_weapon->setDamageMultiplicator(m_roundAttackDamageMul);
         m_weapon->startNewAttack();
         removeStanima(m_roundAttackStanima);
-        m_sound.play("swoosh-long");
+        m_sound.play("swoosh-long", getWorldPosition());
     }
 }
 
@@ -237,7 +242,7 @@ void Runner::stopRoundAttack()
 
 void Runner::startDodging()
 {
-    if (!m_isRoundAttacking && m_currentStamina >= m_dodgeStanima)
+    if (!m_isRoundAttacking && getCurrentStanima() >= m_dodgeStanima)
     {
         makeTransparent();
         // Only should collide with level objects
@@ -247,7 +252,7 @@ void Runner::startDodging()
         // The dodge direction is the direction where the runner looking at
         m_dodgeDir = Calc::degAngleToDirectionVector(getRotation() + 90.f);
         removeStanima(m_dodgeStanima);
-        m_sound.play("dodge");
+        m_sound.play("dodge", getWorldPosition());
     }
 }
 
@@ -262,3 +267,29 @@ void Runner::weaponAdded()
 {
     m_animCloseAttack.setParent(m_weapon);
 }
+
+void Runner::saveCurrentState(BinaryWriter &writer) const
+{
+    Warrior::saveCurrentState(writer);
+    m_animCloseAttack.saveState(writer);
+    writer.writeBool(m_isRoundAttacking);
+    writer.writeFloat(m_roundAttackCurRot);
+    writer.writeFloat(m_startRotationRoundAttack);
+    writer.writeBool(m_isDodging);
+    writer.writeFloat(m_curDodgeTime);
+    writer.writeFloat(m_dodgeDir.x);
+    writer.writeFloat(m_dodgeDir.y);
+}
+
+void Runner::loadCurrentState(BinaryReader &reader)
+{
+    Warrior::loadCurrentState(reader);
+    m_animCloseAttack.loadState(reader);
+    m_isRoundAttacking = reader.readBool();
+    m_roundAttackCurRot = reader.readFloat();
+    m_startRotationRoundAttack = reader.readFloat();
+    m_isDodging = reader.readBool();
+    m_curDodgeTime = reader.readFloat();
+    m_dodgeDir.x = reader.readFloat();
+    m_dodgeDir.y = reader.readFloat();
+}
@@ -1,10 +1,16 @@
 #include "Components/SceneNode.hpp"
+#include "Jobs/DeferredActions.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Render/RenderSnapshot.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 
 SceneNode::SceneNode()
-: m_layer{ RenderLayers::NONE }
+: m_nodeId{ createNodeId() }
+, m_layer{ RenderLayers::NONE }
 , m_parent{ nullptr }
 , m_collisionShape{ nullptr }
 , m_collisionWhiteList{ WorldObjectTypes::NONE }
@@ -12,6 +18,11 @@ SceneNode::SceneNode()
 , m_status{ WorldObjectStatus::ALIVE }
 , m_isActive{ true }
 , m_isCollisionCheckOn{ true }
+, m_contactEpoch{ 0 }
+, m_lastPos{ getPosition() }
+, m_lastRot{ getRotation() }
+, m_lastScal{ getScale() }
+, m_hasLastTransform{ false }
 {
 
 }
@@ -29,7 +40,8 @@ SceneNode::SceneNode(bool isRoot)
 */
 
 SceneNode::SceneNode(RenderLayers layer)
-: m_layer{ layer }
+: m_nodeId{ createNodeId() }
+, m_layer{ layer }
 , m_parent{ nullptr }
 , m_collisionShape{ nullptr }
 , m_collisionWhiteList{ WorldObjectTypes::NONE }
@@ -37,12 +49,18 @@ SceneNode::SceneNode(RenderLayers layer)
 , m_status{ WorldObjectStatus::ALIVE }
 , m_isActive{ true }
 , m_isCollisionCheckOn{ true }
+, m_contactEpoch{ 0 }
+, m_lastPos{ getPosition() }
+, m_lastRot{ getRotation() }
+, m_lastScal{ getScale() }
+, m_hasLastTransform{ false }
 {
 
 }
 
 SceneNode::SceneNode(RenderLayers layer, WorldObjectTypes type)
-: m_layer{ layer }
+: m_nodeId{ createNodeId() }
+, m_layer{ layer }
 , m_parent{ nullptr }
 , m_collisionShape{ nullptr }
 , m_collisionWhiteList{ WorldObjectTypes::NONE }
@@ -50,6 +68,11 @@ SceneNode::SceneNode(RenderLayers layer, WorldObjectTypes type)
 , m_status{ WorldObjectStatus::ALIVE }
 , m_isActive{ true }
 , m_isCollisionCheckOn{ true }
+, m_contactEpoch{ 0 }
+, m_lastPos{ getPosition() }
+, m_lastRot{ getRotation() }
+, m_lastScal{ getScale() }
+, m_hasLastTransform{ false }
 {
 
 }
@@ -69,9 +92,30 @@ const std::string& SceneNode::getDebugName() const
     return m_debugName;
 }
 
+unsigned int SceneNode::getNodeId() const
+{
+    return m_nodeId;
+}
+
+RenderLayers SceneNode::getLayer() const
+{
+    return m_layer;
+}
+
+unsigned int SceneNode::createNodeId()
+{
+    static unsigned int nodeCnt{ 0 };
+    nodeCnt++;
+    return nodeCnt;
+}
+
 void SceneNode::attachChild(Ptr child)
 {
     child->m_parent = this;
+    // The child was not moved since it was attached, so the last transform is
+    // the actual one (Is needed for the continuous collision detection)
+    child->safeTransform();
+    child->m_hasLastTransform = false;
     m_children.push_back(std::move(child));
 }
 
@@ -141,6 +185,30 @@ void SceneNode::drawCurrent(sf::RenderTarget &target, sf::RenderStates states) c
     //Do nothing by default
 }
 
+void SceneNode::addToRenderSnapshot(RenderSnapshot &snapshot, 
+        std::size_t parent) const
+{
+    // Without a last transform the node is drawn where it is now
+    const std::size_t Node{ m_hasLastTransform ? 
+        snapshot.addNode({ parent, getOrigin(), 
+                m_lastPos, m_lastRot, m_lastScal, 
+                getPosition(), getRotation(), getScale() }) :
+        snapshot.addNode({ parent, getOrigin(), 
+                getPosition(), getRotation(), getScale(), 
+                getPosition(), getRotation(), getScale() }) };
+    addCurrentToRenderSnapshot(snapshot, Node);
+    for (const Ptr &child : m_children)
+    {
+        child->addToRenderSnapshot(snapshot, Node);
+    }
+}
+
+void SceneNode::addCurrentToRenderSnapshot(RenderSnapshot &snapshot, 
+        std::size_t node) const
+{
+    // Nothing to draw by default
+}
+
 void SceneNode::drawCollisionShape(sf::RenderTarget &target, sf::RenderStates states) const
 {
     // Only draw collision shape when it is not nullptr
@@ -164,6 +232,41 @@ void SceneNode::update(float dt)
     updateChildren(dt);
 }
 
+void SceneNode::updateParallel(float dt, JobSystem &jobSystem, 
+        DeferredActions &deferredActions, 
+        std::vector<std::size_t> &parallelChildren)
+{
+    updateCurrent(dt);
+    parallelChildren.clear();
+    for (std::size_t i{ 0 }; i < m_children.size(); i++)
+    {
+        if (m_children[i]->canUpdateInParallel())
+        {
+            parallelChildren.push_back(i);
+        }
+        else
+        {
+            DeferredActions::Scope scope{ deferredActions, i };
+            m_children[i]->update(dt);
+        }
+    }
+    // Most children are cheap to update (e.g. the tiles), so use batches
+    jobSystem.parallelFor(parallelChildren.size(), 16, 
+            [this, dt, &deferredActions, &parallelChildren] (std::size_t i)
+            {
+                const std::size_t ChildIndex{ parallelChildren[i] };
+                // The index of the child is the order of its actions, so they
+                // are executed in the same order as in the serial update
+                DeferredActions::Scope scope{ deferredActions, ChildIndex };
+                m_children[ChildIndex]->update(dt);
+            });
+}
+
+bool SceneNode::canUpdateInParallel() const
+{
+    return true;
+}
+
 void SceneNode::updateCurrent(float dt)
 {
     // Do nothing by default
@@ -277,6 +380,16 @@ bool SceneNode::isCollisionCheckOn() const
     return m_isCollisionCheckOn;
 }
 
+unsigned int SceneNode::getContactEpoch() const
+{
+    return m_contactEpoch;
+}
+
+void SceneNode::startNewContactEpoch()
+{
+    m_contactEpoch++;
+}
+
 void SceneNode::setIsCollisionCheckOn(bool isCollisionCheckOn)
 {
     m_isCollisionCheckOn = isCollisionCheckOn;
@@ -298,18 +411,27 @@ bool SceneNode::isMarkedForRemoval() const
 }
 
 CollisionInfo SceneNode::isColliding(SceneNode &node) const
+{
+    if (!canCollideWith(node))
+    {
+        return CollisionInfo(false);
+    }
+    return m_collisionShape->isColliding(*node.getCollisionShape());
+}
+
+bool SceneNode::canCollideWith(const SceneNode &node) const
 {
     // When there are types whitelisted only check collision if there collide
     // whitelisted types
     if (getCollisionWhiteList() != 0 && 
             (getCollisionWhiteList() & node.getType()) == 0)
     {
-        return CollisionInfo(false);
+        return false;
     }
     if (node.getCollisionWhiteList() != 0 && 
             (node.getCollisionWhiteList() & getType()) == 0)
     {
-        return CollisionInfo(false);
+        return false;
     }
     // If there is no collision shape specified there can not be a collision and if 
     // the collision is not on by one of the two SceneNodesm there can be no 
@@ -320,69 +442,34 @@ CollisionInfo SceneNode::isColliding(SceneNode &node) const
         !node.isCollisionCheckOn() || 
         m_status == WorldObjectStatus::DESTORYED)
     {
-        return CollisionInfo(false);
+        return false;
     }
-    return m_collisionShape->isColliding(*node.getCollisionShape());
-}
-
-void SceneNode::checkSceneCollision(SceneNode &sceneGraph, std::vector<CollisionInfo> &collisionData)
-{
-    // Store the collisionPairs, so we can later check if the same collision is 
-    // already stored, so we only store the Collision information once.
-    std::set<Pair> collisionPairs;
-    checkSceneCollision(sceneGraph, collisionPairs, collisionData);
+    return true;
 }
 
-void SceneNode::checkSceneCollision(SceneNode &sceneGraph, std::set<Pair> &collisionPairs, std::vector<CollisionInfo> &collisionData)
+void SceneNode::collectCollisionNodes(std::vector<SceneNode*> &nodes)
 {
-    checkNodeCollision(sceneGraph, collisionPairs, collisionData);
-
-    for (Ptr &child: sceneGraph.m_children)
+    if (m_collisionShape && m_isCollisionCheckOn && 
+            m_status != WorldObjectStatus::DESTORYED)
     {
-        checkSceneCollision(*child, collisionPairs, collisionData);
+        nodes.push_back(this);
+    }
+    for (const Ptr &child : m_children)
+    {
+        child->collectCollisionNodes(nodes);
     }
-
 }
 
-void SceneNode::checkNodeCollision(SceneNode &node, std::set<Pair> &collisionPairs, std::vector<CollisionInfo> &collisionData)
+void SceneNode::collectNodes(std::vector<SceneNode*> &nodes)
 {
-    // If the actual SceneNode is passive we dont have to check if it colliding with
-    // something.
-    // If the other node is active it will check if it is colliding with this node.
-    if (this != &node && m_isActive)
+    if (m_status == WorldObjectStatus::DESTORYED)
     {
-
-        // std::minmax return always the same pair independent of the order of the 
-        // parameters, where the first is the smallest and the second the greater one
-        // (The smaller one have the lower address in this case). In std::set unique
-        // objects are stored as key and dont add a new key if there is already 
-        // the same so with std::minmax we ensure that we only store a collison once
-        // (a collides with b and b collisdes with a, but we only need to check the 
-        // collision between the two once). So when we store the SceneNodes between 
-        // the collison was checked, we dont have to check the collision twice
-        Pair sceneNodePair = std::minmax(this, &node);
-        auto inserted = collisionPairs.insert(sceneNodePair);
-        // Only check for collision when we dont have already check collision 
-        // between this pair of nodes. (When inserted is false, the pair was not 
-        // inserted in the set container, so we have already checked the collision 
-        // between them)
-        if (inserted.second)
-        {
-            CollisionInfo collisionInfo = { isColliding(node) };
-            if (collisionInfo.isCollision())
-            {
-                // Add collision information and SceneNodes to collisionData vector 
-                // only when the pair of SceneNodes were successfully added to 
-                // collisionPairs set, so we can ensure that we add the collision 
-                // only once.
-                collisionData.push_back(collisionInfo);
-            }
-        }
+        return;
     }
-
-    for (Ptr &child: m_children)
+    nodes.push_back(this);
+    for (const Ptr &child : m_children)
     {
-        child->checkNodeCollision(node, collisionPairs, collisionData);
+        child->collectNodes(nodes);
     }
 }
 
@@ -396,6 +483,87 @@ void SceneNode::removeDestroyed()
     std::for_each(m_children.begin(), m_children.end(), std::mem_fn(&SceneNode::removeDestroyed));
 }
 
+std::size_t SceneNode::getNodeCount() const
+{
+    std::size_t nodeCount{ 1 };
+    for (const Ptr &child : m_children)
+    {
+        nodeCount += child->getNodeCount();
+    }
+    return nodeCount;
+}
+
+void SceneNode::saveState(BinaryWriter &writer) const
+{
+    saveCurrentState(writer);
+}
+
+void SceneNode::loadState(BinaryReader &reader)
+{
+    loadCurrentState(reader);
+}
+
+void SceneNode::saveCurrentState(BinaryWriter &writer) const
+{
+    writer.writeUInt8(static_cast<std::uint8_t>(m_status));
+    writer.writeBool(m_isActive);
+    writer.writeBool(m_isCollisionCheckOn);
+    const sf::Vector2f Pos{ getPosition() };
+    const sf::Vector2f Scale{ getScale() };
+    writer.writeFloat(Pos.x);
+    writer.writeFloat(Pos.y);
+    writer.writeFloat(getRotation());
+    writer.writeFloat(Scale.x);
+    writer.writeFloat(Scale.y);
+    // Most nodes dont move, so the last transform is only written when it
+    // differs from the current one
+    const bool HasMoved{ m_hasLastTransform && (m_lastPos != Pos || 
+                m_lastRot != getRotation() || m_lastScal != Scale) };
+    writer.writeBool(HasMoved);
+    if (HasMoved)
+    {
+        writer.writeFloat(m_lastPos.x);
+        writer.writeFloat(m_lastPos.y);
+        writer.writeFloat(m_lastRot);
+        writer.writeFloat(m_lastScal.x);
+        writer.writeFloat(m_lastScal.y);
+    }
+}
+
+void SceneNode::loadCurrentState(BinaryReader &reader)
+{
+    m_status = static_cast<WorldObjectStatus>(reader.readUInt8());
+    m_isActive = reader.readBool();
+    m_isCollisionCheckOn = reader.readBool();
+    sf::Vector2f pos;
+    pos.x = reader.readFloat();
+    pos.y = reader.readFloat();
+    const float Rot{ reader.readFloat() };
+    sf::Vector2f scale;
+    scale.x = reader.readFloat();
+    scale.y = reader.readFloat();
+    // Set the transform directly, the overridden setRotation() of the items
+    // would rotate them around their rotation point
+    sf::Transformable::setPosition(pos);
+    sf::Transformable::setRotation(Rot);
+    sf::Transformable::setScale(scale);
+    if (reader.readBool())
+    {
+        m_lastPos.x = reader.readFloat();
+        m_lastPos.y = reader.readFloat();
+        m_lastRot = reader.readFloat();
+        m_lastScal.x = reader.readFloat();
+        m_lastScal.y = reader.readFloat();
+    }
+    else
+    {
+        m_lastPos = pos;
+        m_lastRot = Rot;
+        m_lastScal = scale;
+    }
+    m_hasLastTransform = true;
+}
+
 void SceneNode::safeTransform()
 {
     safeCurrentTransform();
@@ -415,6 +583,7 @@ void SceneNode::safeCurrentTransform()
     m_lastPos = getPosition();
     m_lastRot = getRotation();
     m_lastScal = getScale();
+    m_hasLastTransform = true;
 }
 
 void SceneNode::restoreLastTransform()
@@ -423,3 +592,18 @@ void SceneNode::restoreLastTransform()
     setRotation(m_lastRot);
     setScale(m_lastScal);
 }
+
+sf::Vector2f SceneNode::getLastPosition() const
+{
+    return m_lastPos;
+}
+
+sf::Vector2f SceneNode::getWorldDisplacement() const
+{
+    if (m_parent != nullptr)
+    {
+        const sf::Transform ParentTransform{ m_parent->getWorldTransform() };
+        return ParentTransform * getPosition() - ParentTransform * m_lastPos;
+    }
+    return getPosition() - m_lastPos;
+}
@@ -1,4 +1,7 @@
 #include "Components/SpriteNode.hpp"
+#include "Render/RenderSnapshot.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 #include <iostream>
 
 SpriteNode::SpriteNode(RenderLayers layer, const sf::Texture &texture, bool centerOrigin)
@@ -133,4 +136,51 @@ void SpriteNode::drawCurrent(sf::RenderTarget &target, sf::RenderStates states)
     target.draw(m_sprite, states);
 }
 
+void SpriteNode::addCurrentToRenderSnapshot(RenderSnapshot &snapshot, 
+        std::size_t node) const
+{
+    if (!m_sprite.getTexture())
+    {
+        return;
+    }
+    // The sprite has its own transform (e.g. the origin)
+    snapshot.addSprite({ getLayer(), m_sprite.getTexture(), 
+            m_sprite.getTextureRect(), m_sprite.getColor(), node, 
+            m_sprite.getTransform() });
+}
 
+
+
+void SpriteNode::saveCurrentState(BinaryWriter &writer) const
+{
+    Entity::saveCurrentState(writer);
+    writer.writeFloat(m_currentFrameTime);
+    writer.writeVarUInt(m_currentFrame);
+    // The color is changed by effects (e.g. healing or dodging)
+    const sf::Color Color{ m_sprite.getColor() };
+    writer.writeUInt8(Color.r);
+    writer.writeUInt8(Color.g);
+    writer.writeUInt8(Color.b);
+    writer.writeUInt8(Color.a);
+}
+
+void SpriteNode::loadCurrentState(BinaryReader &reader)
+{
+    Entity::loadCurrentState(reader);
+    m_currentFrameTime = reader.readFloat();
+    m_currentFrame = reader.readVarUInt();
+    sf::Color color;
+    color.r = reader.readUInt8();
+    color.g = reader.readUInt8();
+    color.b = reader.readUInt8();
+    color.a = reader.readUInt8();
+    m_sprite.setColor(color);
+    if (m_currentFrame < m_frameRects.size())
+    {
+        m_sprite.setTextureRect(m_frameRects[m_currentFrame]);
+    }
+    else
+    {
+        m_currentFrame = 0;
+    }
+}
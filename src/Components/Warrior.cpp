@@ -1,12 +1,16 @@
 #include "Components/Warrior.hpp"
 #include "Calc.hpp"
+#include "Collision/CollisionWorld.hpp"
 #include "Components/Weapon.hpp"
-#include "Config/ConfigManager.hpp"
+#include "Config/WarriorArchetype.hpp"
 #include "Helpers.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
-Warrior::Warrior(RenderLayers layer, const ConfigManager &config, 
+Warrior::Warrior(RenderLayers layer, const WarriorArchetype &archetype, 
         SoundPlayer &sound, 
         const float health, 
         const std::string &textureId, 
@@ -17,10 +21,6 @@ Warrior::Warrior(RenderLayers layer, const ConfigManager &config,
 , m_sound{ sound }
 , m_textureHolder{ textureHolder }
 , m_spriteSheetMapHolder{ spriteSheetMapHolder }
-, m_maxHealth{ health }
-, m_currentHealth{ health }
-, m_maxStamina{ 100.f }
-, m_currentStamina{ 100.f }
 , m_stanimaRefreshRate{ 5.f }
 , m_isMoving{ false }
 , m_isBlocking{ false }
@@ -35,24 +35,31 @@ Warrior::Warrior(RenderLayers layer, const ConfigManager &config,
 , m_isAiActive{ false }
 , m_possibleTargetsInWord{ possibleTargetsInWord }
 , m_actualTarget{ nullptr }
+, m_collisionWorld{ nullptr }
 {
     addType(WorldObjectTypes::WARRIOR);
-    applyConfig(config);
-    std::unique_ptr<SpriteNode> leftShoe =
-        { std::make_unique<SpriteNode>(RenderLayers::SHOES, 
+    // Warriors are only moved by commands and the AI
+    setIsMovingByItself(false);
+    m_store.setMaxHealth(m_storeHandle, health);
+    m_store.setHealth(m_storeHandle, health);
+    m_store.setMaxStamina(m_storeHandle, 100.f);
+    m_store.setStamina(m_storeHandle, 100.f);
+    applyArchetype(archetype);
+    NodePtr<SpriteNode> leftShoe =
+        { NodeArena::create<SpriteNode>(RenderLayers::SHOES, 
                 textureHolder.get(textureId), 
                 spriteSheetMapHolder.getRectData(textureId, "left_shoe"), true) };
     leftShoe->setPosition(-5.f, 8.f);
-    std::unique_ptr<SpriteNode> rightShoe =
-        { std::make_unique<SpriteNode>(RenderLayers::WEAPON, 
+    NodePtr<SpriteNode> rightShoe =
+        { NodeArena::create<SpriteNode>(RenderLayers::WEAPON, 
                 textureHolder.get(textureId), 
                 spriteSheetMapHolder.getRectData(textureId, "right_shoe"), true) };
     rightShoe->setPosition(5.f, 8.f);
 
     sf::IntRect upperBodyRect{ 
         spriteSheetMapHolder.getRectData(textureId, "upper_body") };
-    std::unique_ptr<SpriteNode> upperBody =
-        { std::make_unique<SpriteNode>(RenderLayers::UPPER_BODY, 
+    NodePtr<SpriteNode> upperBody =
+        { NodeArena::create<SpriteNode>(RenderLayers::UPPER_BODY, 
                 textureHolder.get(textureId), 
                 upperBodyRect, true) };
     setWidth(upperBodyRect.width);
@@ -71,15 +78,16 @@ Warrior::~Warrior()
 
 }
 
-void Warrior::applyConfig(const ConfigManager &config)
+void Warrior::applyArchetype(const WarriorArchetype &archetype)
 {
-    setVelocity(config.getFloat("velocity", 60.f));
-    setMass(config.getFloat("mass", 80.f));
-    m_maxHealth = config.getFloat("health", 100.f);
-    setCurrentHealth(m_maxHealth);
-    m_maxStamina = config.getFloat("stanima", 100.f);
-    setCurrentStanima(m_maxStamina);
-    m_stanimaRefreshRate = config.getFloat("stanima_refresh", 5.f);
+    setVelocity(archetype.velocity);
+    setMass(archetype.mass);
+    m_store.setMaxHealth(m_storeHandle, archetype.health);
+    setCurrentHealth(getMaxHealth());
+    m_store.setMaxStamina(m_storeHandle, archetype.stanima);
+    setCurrentStanima(m_store.getMaxStamina(m_storeHandle));
+    m_stanimaRefreshRate = archetype.stanimaRefresh;
+    setIsStanimaRegenerating(true);
 }
 
 const std::string& Warrior::getID()
@@ -89,27 +97,27 @@ const std::string& Warrior::getID()
 
 float Warrior::getCurrentHealth() const
 {
-    return m_currentHealth;
+    return m_store.getHealth(m_storeHandle);
 }
 
 void Warrior::setCurrentHealth(const float health)
 {
-    m_currentHealth = health;
+    m_store.setHealth(m_storeHandle, health);
 }
 
 float Warrior::getMaxHealth() const
 {
-    return m_maxHealth;
+    return m_store.getMaxHealth(m_storeHandle);
 }
 
 float Warrior::getCurrentStanima() const
 {
-    return m_currentStamina;
+    return m_store.getStamina(m_storeHandle);
 }
 
 void Warrior::setCurrentStanima(const float stanima)
 {
-    m_currentStamina = stanima;
+    m_store.setStamina(m_storeHandle, stanima);
 }
 
 bool Warrior::isBlocking() const
@@ -161,15 +169,26 @@ void Warrior::setIsAiActive(bool isAiActive)
     m_isAiActive = isAiActive;
 }
 
+bool Warrior::canUpdateInParallel() const
+{
+    return !m_isAiActive;
+}
+
+void Warrior::setCollisionWorld(const CollisionWorld *collisionWorld)
+{
+    m_collisionWorld = collisionWorld;
+}
+
 bool Warrior::isAlive() const
 {
-    return m_currentHealth > 0.f;
+    return getCurrentHealth() > 0.f;
 }
 
 void Warrior::damage(const float damage)
 {
-    m_currentHealth -= damage;
-    if (m_currentHealth <= 0.f)
+    const float Health{ getCurrentHealth() - damage };
+    setCurrentHealth(Health);
+    if (Health <= 0.f)
     {
         m_status = WorldObjectStatus::DESTORYED;
     }
@@ -178,29 +197,18 @@ void Warrior::damage(const float damage)
 
 void Warrior::heal(const float health)
 {
-    m_currentHealth += health;
-    if (m_currentHealth > m_maxHealth)
-    {
-        m_currentHealth = m_maxHealth;
-    }
+    setCurrentHealth(std::min(getMaxHealth(), getCurrentHealth() + health));
 }
 
 void Warrior::removeStanima(float stanima)
 {
-    m_currentStamina -= stanima;
-    if (m_currentStamina < 0.f)
-    {
-        m_currentStamina = 0.f;
-    }
+    setCurrentStanima(std::max(0.f, getCurrentStanima() - stanima));
 }
 
 void Warrior::addStanima(float stanima)
 {
-    m_currentStamina += stanima;
-    if (m_currentStamina > m_maxStamina)
-    {
-        m_currentStamina = m_maxStamina;
-    }
+    setCurrentStanima(std::min(m_store.getMaxStamina(m_storeHandle), 
+                getCurrentStanima() + stanima));
 }
 
 void Warrior::drawCurrent(sf::RenderTarget &target, sf::RenderStates states) const
@@ -210,8 +218,7 @@ void Warrior::drawCurrent(sf::RenderTarget &target, sf::RenderStates states) con
 
 void Warrior::updateCurrent(float dt)
 {
-    // Automatic fill up Stanima with the given rate
-    addStanima(m_stanimaRefreshRate * dt);
+    // The stanima is filled up by the EntityStore
     if (m_isAiActive)
     {
         updateAI(dt);
@@ -265,9 +272,9 @@ void Warrior::onCommandCurrent(const Command &command, float dt)
     //Entity::onCommand(command, dt);
     if (command.getWorldObjectType() & m_type)
     {
-        m_currentVelocity = 0.f;
-        m_currentDirection.x = 0.f;
-        m_currentDirection.y = 0.f;
+        const float Velocity{ getVelocity() };
+        float currentVelocity{ 0.f };
+        sf::Vector2f currentDirection{ 0.f, 0.f };
         m_isMoving = false;
 
         switch (command.getCommandType())
@@ -281,58 +288,60 @@ void Warrior::onCommandCurrent(const Command &command, float dt)
             case CommandTypes::ROTATE :
                 break;
             case CommandTypes::MOVE_IN_DIR:
-                m_currentVelocity = m_velocity;
-                m_currentDirection = command.getValues();
+                currentVelocity = Velocity;
+                currentDirection = command.getValues();
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_UP:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.y = -m_velocity;
+                currentVelocity = Velocity;
+                currentDirection.y = -Velocity;
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_DOWN:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.y = m_velocity;
+                currentVelocity = Velocity;
+                currentDirection.y = Velocity;
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_LEFT:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.x = -m_velocity;
+                currentVelocity = Velocity;
+                currentDirection.x = -Velocity;
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_RIGHT:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.x = m_velocity;
+                currentVelocity = Velocity;
+                currentDirection.x = Velocity;
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_UP_LEFT:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.x = -(m_velocity / 2.f);
-                m_currentDirection.y = -(m_velocity / 2.f);
+                currentVelocity = Velocity;
+                currentDirection.x = -(Velocity / 2.f);
+                currentDirection.y = -(Velocity / 2.f);
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_UP_RIGHT:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.x = (m_velocity / 2.f);
-                m_currentDirection.y = -(m_velocity / 2.f);
+                currentVelocity = Velocity;
+                currentDirection.x = (Velocity / 2.f);
+                currentDirection.y = -(Velocity / 2.f);
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_DOWN_LEFT:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.x = -(m_velocity / 2.f);
-                m_currentDirection.y = (m_velocity / 2.f);
+                currentVelocity = Velocity;
+                currentDirection.x = -(Velocity / 2.f);
+                currentDirection.y = (Velocity / 2.f);
                 m_isMoving = true;
                 break;
             case CommandTypes::MOVE_DOWN_RIGHT:
-                m_currentVelocity = m_velocity;
-                m_currentDirection.x = (m_velocity / 2.f);
-                m_currentDirection.y = (m_velocity / 2.f);
+                currentVelocity = Velocity;
+                currentDirection.x = (Velocity / 2.f);
+                currentDirection.y = (Velocity / 2.f);
                 m_isMoving = true;
                 break;
             default:
                 break;
         }
-        moveInActualDirection(m_currentVelocity * dt);
+        setCurrentVelocity(currentVelocity);
+        setCurrentDirection(currentDirection);
+        moveInActualDirection(currentVelocity * dt);
     }
 }
 
@@ -352,6 +361,24 @@ void Warrior::lookAt(const sf::Vector2f LookPos)
     setRotation(AngleSigned - 90.f);
 }
 
+void Warrior::setIsStanimaRegenerating(bool isRegenerating)
+{
+    m_store.setStaminaRate(m_storeHandle, 
+            isRegenerating ? m_stanimaRefreshRate : 0.f);
+}
+
+bool Warrior::isInLineOfSight(const SceneNode &node) const
+{
+    if (!m_collisionWorld)
+    {
+        return true;
+    }
+    CollisionWorld::RayHit hit;
+    return !m_collisionWorld->segmentCast(getWorldPosition(), 
+            node.getWorldPosition(), hit, 
+            CollisionLayerMatrix::getLayerMask(CollisionLayers::LEVEL));
+}
+
 void Warrior::weaponAdded()
 {
     // Do nothing by default
@@ -364,3 +391,31 @@ void Warrior::handleDamage(Weapon *weapon)
     // To prevent multiple damage set attack to blocked attacks
     weapon->addHitID(getID());
 }
+
+NodePtr<Weapon> Warrior::createProjectile() const
+{
+    return nullptr;
+}
+
+void Warrior::saveCurrentState(BinaryWriter &writer) const
+{
+    Entity::saveCurrentState(writer);
+    // The id is part of the hit ids of the weapons
+    writer.writeString(m_ID);
+    writer.writeBool(m_isMoving);
+    writer.writeBool(m_isBlocking);
+    writer.writeBool(m_isAiActive);
+    m_animationLeftShoe.saveState(writer);
+    m_animationRightShoe.saveState(writer);
+}
+
+void Warrior::loadCurrentState(BinaryReader &reader)
+{
+    Entity::loadCurrentState(reader);
+    m_ID = reader.readString();
+    m_isMoving = reader.readBool();
+    m_isBlocking = reader.readBool();
+    m_isAiActive = reader.readBool();
+    m_animationLeftShoe.loadState(reader);
+    m_animationRightShoe.loadState(reader);
+}
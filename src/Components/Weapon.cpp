@@ -3,6 +3,8 @@
 #include <iostream>
 #include <cmath>
 #include <Helpers.hpp>
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 
 Weapon::Weapon(RenderLayers layer, const float damage, 
         const std::string &textureId, 
@@ -10,6 +12,7 @@ Weapon::Weapon(RenderLayers layer, const float damage,
 : Item(layer, textureId, textureHolder)
 , m_damage{ damage }
 , m_damageMultiplicator{ 1.f }
+, m_spawnerId{ 0 }
 {
     addType(WorldObjectTypes::WEAPON);
 }
@@ -19,6 +22,7 @@ Weapon::Weapon(RenderLayers layer, const float damage, const sf::Texture &textur
 : Item(layer, texture, rect)
 , m_damage{ damage }
 , m_damageMultiplicator{ 1.f }
+, m_spawnerId{ 0 }
 {
     addType(WorldObjectTypes::WEAPON);
 }
@@ -29,6 +33,7 @@ Weapon::Weapon(RenderLayers layer, const float damage, const sf::Texture &textur
 : Item(layer, texture, frameRects, centerOrigin, totalTime, repeat)
 , m_damage{ damage }
 , m_damageMultiplicator{ 1.f }
+, m_spawnerId{ 0 }
 {
     addType(WorldObjectTypes::WEAPON);
 }
@@ -73,4 +78,42 @@ void Weapon::startNewAttack()
     // Create a random attack id
     m_ID = Helpers::createUniqueID(30);
     m_hitIDs.clear();
+    // A new attack should hit warriors again, which are still touched by the
+    // weapon
+    startNewContactEpoch();
+}
+
+void Weapon::setSpawnerId(unsigned int spawnerId)
+{
+    m_spawnerId = spawnerId;
+}
+
+unsigned int Weapon::getSpawnerId() const
+{
+    return m_spawnerId;
+}
+
+void Weapon::saveCurrentState(BinaryWriter &writer) const
+{
+    Item::saveCurrentState(writer);
+    writer.writeFloat(m_damageMultiplicator);
+    writer.writeString(m_ID);
+    writer.writeVarUInt(m_hitIDs.size());
+    for (const std::string &hitID : m_hitIDs)
+    {
+        writer.writeString(hitID);
+    }
+}
+
+void Weapon::loadCurrentState(BinaryReader &reader)
+{
+    Item::loadCurrentState(reader);
+    m_damageMultiplicator = reader.readFloat();
+    m_ID = reader.readString();
+    m_hitIDs.clear();
+    const std::uint64_t HitIDCnt{ reader.readVarUInt() };
+    for (std::uint64_t i{ 0 }; i < HitIDCnt && reader.isValid(); i++)
+    {
+        m_hitIDs.insert(reader.readString());
+    }
 }
@@ -3,17 +3,20 @@
 #include "Components/Item.hpp"
 #include "Collision/CollisionRect.hpp"
 #include "Collision/CollisionHandler.hpp"
+#include "Jobs/DeferredActions.hpp"
 #include "Calc.hpp"
 #include "Helpers.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include "Serialization/BinaryWriter.hpp"
 #include "DebugHelpers.hpp"
 #include <iostream>
 
-Wizard::Wizard(RenderLayers layer, const ConfigManager &config, SoundPlayer &sound, 
+Wizard::Wizard(RenderLayers layer, const WarriorArchetype &archetype, SoundPlayer &sound, 
         const int health, const std::string &textureId, 
         const ResourceHolder<sf::Texture> &textureHolder,
         const SpriteSheetMapHolder &spriteSheetMapHolder, 
         std::vector<Warrior*> &possibleTargetsInWord)
-: Warrior(layer, config, sound, health, textureId, textureHolder, spriteSheetMapHolder, 
+: Warrior(layer, archetype, sound, health, textureId, textureHolder, spriteSheetMapHolder, 
         possibleTargetsInWord)
 , m_animFireballAttack( nullptr, false )
 // Close Attack
@@ -32,7 +35,7 @@ Wizard::Wizard(RenderLayers layer, const ConfigManager &config, SoundPlayer &sou
     stickMovementStepsFireball.push_back({ -2.f, { 0, 1 },  0.1f });
     stickMovementStepsFireball.push_back({ 2.f, { 0, 1 },  0.1f });
     m_animFireballAttack.setMovementSteps(stickMovementStepsFireball);
-    std::unique_ptr<Weapon> stick(new Weapon(RenderLayers::WEAPON, 10.f, 
+    NodePtr<Weapon> stick(NodeArena::create<Weapon>(RenderLayers::WEAPON, 10.f, 
                 textureHolder.get(textureId), 
                 spriteSheetMapHolder.getRectData(textureId, "stick")));
     stick->setPosition(0.f, 0.f);
@@ -140,9 +143,8 @@ void Wizard::onCommandCurrent(const Command &command, float dt)
     Warrior::onCommandCurrent(command, dt);
     if (command.getWorldObjectType() & m_type)
     {
-        m_currentVelocity = 0.f;
-        m_currentDirection.x = 0.f;
-        m_currentDirection.y = 0.f;
+        setCurrentVelocity(0.f);
+        setCurrentDirection({ 0.f, 0.f });
         switch (command.getCommandType())
         {
             case CommandTypes::ACTION_1:
@@ -164,7 +166,7 @@ void Wizard::onCommandCurrent(const Command &command, float dt)
                 break;
 
         }
-        moveInActualDirection(m_currentVelocity * dt);
+        moveInActualDirection(getCurrentVelocity() * dt);
     }
 }
 
@@ -176,48 +178,62 @@ void Wizard::updateAI(float dt)
 void Wizard::startFireballAttack()
 {
     if (m_weapon && !m_animFireballAttack.isRunning() &&  
-            m_currentStamina >= m_fireballAttackStanima && !m_isHealing)
+            getCurrentStanima() >= m_fireballAttackStanima && !m_isHealing)
     {
         m_animFireballAttack.start();
-        SceneNode* rootNode{ getRootSceneNode() };
-
-        std::unique_ptr<Weapon> fireball{ 
-            std::make_unique<Weapon>(RenderLayers::WEAPON,
-                    m_fireballDamage,
-                    m_textureHolder.get("fireball"), 
-                    m_fireballFrameRects, 
-                    true,
-                    0.5f) };
-        
-        // Add id of wizard to "HitID", so the weapon asume that the wizard was
-        // already attacked, so the wizard is not damaged by colliding with fireball
-        fireball->addHitID(getID());
-        fireball->setDebugName("Fireball");
-        fireball->setVelocity(200.f);
-        // We have to add a distance to the fireball in the direction the wizards
-        // look, because the fireball is higher then the wizard and the fireball
-        // should not stick out behind the warrior
-        sf::Vector2f lookDir{ 
-            Calc::degAngleToDirectionVector(getRotation() + 90.f) };
-        sf::Vector2f spawnDist{ lookDir.x * 10.f, lookDir.y * 10.f };
-        sf::Vector2f pos{ getWorldPosition() + spawnDist };
-        fireball->setPosition(pos);
-        
-        fireball->setRotationDefault(getRotation());
-        fireball->setCurrentDirection(
-                Calc::degAngleToDirectionVector(fireball->getRotation() + 90.f));
-        fireball->addType(WorldObjectTypes::PROJECTILE);
-        std::unique_ptr<CollisionShape> collisionShape{
-            std::make_unique<CollisionRect>(
-                    sf::Vector2f(fireball->getWidth(), fireball->getHeight()))};
-        fireball->setCollisionShape(std::move(collisionShape));
-        fireball->setIsCollisionCheckOn(true);
-        rootNode->attachChild(std::move(fireball));
         removeStanima(m_fireballAttackStanima);
-        m_sound.play("fireball");
+        // The root can be updated by other threads at the moment
+        DeferredActions::add([this] () 
+                { 
+                    spawnFireball(); 
+                });
     }
 }
 
+NodePtr<Weapon> Wizard::createProjectile() const
+{
+    NodePtr<Weapon> fireball{ 
+        NodeArena::create<Weapon>(RenderLayers::WEAPON,
+                m_fireballDamage,
+                m_textureHolder.get("fireball"), 
+                m_fireballFrameRects, 
+                true,
+                0.5f) };
+    // Add id of wizard to "HitID", so the weapon asume that the wizard was
+    // already attacked, so the wizard is not damaged by colliding with fireball
+    fireball->addHitID(m_ID);
+    fireball->setSpawnerId(getNodeId());
+    fireball->setDebugName("Fireball");
+    fireball->setVelocity(200.f);
+    fireball->addType(WorldObjectTypes::PROJECTILE);
+    std::unique_ptr<CollisionShape> collisionShape{
+        std::make_unique<CollisionRect>(
+                sf::Vector2f(fireball->getWidth(), fireball->getHeight()))};
+    fireball->setCollisionShape(std::move(collisionShape));
+    fireball->setIsCollisionCheckOn(true);
+    return fireball;
+}
+
+void Wizard::spawnFireball()
+{
+    SceneNode* rootNode{ getRootSceneNode() };
+    NodePtr<Weapon> fireball{ createProjectile() };
+    // We have to add a distance to the fireball in the direction the wizards
+    // look, because the fireball is higher then the wizard and the fireball
+    // should not stick out behind the warrior
+    sf::Vector2f lookDir{ 
+        Calc::degAngleToDirectionVector(getRotation() + 90.f) };
+    sf::Vector2f spawnDist{ lookDir.x * 10.f, lookDir.y * 10.f };
+    sf::Vector2f pos{ getWorldPosition() + spawnDist };
+    fireball->setPosition(pos);
+    
+    fireball->setRotationDefault(getRotation());
+    fireball->setCurrentDirection(
+            Calc::degAngleToDirectionVector(fireball->getRotation() + 90.f));
+    rootNode->attachChild(std::move(fireball));
+    m_sound.play("fireball", pos);
+}
+
 void Wizard::startHealing()
 {
     m_isHealing = true;
@@ -257,3 +273,21 @@ void Wizard::weaponAdded()
 {
     m_animFireballAttack.setParent(m_weapon);
 }
+
+void Wizard::saveCurrentState(BinaryWriter &writer) const
+{
+    Warrior::saveCurrentState(writer);
+    m_animFireballAttack.saveState(writer);
+    writer.writeBool(m_isHealing);
+    writer.writeFloat(m_currentHealColorStep);
+    writer.writeFloat(m_currentHealColorStepTime);
+}
+
+void Wizard::loadCurrentState(BinaryReader &reader)
+{
+    Warrior::loadCurrentState(reader);
+    m_animFireballAttack.loadState(reader);
+    m_isHealing = reader.readBool();
+    m_currentHealColorStep = reader.readFloat();
+    m_currentHealColorStepTime = reader.readFloat();
+}
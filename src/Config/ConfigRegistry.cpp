@@ -0,0 +1,224 @@
+#include "Config/ConfigRegistry.hpp"
+#include "Helpers.hpp"
+#include <sys/stat.h>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+ConfigRegistry::FileId ConfigRegistry::load(const std::string &fileName)
+{
+    for (std::size_t i{ 0 }; i < m_files.size(); i++)
+    {
+        if (m_files[i].fileName == fileName)
+        {
+            return i;
+        }
+    }
+    m_files.push_back({ fileName, getModificationTime(fileName), {}, {}, {} });
+    readFile(m_files.back());
+    return m_files.size() - 1;
+}
+
+ConfigRegistry::Handle ConfigRegistry::getHandle(FileId file,
+        const std::string &key)
+{
+    assert(file < m_files.size());
+    File &loadedFile{ m_files[file] };
+    auto found = loadedFile.keys.find(key);
+    if (found != loadedFile.keys.end())
+    {
+        return { file, found->second };
+    }
+    const std::size_t Index{ loadedFile.values.size() };
+    loadedFile.keys.insert({ key, Index });
+    loadedFile.keyNames.push_back(key);
+    loadedFile.values.push_back({ false, "", false, false, false, 0, false,
+            0.f });
+    return { file, Index };
+}
+
+bool ConfigRegistry::isExisting(Handle handle) const
+{
+    return handle.file < m_files.size() &&
+        handle.value < m_files[handle.file].values.size() &&
+        m_files[handle.file].values[handle.value].isExisting;
+}
+
+const std::string& ConfigRegistry::getString(Handle handle,
+        const std::string &defaultVal) const
+{
+    const Value *Val{ findValue(handle) };
+    return Val ? Val->str : defaultVal;
+}
+
+bool ConfigRegistry::getBool(Handle handle, bool defaultVal) const
+{
+    const Value *Val{ findValue(handle) };
+    if (!Val)
+    {
+        return defaultVal;
+    }
+    if (!Val->isBool)
+    {
+        std::cerr << "Value of key: \""
+            << m_files[handle.file].keyNames[handle.value]
+            << "\" is no valid boolean. Invalid value is: " << Val->str
+            << std::endl;
+        return defaultVal;
+    }
+    return Val->boolVal;
+}
+
+int ConfigRegistry::getInt(Handle handle, int defaultVal) const
+{
+    const Value *Val{ findValue(handle) };
+    if (!Val)
+    {
+        return defaultVal;
+    }
+    if (!Val->isInt)
+    {
+        std::cerr << "Value of key: \""
+            << m_files[handle.file].keyNames[handle.value]
+            << "\" is no valid int. Invalid value is: " << Val->str
+            << std::endl;
+        return defaultVal;
+    }
+    return Val->intVal;
+}
+
+float ConfigRegistry::getFloat(Handle handle, float defaultVal) const
+{
+    const Value *Val{ findValue(handle) };
+    if (!Val)
+    {
+        return defaultVal;
+    }
+    if (!Val->isFloat)
+    {
+        std::cerr << "Value of key: \""
+            << m_files[handle.file].keyNames[handle.value]
+            << "\" is no valid float. Invalid value is: " << Val->str
+            << std::endl;
+        return defaultVal;
+    }
+    return Val->floatVal;
+}
+
+std::size_t ConfigRegistry::reloadChanged()
+{
+    std::size_t reloadedCnt{ 0 };
+    for (File &file : m_files)
+    {
+        const std::time_t ModificationTime{
+            getModificationTime(file.fileName) };
+        if (ModificationTime == file.modificationTime)
+        {
+            continue;
+        }
+        file.modificationTime = ModificationTime;
+        // A missing file keeps its values (e.g. while an editor replaces it)
+        if (ModificationTime != 0 && readFile(file))
+        {
+            std::cout << "Reloaded config: " << file.fileName << std::endl;
+            reloadedCnt++;
+        }
+    }
+    return reloadedCnt;
+}
+
+bool ConfigRegistry::readFile(File &file)
+{
+    std::ifstream stream(file.fileName, std::ios_base::in);
+    if (!stream)
+    {
+        std::cerr << "Could not open file: " << file.fileName << std::endl;
+        return false;
+    }
+    // The keys which arent in the file anymore are missing
+    for (Value &value : file.values)
+    {
+        value.isExisting = false;
+    }
+    std::string line;
+    while(std::getline(stream, line))
+    {
+        // Ignore empty lines and headers
+        if (line.size() < 1 || line[0] == '[')
+        {
+            continue;
+        }
+        std::vector<std::string> configs{ Helpers::splitString(line, '=') };
+        if (configs.size() < 2 || configs[0].size() == 0 ||
+                configs[1].size() == 0)
+        {
+            std::cerr << "Line: \"" << line << "\" is no valid configuration"
+                << std::endl;
+            continue;
+        }
+        setValue(file, configs[0], configs[1]);
+    }
+    return true;
+}
+
+void ConfigRegistry::setValue(File &file, const std::string &key,
+        const std::string &str)
+{
+    auto found = file.keys.find(key);
+    std::size_t index{ file.values.size() };
+    if (found != file.keys.end())
+    {
+        index = found->second;
+    }
+    else
+    {
+        file.keys.insert({ key, index });
+        file.keyNames.push_back(key);
+        file.values.push_back({});
+    }
+    Value &value{ file.values[index] };
+    value.isExisting = true;
+    value.str = str;
+    value.isBool = str == "true" || str == "false";
+    value.boolVal = str == "true";
+    // The whole string has to be a number
+    const char *Begin{ str.c_str() };
+    char *end{ nullptr };
+    errno = 0;
+    const long IntVal{ std::strtol(Begin, &end, 10) };
+    value.isInt = *end == '\0' && errno == 0 &&
+        IntVal >= std::numeric_limits<int>::min() &&
+        IntVal <= std::numeric_limits<int>::max();
+    value.intVal = value.isInt ? static_cast<int>(IntVal) : 0;
+    errno = 0;
+    const float FloatVal{ std::strtof(Begin, &end) };
+    value.isFloat = *end == '\0' && errno == 0;
+    value.floatVal = value.isFloat ? FloatVal : 0.f;
+}
+
+const ConfigRegistry::Value* ConfigRegistry::findValue(Handle handle) const
+{
+    if (!isExisting(handle))
+    {
+        std::cerr << "Config with Key: \""
+            << (handle.file < m_files.size() &&
+                    handle.value < m_files[handle.file].keyNames.size() ?
+                    m_files[handle.file].keyNames[handle.value] : "")
+            << "\" not existis\n";
+        return nullptr;
+    }
+    return &m_files[handle.file].values[handle.value];
+}
+
+std::time_t ConfigRegistry::getModificationTime(const std::string &fileName)
+{
+    struct stat fileStat;
+    if (stat(fileName.c_str(), &fileStat) != 0)
+    {
+        return 0;
+    }
+    return fileStat.st_mtime;
+}
@@ -0,0 +1,18 @@
+#include "Config/WarriorArchetype.hpp"
+
+WarriorArchetype WarriorArchetype::compile(ConfigRegistry &registry, 
+        const std::string &fileName)
+{
+    const ConfigRegistry::FileId File{ registry.load(fileName) };
+    WarriorArchetype archetype;
+    archetype.velocity = registry.getFloat(
+            registry.getHandle(File, "velocity"), 60.f);
+    archetype.mass = registry.getFloat(registry.getHandle(File, "mass"), 80.f);
+    archetype.health = registry.getFloat(
+            registry.getHandle(File, "health"), 100.f);
+    archetype.stanima = registry.getFloat(
+            registry.getHandle(File, "stanima"), 100.f);
+    archetype.stanimaRefresh = registry.getFloat(
+            registry.getHandle(File, "stanima_refresh"), 5.f);
+    return archetype;
+}
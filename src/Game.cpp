@@ -8,12 +8,17 @@
 #include "Screens/TwoPlayerSelectionScreen.hpp"
 #include "Level/Level.hpp"
 #include "Helpers.hpp"
+#include "Profiling/AllocationTracker.hpp"
+#include "Profiling/Profiler.hpp"
+#include "Random/RandomService.hpp"
 #include <iostream>
 #include <memory>
+#include <algorithm>
 #include <cmath>
 
 Game::Game()
 : m_config("assets/config.ini") 
+, m_configRegistry{ }
 , m_screenHeight{ static_cast<unsigned int>(
         m_config.getInt("screen_width", 1024)) }
 , m_screenWidth{ static_cast<unsigned int>(
@@ -29,13 +34,21 @@ Game::Game()
 , m_window{ sf::VideoMode{ m_screenHeight, m_screenWidth} , "ARENA" }
 , m_music{ }
 , m_sound{  }
-, m_context{ &m_config, &m_window, &m_fontHolder, &m_textureHolder, 
-    &m_shaderHolder, &m_spriteSheetMapHolder, &m_levelHolder, &m_music, 
-    &m_sound, &m_background }
+, m_printAllocStats{ m_config.getBool("print_alloc_stats", false) }
+, m_isConfigReloading{ m_config.getBool("config_hot_reload", false) }
+, m_jobSystem{ m_config.getInt("job_threads", -1) }
+, m_context{ &m_config, &m_configRegistry, &m_window, &m_fontHolder, 
+    &m_textureHolder, &m_shaderHolder, &m_spriteSheetMapHolder, &m_levelHolder, 
+    &m_music, &m_sound, &m_background, &m_jobSystem }
 , m_isRunning{ true }
 , m_isPaused{ false }
 , m_renderManager{ &m_sceneGraph }
 , m_dt{ 0 }
+, m_updateStepTime{ m_config.getInt("update_rate", 60) > 0 ? 
+    1.f / m_config.getInt("update_rate", 60) : 0.f }
+, m_maxUpdatesPerFrame{ std::max(1, 
+        m_config.getInt("max_updates_per_frame", 5)) }
+, m_updateTimeAccumulator{ 0.f }
 , m_fps{ 0 }
 , m_averageFpsTime{ 0.f }
 , m_fpsInSec{ 0.f }
@@ -43,6 +56,7 @@ Game::Game()
 , m_averageFpsPerSec{ 0 }
 , m_timePoint1{ CLOCK::now() }
 , m_inputHandler{ &m_window }
+, m_inputSampler{ m_inputHandler, m_config.getInt("input_sample_rate", 0) }
 , m_screenStack{ m_context }
 {
     if (m_config.getBool("fullscreen", false))
@@ -63,6 +77,12 @@ Game::Game()
         m_window.setMouseCursorVisible(false);
     }
 
+    // The matches seed the random numbers again (see MainGameScreen)
+    RandomService::seed(RandomService::createSeed());
+
+    AllocationTracker::setFrameBudget(static_cast<std::uint64_t>(
+                std::max(0, m_config.getInt("alloc_budget", 0))));
+
     int musicLevel{ m_config.getInt("music_level", 10) };
     m_music.setVolume(musicLevel * 10);
     if (!m_config.getBool("music_on", true))
@@ -97,6 +117,7 @@ Game::Game()
     m_screenStack.registerScreen<CreditsScreen>(ScreenID::CREDITS);
     m_screenStack.registerScreen<PauseScreen>(ScreenID::PAUSE);
     m_screenStack.pushScreen(ScreenID::MAINMENU);
+    m_inputSampler.start();
 }
 
 Game::~Game()
@@ -182,16 +203,25 @@ void Game::loadMusic()
             "assets/sounds/themes/S31-Sentry.ogg");
     m_music.add("menutheme01", 
             "assets/sounds/themes/S31-200_Production.ogg");
+    // The themes which can follow are opened in the background, so the 
+    // screen changes dont wait for the files
+    m_music.setFollowUps("menutheme01", { "gametheme01", "gametheme02" });
+    m_music.setFollowUps("gametheme01", { "menutheme01" });
+    m_music.setFollowUps("gametheme02", { "menutheme01" });
 }
 
 void Game::loadSounds()
 {
-    m_sound.load("swoosh1", "assets/sounds/fx/swoosh1/swoosh1.wav");
-    m_sound.load("sword-clash", "assets/sounds/fx/sword-clash/sword-clash.wav");
-    m_sound.load("swoosh-long", "assets/sounds/fx/swoosh-long/swoosh-long.wav");
-    m_sound.load("slashkut", "assets/sounds/fx/slashkut/slashkut.wav");
-    m_sound.load("fireball", "assets/sounds/fx/fireball/fireball.wav");
-    m_sound.load("dodge", "assets/sounds/fx/dodge/dodge.wav");
+    // The hits are more important than the swings, which happen all the 
+    // time in a busy match
+    m_sound.load("swoosh1", "assets/sounds/fx/swoosh1/swoosh1.wav", 0, 3);
+    m_sound.load("sword-clash", "assets/sounds/fx/sword-clash/sword-clash.wav",
+            2, 4);
+    m_sound.load("swoosh-long", "assets/sounds/fx/swoosh-long/swoosh-long.wav",
+            0, 2);
+    m_sound.load("slashkut", "assets/sounds/fx/slashkut/slashkut.wav", 2, 4);
+    m_sound.load("fireball", "assets/sounds/fx/fireball/fireball.wav", 1, 4);
+    m_sound.load("dodge", "assets/sounds/fx/dodge/dodge.wav", 1, 2);
 }
 
 void Game::buildScene()
@@ -199,6 +229,14 @@ void Game::buildScene()
     m_txtStatFPS.setFont(m_fontHolder.get("default"));
 	m_txtStatFPS.setCharacterSize(12);
 	m_txtStatFPS.setFillColor(sf::Color::White);
+    m_txtStatInput.setFont(m_fontHolder.get("default"));
+    m_txtStatInput.setCharacterSize(12);
+    m_txtStatInput.setFillColor(sf::Color::White);
+    m_txtStatInput.setPosition(0.f, 16.f);
+    m_txtStatAlloc.setFont(m_fontHolder.get("default"));
+    m_txtStatAlloc.setCharacterSize(12);
+    m_txtStatAlloc.setFillColor(sf::Color::White);
+    m_txtStatAlloc.setPosition(0.f, 32.f);
 
     // Background
     m_background.setOrigin(m_background.getSize().x / 2.f, 
@@ -226,11 +264,28 @@ void Game::run()
 {
     while (m_window.isOpen() && m_isRunning)
     {
+        Profiler::markFrame();
+        AllocationTracker::endFrame();
+        Profiler::setCounter("allocations", 
+                AllocationTracker::getLastFrame().allocations);
+        ProfileZone zone{ "Game::run" };
         determineDeltaTime();
-        handleInput();
-        update();
+        if (m_updateStepTime > 0.f)
+        {
+            updateFixedSteps();
+        }
+        else
+        {
+            handleInput(m_dt, Input::Clock::now());
+            update(m_dt);
+        }
         render();
     }
+    // Dont loose a running capture when the window gets closed
+    if (Profiler::isCapturing())
+    {
+        Profiler::stopCapture();
+    }
 }
 
 void Game::determineDeltaTime()
@@ -251,19 +306,97 @@ void Game::determineDeltaTime()
         m_averageFpsTime = 0.f;
         m_fpsInSec = 0.f;
         m_fpsCnt = 0;
+        updateInputStats();
+        updateAllocationStats();
+        if (m_isConfigReloading)
+        {
+            // The running match keeps its warriors, the next one uses the
+            // reloaded values
+            m_configRegistry.reloadChanged();
+        }
     }
     m_txtStatFPS.setString("FPS: " + std::to_string(m_averageFpsPerSec) + " (" 
             + std::to_string(m_fps) + ")");
 }
 
+void Game::updateAllocationStats()
+{
+    if (!AllocationTracker::isEnabled())
+    {
+        return;
+    }
+    // The report allocates itself, so it is only created once per second and
+    // gets its own scope
+    ProfileZone zone{ "Game::updateAllocationStats" };
+    std::string report{ AllocationTracker::getReport(5) };
+    m_txtStatAlloc.setString(report);
+    if (m_printAllocStats)
+    {
+        std::cout << report << std::endl;
+    }
+}
+
+void Game::updateInputStats()
+{
+    std::string report{ m_inputLatency.getReport("Input latency") };
+    if (m_inputSampler.isRunning())
+    {
+        report += " Dropped: " + std::to_string(m_inputSampler.getDroppedCnt());
+    }
+    m_txtStatInput.setString(report);
+    m_inputLatency.clear();
+}
+
+void Game::updateFixedSteps()
+{
+    m_updateTimeAccumulator += m_dt;
+    const Input::Clock::time_point Now{ Input::Clock::now() };
+    int updateCnt{ 0 };
+    while (m_updateTimeAccumulator >= m_updateStepTime && 
+            updateCnt < m_maxUpdatesPerFrame)
+    {
+        // The input is handled for every step, so the commands (e.g. the 
+        // movement) are applied once per step. The step gets the sampled
+        // inputs until its end
+        const std::chrono::duration<float> TimeAfterStep{ 
+            m_updateTimeAccumulator - m_updateStepTime };
+        handleInput(m_updateStepTime, Now - 
+                std::chrono::duration_cast<Input::Clock::duration>(
+                    TimeAfterStep));
+        update(m_updateStepTime);
+        m_updateTimeAccumulator -= m_updateStepTime;
+        updateCnt++;
+    }
+    if (m_updateTimeAccumulator >= m_updateStepTime)
+    {
+        // Prevent the spiral of death
+        m_updateTimeAccumulator = 0.f;
+    }
+    Profiler::setCounter("updates per frame", updateCnt);
+    m_screenStack.setRenderInterpolation(
+            m_updateTimeAccumulator / m_updateStepTime);
+}
 
-void Game::handleInput()
+void Game::handleInput(float dt, Input::Clock::time_point sampledUntil)
 {
+    ProfileZone zone{ "Game::handleInput" };
     std::queue<sf::Event> eventQueue;
-    m_inputHandler.handleInput(eventQueue, m_inputQueue);
-    while(!m_inputQueue.isEmpty())
+    if (m_inputSampler.isRunning())
+    {
+        m_inputHandler.handleEvents(eventQueue, m_inputQueue);
+        m_inputHandler.handleMousePosInput(m_inputQueue);
+        m_inputHandler.handleJoystickRealTimeInput(m_inputQueue);
+        m_inputSampler.takeInputs(sampledUntil, m_inputQueue);
+    }
+    else
+    {
+        m_inputHandler.handleInput(eventQueue, m_inputQueue);
+    }
+    const Input::Clock::time_point Now{ Input::Clock::now() };
+    m_inputQueue.drain([this, dt, Now] (Input &input)
     {
-        Input input{ m_inputQueue.pop() };
+        m_inputLatency.add(std::chrono::duration<float>{ 
+                Now - input.getTimestamp() }.count());
         switch (input.getInputType())
         {
             case InputTypes::WINDOW_RESIZED :
@@ -285,7 +418,8 @@ void Game::handleInput()
             switch (input.getInputType())
             {
                 case InputTypes::D1 :
-
+                    // Start / stop recording a trace of the profiler zones
+                    toggleTraceCapture();
                     break;
                 case InputTypes::D2 :
                     // Show /hide statistics
@@ -307,25 +441,26 @@ void Game::handleInput()
         {
             //m_world.translateInput(input, m_dt);
             //m_actualScreen->handleInput(input, m_dt);
-            m_screenStack.handleInput(input, m_dt);
+            m_screenStack.handleInput(input, dt);
         }
-    }
+    });
     
     while(!eventQueue.empty())
     {
         sf::Event event{ eventQueue.front() };
         eventQueue.pop();
-        m_screenStack.handleEvent(event, m_dt);
+        m_screenStack.handleEvent(event, dt);
     }   
 }
 
-void Game::update()
+void Game::update(float dt)
 {
-    updateBackground(m_dt);
+    ProfileZone zone{ "Game::update" };
+    updateBackground(dt);
     if (!m_isPaused)
     {
         //m_actualScreen->update(m_dt);
-        m_screenStack.update(m_dt);
+        m_screenStack.update(dt);
         /*
         m_world.safeSceneNodeTrasform();
         //m_world.controlWorldEntities();
@@ -334,9 +469,10 @@ void Game::update()
         m_world.handleCollision(m_dt);
         */
         m_sceneGraph.removeDestroyed();
-        m_sceneGraph.update(m_dt);
+        m_sceneGraph.update(dt);
     }
-    m_sound.removeStoppedSounds();
+    m_sound.update();
+    m_music.update(dt);
 }
 
 void Game::updateBackground(float dt)
@@ -360,8 +496,23 @@ void Game::updateBackground(float dt)
     m_background.setFillColor(curCol);
 }
 
+void Game::toggleTraceCapture()
+{
+    if (!Profiler::isCapturing())
+    {
+        Profiler::startCapture();
+        std::cout << "Trace capture started" << std::endl;
+    }
+    else if (Profiler::stopCapture())
+    {
+        std::cout << "Trace written to " << Profiler::getLastTraceFile() 
+            << std::endl;
+    }
+}
+
 void Game::render()
 {
+    ProfileZone zone{ "Game::render" };
     m_window.clear();
     //m_world.render();
     //m_actualScreen->render();
@@ -372,6 +523,11 @@ void Game::render()
     if (m_showStats)
     {
         m_window.draw(m_txtStatFPS);
+        m_window.draw(m_txtStatInput);
+        if (AllocationTracker::isEnabled())
+        {
+            m_window.draw(m_txtStatAlloc);
+        }
     }
     m_window.setView(oldView);
     m_window.display();
@@ -1,5 +1,5 @@
 #include "Helpers.hpp"
-#include <random>
+#include "Random/RandomService.hpp"
 #include <iostream>
 #include <set>
 #include <cmath>
@@ -7,30 +7,27 @@
 #include <algorithm>
 #include <sstream>
 
-std::string Helpers::getRandomAlphaNumString(int length)
+std::string Helpers::getRandomAlphaNumString(int length, 
+        RandomStreams stream)
 {
     std::string legalChars
         { "0123456789ABCDEFGHIJKLMNOPQRSTUVQXYZabcdefghijklmnopqrstuvwxyz" };
     
-    std::random_device randDev;
-    std::mt19937 mt(randDev());
-    // Random int num between 0 (inclusive) and 62 (inclusive)
-    std::uniform_int_distribution<int> dist(0, 62);
+    RandomStream &random{ RandomService::getStream(stream) };
     std::string randStr{ "" };
     for (int i = 0; i != length; i++)
     {
-        int randNum{ dist(mt) };
+        // Random int num between 0 (inclusive) and 61 (inclusive)
+        int randNum{ random.getInt(0, 
+                static_cast<int>(legalChars.size()) - 1) };
         randStr += legalChars[randNum];
     }
     return randStr;
 }
 
-int Helpers::getRandomNum(int a, int b)
+int Helpers::getRandomNum(int a, int b, RandomStreams stream)
 {
-    std::random_device randDev;
-    std::mt19937 mt(randDev());
-    std::uniform_int_distribution<int> dist(a, b);
-    return dist(mt);
+    return RandomService::getStream(stream).getInt(a, b);
 }
 
 std::string Helpers::createUniqueID(int length)
@@ -3,6 +3,7 @@
 Input::Input(InputTypes inputType, InputDevice inputDevice)
 : m_inputType{ inputType }
 , m_inputDevice{ inputDevice }
+, m_timestamp{ Clock::now() }
 {
 
 }
@@ -11,6 +12,7 @@ Input::Input(InputTypes inputType, InputDevice inputDevice, sf::Vector2f values)
 : m_inputType{ inputType }
 , m_inputDevice{ inputDevice }
 , m_values{values}
+, m_timestamp{ Clock::now() }
 {
 
 }
@@ -43,3 +45,13 @@ void Input::setValue(sf::Vector2f values)
 {
     m_values = values;
 }
+
+Input::Clock::time_point Input::getTimestamp() const
+{
+    return m_timestamp;
+}
+
+void Input::setTimestamp(Clock::time_point timestamp)
+{
+    m_timestamp = timestamp;
+}
@@ -16,14 +16,15 @@ InputHandler::InputHandler(sf::RenderWindow *window)
 }
 
 void InputHandler::handleInput(std::queue<sf::Event> &eventQueue, 
-        QueueHelper<Input> &inputQueue)
+        InputQueue &inputQueue)
 {
     handleEvents(eventQueue, inputQueue);
+    handleMousePosInput(inputQueue);
     handleRealTimeInput(inputQueue);
 }
 
 void InputHandler::handleEvents(std::queue<sf::Event> &eventQueue, 
-        QueueHelper<Input> &inputQueue)
+        InputQueue &inputQueue)
 {
     sf::Event event;
     while (m_window->pollEvent(event))
@@ -42,7 +43,7 @@ void InputHandler::handleEvents(std::queue<sf::Event> &eventQueue,
 }
 
 void InputHandler::handleKeyboardEvents(sf::Event &event,
-        QueueHelper<Input> &inputQueue)
+        InputQueue &inputQueue)
 {
     if (event.type == sf::Event::Closed)
     {
@@ -119,7 +120,7 @@ void InputHandler::handleKeyboardEvents(sf::Event &event,
 }
 
 void InputHandler::handleJoystickEvents(sf::Event &event, 
-        QueueHelper<Input> &inputQueue, unsigned int joystickId)
+        InputQueue &inputQueue, unsigned int joystickId)
 {
     InputDevice inputDevice{ getInputDevice(joystickId) };
 
@@ -149,9 +150,30 @@ void InputHandler::handleJoystickEvents(sf::Event &event,
     }
 }
 
-void InputHandler::handleRealTimeInput(QueueHelper<Input> &inputQueue)
+void InputHandler::handleMousePosInput(InputQueue &inputQueue)
+{
+    // Get the current mouse pos at the window
+    const sf::Vector2i CurrentMousePosPixel{ 
+        sf::Mouse::getPosition(*m_window) };
+    // Convert the current window mouse pos to the world coordinates
+    const sf::Vector2f CurrentMousePosWorld{ 
+        m_window->mapPixelToCoords(CurrentMousePosPixel) };
+
+    inputQueue.push({ InputTypes::MOUSE_POS, InputDevice::KEYBOARD_MOUSE, 
+            CurrentMousePosWorld });
+
+    m_lastMousePos.x = CurrentMousePosPixel.x;
+    m_lastMousePos.y = CurrentMousePosPixel.y;
+}
+
+void InputHandler::handleRealTimeInput(InputQueue &inputQueue)
 {
     handleKeyboardRealTimeInput(inputQueue);
+    handleJoystickRealTimeInput(inputQueue);
+}
+
+void InputHandler::handleJoystickRealTimeInput(InputQueue &inputQueue)
+{
     if (sf::Joystick::isConnected(0))
     {
         handleJoystickRealTimeInput(inputQueue, 0);
@@ -162,19 +184,8 @@ void InputHandler::handleRealTimeInput(QueueHelper<Input> &inputQueue)
     }
 }
 
-void InputHandler::handleKeyboardRealTimeInput(QueueHelper<Input> &inputQueue)
+void InputHandler::handleKeyboardRealTimeInput(InputQueue &inputQueue)
 {
-    // Get the current mouse pos at the window
-    const sf::Vector2i CurrentMousePosPixel{ 
-        sf::Mouse::getPosition(*m_window) };
-    // Convert the current window mouse pos to the world coordinates
-    const sf::Vector2f CurrentMousePosWorld{ 
-        m_window->mapPixelToCoords(CurrentMousePosPixel) };
-
-    inputQueue.push({ InputTypes::MOUSE_POS, InputDevice::KEYBOARD_MOUSE, 
-            CurrentMousePosWorld });
-    
-
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) 
             && sf::Keyboard::isKeyPressed(sf::Keyboard::A))
     {
@@ -228,12 +239,9 @@ void InputHandler::handleKeyboardRealTimeInput(QueueHelper<Input> &inputQueue)
                         InputDevice::KEYBOARD_MOUSE }); 
                 break;
     }
-
-    m_lastMousePos.x = CurrentMousePosPixel.x;
-    m_lastMousePos.y = CurrentMousePosPixel.y;
 }
 
-void InputHandler::handleJoystickRealTimeInput(QueueHelper<Input> &inputQueue, 
+void InputHandler::handleJoystickRealTimeInput(InputQueue &inputQueue, 
         unsigned int joystickId)
 {
     InputDevice inputDevice{ getInputDevice(joystickId) };
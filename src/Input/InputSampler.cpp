@@ -0,0 +1,155 @@
+#include "Input/InputSampler.hpp"
+#include <algorithm>
+#include <array>
+
+InputSampler::InputSampler(InputHandler &inputHandler, int sampleRate)
+: m_inputHandler{ inputHandler }
+, m_sampleInterval{ sampleRate > 0 ? 
+    std::chrono::duration_cast<Input::Clock::duration>(
+            std::chrono::duration<double>{ 1.0 / sampleRate }) : 
+    Input::Clock::duration::zero() }
+, m_isStopping{ false }
+, m_sampleCnt{ 0 }
+{
+    m_pendingInputs.reserve(m_sampledInputs.getCapacity());
+    m_mergedInputs.reserve(m_sampledInputs.getCapacity());
+}
+
+InputSampler::~InputSampler()
+{
+    stop();
+}
+
+void InputSampler::start()
+{
+    if (m_sampleInterval == Input::Clock::duration::zero() || isRunning())
+    {
+        return;
+    }
+    m_isStopping = false;
+    m_thread = std::thread{ &InputSampler::run, this };
+}
+
+void InputSampler::stop()
+{
+    if (!isRunning())
+    {
+        return;
+    }
+    m_isStopping = true;
+    m_thread.join();
+}
+
+bool InputSampler::isRunning() const
+{
+    return m_thread.joinable();
+}
+
+void InputSampler::takeInputs(Input::Clock::time_point until, 
+        InputQueue &inputQueue)
+{
+    m_sampledInputs.drain([this] (Input &input)
+    {
+        m_pendingInputs.push_back(input);
+    });
+    // The samples are added in the order of their timestamps
+    const auto DueEnd = std::find_if(m_pendingInputs.begin(), 
+            m_pendingInputs.end(), [until] (const Input &input)
+            {
+                return input.getTimestamp() > until;
+            });
+    
+    // Go from the latest input back, so the first found input of a type is 
+    // the one which is kept
+    const std::size_t DeviceCnt{ 4 };
+    std::array<Input::Clock::time_point, DeviceCnt> movementTimes;
+    movementTimes.fill(Input::Clock::time_point::min());
+    m_mergedInputs.clear();
+    m_mergedTypes.clear();
+    for (auto it = DueEnd; it != m_pendingInputs.begin();)
+    {
+        --it;
+        const InputTypes Type{ it->getInputType() };
+        const InputDevice Device{ it->getInputDevice() };
+        if (isMovement(Type))
+        {
+            // The keys of one direction can be sampled as several inputs 
+            // (e.g. UP and LEFT), so the whole latest sample is used
+            Input::Clock::time_point &movementTime{ 
+                movementTimes[static_cast<std::size_t>(Device) % DeviceCnt] };
+            if (movementTime == Input::Clock::time_point::min())
+            {
+                movementTime = it->getTimestamp();
+            }
+            if (movementTime == it->getTimestamp())
+            {
+                m_mergedInputs.push_back(*it);
+            }
+        }
+        else if (std::find(m_mergedTypes.begin(), m_mergedTypes.end(), 
+                    std::make_pair(Type, Device)) == m_mergedTypes.end())
+        {
+            m_mergedTypes.push_back({ Type, Device });
+            m_mergedInputs.push_back(*it);
+        }
+    }
+    m_pendingInputs.erase(m_pendingInputs.begin(), DueEnd);
+    for (auto it = m_mergedInputs.rbegin(); it != m_mergedInputs.rend(); ++it)
+    {
+        inputQueue.push(*it);
+    }
+}
+
+std::uint64_t InputSampler::getSampleCnt() const
+{
+    return m_sampleCnt.load();
+}
+
+std::uint64_t InputSampler::getDroppedCnt() const
+{
+    return m_sampledInputs.getDroppedCnt();
+}
+
+void InputSampler::run()
+{
+    Input::Clock::time_point nextSample{ Input::Clock::now() };
+    while (!m_isStopping.load())
+    {
+        m_inputHandler.handleKeyboardRealTimeInput(m_sampleBuffer);
+        const Input::Clock::time_point SampleTime{ Input::Clock::now() };
+        m_sampleBuffer.drain([this, SampleTime] (Input &input)
+        {
+            input.setTimestamp(SampleTime);
+            m_sampledInputs.push(input);
+        });
+        m_sampleCnt++;
+
+        nextSample += m_sampleInterval;
+        // Dont sample several times in a row to catch up, when the thread
+        // was not scheduled for a while
+        if (nextSample < SampleTime)
+        {
+            nextSample = SampleTime;
+        }
+        std::this_thread::sleep_until(nextSample);
+    }
+}
+
+bool InputSampler::isMovement(InputTypes inputType)
+{
+    switch (inputType)
+    {
+        case InputTypes::CURSOR_LEFT_POS :
+        case InputTypes::LEFT :
+        case InputTypes::RIGHT :
+        case InputTypes::UP :
+        case InputTypes::DOWN :
+        case InputTypes::UP_LEFT :
+        case InputTypes::UP_RIGHT :
+        case InputTypes::DOWN_LEFT :
+        case InputTypes::DOWN_RIGHT :
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,69 @@
+#include "Jobs/DeferredActions.hpp"
+#include "Jobs/JobSystem.hpp"
+#include <algorithm>
+#include <cassert>
+
+thread_local DeferredActions *DeferredActions::currentActions{ nullptr };
+thread_local std::size_t DeferredActions::currentOrder{ 0 };
+
+DeferredActions::Scope::Scope(DeferredActions &actions, std::size_t order)
+: m_previousActions{ currentActions }
+, m_previousOrder{ currentOrder }
+{
+    currentActions = &actions;
+    currentOrder = order;
+}
+
+DeferredActions::Scope::~Scope()
+{
+    currentActions = m_previousActions;
+    currentOrder = m_previousOrder;
+}
+
+DeferredActions::DeferredActions(std::size_t threadCnt)
+: m_buffers(std::max<std::size_t>(threadCnt, 1))
+, m_lastActionCnt{ 0 }
+{
+
+}
+
+void DeferredActions::add(Action action)
+{
+    if (!currentActions)
+    {
+        action();
+        return;
+    }
+    const std::size_t ThreadIndex{ JobSystem::getThreadIndex() };
+    assert(ThreadIndex < currentActions->m_buffers.size());
+    currentActions->m_buffers[ThreadIndex].push_back(
+            { currentOrder, std::move(action) });
+}
+
+void DeferredActions::execute()
+{
+    m_merged.clear();
+    for (std::vector<Entry> &buffer : m_buffers)
+    {
+        std::move(buffer.begin(), buffer.end(), std::back_inserter(m_merged));
+        buffer.clear();
+    }
+    // The actions of one scope are all in the same buffer, so the stable sort
+    // keeps their order
+    std::stable_sort(m_merged.begin(), m_merged.end(), 
+            [] (const Entry &a, const Entry &b)
+            {
+                return a.order < b.order;
+            });
+    for (Entry &entry : m_merged)
+    {
+        entry.action();
+    }
+    m_lastActionCnt = m_merged.size();
+    m_merged.clear();
+}
+
+std::size_t DeferredActions::getLastActionCnt() const
+{
+    return m_lastActionCnt;
+}
@@ -0,0 +1,175 @@
+#include "Jobs/JobSystem.hpp"
+#include <algorithm>
+
+thread_local std::size_t JobSystem::threadIndex{ 0 };
+
+JobSystem::JobSystem(int workerCnt)
+: m_queuedCnt{ 0 }
+, m_isStopping{ false }
+{
+    if (workerCnt < 0)
+    {
+        // hardware_concurrency() returns 0 when it is not known
+        workerCnt = std::max(0, 
+                static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    for (int i{ 0 }; i <= workerCnt; i++)
+    {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i{ 1 }; i <= workerCnt; i++)
+    {
+        m_workers.emplace_back(&JobSystem::runWorker, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_sleepMutex };
+        m_isStopping = true;
+    }
+    m_wakeCondition.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void JobSystem::schedule(Job job, Counter &counter)
+{
+    counter++;
+    // The index is only too big for workers of another job system
+    std::size_t index{ threadIndex < m_queues.size() ? threadIndex : 0 };
+    {
+        std::lock_guard<std::mutex> lock{ m_queues[index]->mutex };
+        // Count the task before it is visible, otherwise a worker could steal
+        // it and decrement the counter below zero
+        m_queuedCnt++;
+        m_queues[index]->tasks.push_back({ std::move(job), &counter });
+    }
+    {
+        // Lock, so a worker cant miss the notification between checking the
+        // queued jobs and going to sleep
+        std::lock_guard<std::mutex> lock{ m_sleepMutex };
+    }
+    m_wakeCondition.notify_one();
+}
+
+void JobSystem::wait(Counter &counter)
+{
+    std::size_t index{ threadIndex < m_queues.size() ? threadIndex : 0 };
+    Task task;
+    while (counter.load() > 0)
+    {
+        if (tryGetTask(index, task))
+        {
+            execute(task);
+        }
+        else
+        {
+            // The last jobs are executed by other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t minBatchSize, 
+        const std::function<void(std::size_t)> &function)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    // Some more batches than threads, so a thread which finishes early can 
+    // steal the rest
+    const std::size_t BatchCnt{ getThreadCnt() * 4 };
+    const std::size_t BatchSize{ std::max(std::max<std::size_t>(minBatchSize, 1), 
+            (count + BatchCnt - 1) / BatchCnt) };
+    Counter counter{ 0 };
+    for (std::size_t begin{ 0 }; begin < count; begin += BatchSize)
+    {
+        const std::size_t End{ std::min(count, begin + BatchSize) };
+        schedule([&function, begin, End] ()
+                {
+                    for (std::size_t i{ begin }; i < End; i++)
+                    {
+                        function(i);
+                    }
+                }, counter);
+    }
+    wait(counter);
+}
+
+std::size_t JobSystem::getWorkerCnt() const
+{
+    return m_workers.size();
+}
+
+std::size_t JobSystem::getThreadCnt() const
+{
+    return m_workers.size() + 1;
+}
+
+std::size_t JobSystem::getThreadIndex()
+{
+    return threadIndex;
+}
+
+void JobSystem::runWorker(std::size_t index)
+{
+    threadIndex = index;
+    Task task;
+    while (true)
+    {
+        if (tryGetTask(index, task))
+        {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock{ m_sleepMutex };
+        m_wakeCondition.wait(lock, [this] () 
+                { 
+                    return m_isStopping.load() || m_queuedCnt.load() > 0; 
+                });
+        if (m_isStopping.load() && m_queuedCnt.load() == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool JobSystem::tryGetTask(std::size_t index, Task &task)
+{
+    {
+        WorkQueue &ownQueue{ *m_queues[index] };
+        std::lock_guard<std::mutex> lock{ ownQueue.mutex };
+        if (!ownQueue.tasks.empty())
+        {
+            task = std::move(ownQueue.tasks.back());
+            ownQueue.tasks.pop_back();
+            m_queuedCnt--;
+            return true;
+        }
+    }
+    for (std::size_t i{ 1 }; i < m_queues.size(); i++)
+    {
+        WorkQueue &otherQueue{ *m_queues[(index + i) % m_queues.size()] };
+        std::lock_guard<std::mutex> lock{ otherQueue.mutex };
+        if (!otherQueue.tasks.empty())
+        {
+            task = std::move(otherQueue.tasks.front());
+            otherQueue.tasks.pop_front();
+            m_queuedCnt--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(Task &task)
+{
+    task.job();
+    task.job = nullptr;
+    task.counter->fetch_sub(1);
+}
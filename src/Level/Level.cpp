@@ -32,6 +32,7 @@ Level::SpawnPoint::SpawnPoint(int number, sf::Vector2f position)
 
 Level::Level()
 : name{ "" }
+, tileSize{ 0.f, 0.f }
 , spawnPoint1{ nullptr }
 , spawnPoint2{ nullptr }
 {
@@ -0,0 +1,60 @@
+#include "Network/LatencySimulator.hpp"
+#include "Random/RandomService.hpp"
+#include <algorithm>
+#include <cassert>
+
+LatencySimulator::LatencySimulator(std::unique_ptr<NetTransport> transport, 
+        float delay, float jitter, float lossRate)
+: m_transport{ std::move(transport) }
+, m_delay{ std::max(delay, 0.f) }
+, m_jitter{ std::max(jitter, 0.f) }
+, m_lossRate{ std::min(std::max(lossRate, 0.f), 1.f) }
+, m_random{ RandomService::createSeed(), 0 }
+{
+    assert(m_transport);
+}
+
+void LatencySimulator::send(const char *data, std::size_t size)
+{
+    sendDuePackets();
+    if (m_random.getChance(m_lossRate))
+    {
+        return;
+    }
+    float delay{ m_delay };
+    if (m_jitter > 0.f)
+    {
+        delay = std::max(delay + m_random.getFloat(-m_jitter, m_jitter), 0.f);
+    }
+    DelayedPacket packet{ Clock::now() + 
+        std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<float>(delay)), 
+        std::vector<char>(data, data + size) };
+    auto insertPos = std::upper_bound(m_packets.begin(), m_packets.end(), 
+            packet.dueTime, 
+            [] (const Clock::time_point &time, const DelayedPacket &other)
+            {
+                return time < other.dueTime;
+            });
+    m_packets.insert(insertPos, std::move(packet));
+    sendDuePackets();
+}
+
+bool LatencySimulator::receive(std::vector<char> &packet)
+{
+    sendDuePackets();
+    return m_transport->receive(packet);
+}
+
+void LatencySimulator::sendDuePackets()
+{
+    const Clock::time_point Now{ Clock::now() };
+    std::size_t dueCnt{ 0 };
+    while (dueCnt < m_packets.size() && m_packets[dueCnt].dueTime <= Now)
+    {
+        const std::vector<char> &Data{ m_packets[dueCnt].data };
+        m_transport->send(Data.data(), Data.size());
+        dueCnt++;
+    }
+    m_packets.erase(m_packets.begin(), m_packets.begin() + dueCnt);
+}
@@ -0,0 +1,41 @@
+#include "Network/LoopbackTransport.hpp"
+
+LoopbackTransport::LoopbackTransport()
+: m_peer{ nullptr }
+{
+
+}
+
+LoopbackTransport::~LoopbackTransport()
+{
+    if (m_peer)
+    {
+        m_peer->m_peer = nullptr;
+    }
+}
+
+void LoopbackTransport::connect(LoopbackTransport &transportA, 
+        LoopbackTransport &transportB)
+{
+    transportA.m_peer = &transportB;
+    transportB.m_peer = &transportA;
+}
+
+void LoopbackTransport::send(const char *data, std::size_t size)
+{
+    if (m_peer)
+    {
+        m_peer->m_packets.emplace_back(data, data + size);
+    }
+}
+
+bool LoopbackTransport::receive(std::vector<char> &packet)
+{
+    if (m_packets.empty())
+    {
+        return false;
+    }
+    packet.swap(m_packets.front());
+    m_packets.pop_front();
+    return true;
+}
@@ -0,0 +1,371 @@
+#include "Network/RollbackSession.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    // "ANET" in the packet
+    const std::uint32_t Magic{ 0x54454E41 };
+    // Has to be increased, when the packet changes
+    const std::uint8_t Version{ 1 };
+    // Limits the size of a packet, older steps are sent again with the
+    // next packets
+    const std::uint64_t MaxStepsPerPacket{ 32 };
+    const std::uint64_t MaxCommandsPerStep{ 64 };
+}
+
+const std::size_t RollbackSession::BufferSize;
+const std::uint64_t RollbackSession::NoStep;
+
+RollbackSession::RollbackSession(NetTransport &transport, 
+        WorldObjectTypes remotePlayer, std::size_t inputDelay)
+: m_transport(transport)
+, m_remotePlayer{ remotePlayer }
+, m_inputDelay{ std::min<std::uint64_t>(inputDelay, BufferSize / 2) }
+, m_localEnd{ 0 }
+, m_remoteEnd{ 0 }
+, m_remoteAck{ 0 }
+, m_lastRealRemoteStep{ NoStep }
+, m_rollbackStep{ NoStep }
+, m_lastChecksumStep{ NoStep }
+, m_desyncStep{ NoStep }
+, m_isConnected{ false }
+, m_stats{}
+{
+    for (std::size_t i{ 0 }; i < BufferSize; i++)
+    {
+        m_localSteps[i] = { NoStep, false, false, {} };
+        m_remoteSteps[i] = { NoStep, false, false, {} };
+        m_checksumSteps[i] = NoStep;
+        m_remoteChecksumSteps[i] = NoStep;
+    }
+    // The first steps have no commands of both peers
+    for (std::uint64_t step{ 0 }; step < m_inputDelay; step++)
+    {
+        InputStep &localStep = getLocalStep(step);
+        localStep.step = step;
+        localStep.isSet = true;
+        InputStep &remoteStep = getRemoteStep(step);
+        remoteStep.step = step;
+        remoteStep.isSet = true;
+    }
+    m_localEnd = m_inputDelay;
+    m_remoteEnd = m_inputDelay;
+    m_remoteAck = m_inputDelay;
+}
+
+bool RollbackSession::canAddLocalCommands() const
+{
+    return m_localEnd - m_remoteAck < BufferSize;
+}
+
+void RollbackSession::addLocalCommands(const std::vector<Command> &commands)
+{
+    assert(canAddLocalCommands());
+    InputStep &localStep = getLocalStep(m_localEnd);
+    localStep.step = m_localEnd;
+    localStep.isSet = true;
+    localStep.isPredicted = false;
+    localStep.commands.assign(commands.begin(), commands.begin() + 
+            std::min<std::size_t>(commands.size(), MaxCommandsPerStep));
+    m_localEnd++;
+}
+
+void RollbackSession::send()
+{
+    const std::uint64_t FirstStep{ m_remoteAck };
+    const std::uint64_t StepCnt{ 
+        std::min(m_localEnd - FirstStep, MaxStepsPerPacket) };
+    m_packet.clear();
+    m_packet.writeUInt32(Magic);
+    m_packet.writeUInt8(Version);
+    m_packet.writeVarUInt(m_remoteEnd);
+    m_packet.writeVarUInt(FirstStep);
+    m_packet.writeVarUInt(StepCnt);
+    for (std::uint64_t step{ FirstStep }; step < FirstStep + StepCnt; step++)
+    {
+        const InputStep &LocalStep{ getLocalStep(step) };
+        m_packet.writeVarUInt(LocalStep.commands.size());
+        for (const Command &Com : LocalStep.commands)
+        {
+            m_packet.writeUInt8(static_cast<std::uint8_t>(
+                        Com.getCommandType()));
+            m_packet.writeFloat(Com.getValues().x);
+            m_packet.writeFloat(Com.getValues().y);
+        }
+    }
+    const bool HasChecksum{ m_lastChecksumStep != NoStep };
+    m_packet.writeBool(HasChecksum);
+    if (HasChecksum)
+    {
+        m_packet.writeVarUInt(m_lastChecksumStep);
+        m_packet.writeUInt32(m_checksums[m_lastChecksumStep % BufferSize]);
+    }
+    m_transport.send(m_packet.getData(), m_packet.getSize());
+    m_stats.sentPackets++;
+    m_stats.sentBytes += m_packet.getSize();
+}
+
+void RollbackSession::receive()
+{
+    std::vector<Command> commands;
+    while (m_transport.receive(m_receiveBuffer))
+    {
+        m_stats.receivedPackets++;
+        m_stats.receivedBytes += m_receiveBuffer.size();
+        BinaryReader reader{ m_receiveBuffer.data(), m_receiveBuffer.size() };
+        if (reader.readUInt32() != Magic || reader.readUInt8() != Version)
+        {
+            continue;
+        }
+        const std::uint64_t Ack{ reader.readVarUInt() };
+        const std::uint64_t FirstStep{ reader.readVarUInt() };
+        const std::uint64_t StepCnt{ reader.readVarUInt() };
+        // A broken packet could ack steps which were never sent
+        if (!reader.isValid() || Ack > m_localEnd || 
+                StepCnt > MaxStepsPerPacket)
+        {
+            continue;
+        }
+        m_isConnected = true;
+        m_remoteAck = std::max(m_remoteAck, Ack);
+        for (std::uint64_t step{ FirstStep }; step < FirstStep + StepCnt; 
+                step++)
+        {
+            const std::uint64_t CommandCnt{ reader.readVarUInt() };
+            if (!reader.isValid() || CommandCnt > MaxCommandsPerStep)
+            {
+                break;
+            }
+            commands.clear();
+            for (std::uint64_t i{ 0 }; i < CommandCnt; i++)
+            {
+                const CommandTypes Type{ 
+                    static_cast<CommandTypes>(reader.readUInt8()) };
+                const float X{ reader.readFloat() };
+                const float Y{ reader.readFloat() };
+                // The remote peer can only control its own player
+                commands.push_back({ Type, m_remotePlayer, { X, Y } });
+            }
+            // Only the next missing step is stored, so the stored steps have
+            // no gaps (Packets can arrive in another order)
+            if (!reader.isValid() || step != m_remoteEnd || 
+                    step >= m_localEnd + BufferSize / 2)
+            {
+                continue;
+            }
+            InputStep &remoteStep = getRemoteStep(step);
+            if (remoteStep.step == step && remoteStep.isPredicted && 
+                    !isSameCommands(remoteStep.commands, commands))
+            {
+                m_stats.mispredictions++;
+                m_rollbackStep = std::min(m_rollbackStep, step);
+            }
+            remoteStep.step = step;
+            remoteStep.isSet = true;
+            remoteStep.isPredicted = false;
+            remoteStep.commands.swap(commands);
+            m_lastRealRemoteStep = step;
+            m_remoteEnd++;
+        }
+        const bool HasChecksum{ reader.readBool() };
+        if (HasChecksum)
+        {
+            const std::uint64_t ChecksumStep{ reader.readVarUInt() };
+            const std::uint32_t Checksum{ reader.readUInt32() };
+            if (reader.isValid())
+            {
+                m_remoteChecksumSteps[ChecksumStep % BufferSize] = ChecksumStep;
+                m_remoteChecksums[ChecksumStep % BufferSize] = Checksum;
+                compareChecksums(ChecksumStep);
+            }
+        }
+    }
+}
+
+bool RollbackSession::getCommands(std::uint64_t step, 
+        std::vector<Command> &commands)
+{
+    commands.clear();
+    const InputStep &LocalStep{ getLocalStep(step) };
+    if (step >= m_localEnd || LocalStep.step != step)
+    {
+        return false;
+    }
+    InputStep &remoteStep = getRemoteStep(step);
+    if (step >= m_remoteEnd)
+    {
+        predictRemoteStep(step);
+    }
+    // Both games have to apply the commands in the same order, so the 
+    // commands of player 1 come first
+    const bool IsRemoteFirst{ m_remotePlayer == WorldObjectTypes::PLAYER_1 };
+    const InputStep &FirstStep{ IsRemoteFirst ? remoteStep : LocalStep };
+    const InputStep &SecondStep{ IsRemoteFirst ? LocalStep : remoteStep };
+    commands.insert(commands.end(), FirstStep.commands.begin(), 
+            FirstStep.commands.end());
+    commands.insert(commands.end(), SecondStep.commands.begin(), 
+            SecondStep.commands.end());
+    return true;
+}
+
+std::uint64_t RollbackSession::popRollbackStep()
+{
+    const std::uint64_t Step{ m_rollbackStep };
+    m_rollbackStep = NoStep;
+    return Step;
+}
+
+std::uint64_t RollbackSession::getConfirmedStep() const
+{
+    return std::min(m_localEnd, m_remoteEnd);
+}
+
+void RollbackSession::setChecksum(std::uint64_t step, std::uint32_t checksum)
+{
+    m_checksumSteps[step % BufferSize] = step;
+    m_checksums[step % BufferSize] = checksum;
+    if (m_lastChecksumStep == NoStep || step > m_lastChecksumStep)
+    {
+        m_lastChecksumStep = step;
+    }
+    compareChecksums(step);
+}
+
+bool RollbackSession::isDesynced() const
+{
+    return m_desyncStep != NoStep;
+}
+
+std::uint64_t RollbackSession::getDesyncStep() const
+{
+    return m_desyncStep;
+}
+
+bool RollbackSession::isConnected() const
+{
+    return m_isConnected;
+}
+
+void RollbackSession::countRollback(std::uint64_t depth)
+{
+    m_stats.rollbacks++;
+    m_stats.resimulatedSteps += depth;
+    m_stats.maxRollbackDepth = std::max(m_stats.maxRollbackDepth, depth);
+}
+
+void RollbackSession::countStall()
+{
+    m_stats.stalls++;
+}
+
+const RollbackSession::Stats& RollbackSession::getStats() const
+{
+    return m_stats;
+}
+
+std::string RollbackSession::getReport() const
+{
+    std::string report{ "Net: " + std::string{ 
+        m_isConnected ? "connected" : "waiting" } + " confirmed step: " + 
+        std::to_string(getConfirmedStep()) + "\nPackets sent: " + 
+        std::to_string(m_stats.sentPackets) + " (" + 
+        std::to_string(m_stats.sentBytes) + " B) received: " + 
+        std::to_string(m_stats.receivedPackets) + " (" + 
+        std::to_string(m_stats.receivedBytes) + " B)\nPredictions: " + 
+        std::to_string(m_stats.predictions) + " wrong: " + 
+        std::to_string(m_stats.mispredictions) + "\nRollbacks: " + 
+        std::to_string(m_stats.rollbacks) + " max depth: " + 
+        std::to_string(m_stats.maxRollbackDepth) + " resimulated: " + 
+        std::to_string(m_stats.resimulatedSteps) + " stalls: " + 
+        std::to_string(m_stats.stalls) };
+    if (isDesynced())
+    {
+        report += "\nDesync at step " + std::to_string(m_desyncStep);
+    }
+    return report;
+}
+
+RollbackSession::InputStep& RollbackSession::getLocalStep(std::uint64_t step)
+{
+    return m_localSteps[step % BufferSize];
+}
+
+RollbackSession::InputStep& RollbackSession::getRemoteStep(std::uint64_t step)
+{
+    return m_remoteSteps[step % BufferSize];
+}
+
+void RollbackSession::predictRemoteStep(std::uint64_t step)
+{
+    // Predict that the remote player keeps moving and looking like in the 
+    // last received step, the actions are not repeated
+    m_stats.predictions++;
+    InputStep &remoteStep = getRemoteStep(step);
+    remoteStep.step = step;
+    remoteStep.isSet = true;
+    remoteStep.isPredicted = true;
+    remoteStep.commands.clear();
+    if (m_lastRealRemoteStep == NoStep)
+    {
+        return;
+    }
+    const InputStep &LastStep{ getRemoteStep(m_lastRealRemoteStep) };
+    for (const Command &Com : LastStep.commands)
+    {
+        if (isPredictable(Com))
+        {
+            remoteStep.commands.push_back(Com);
+        }
+    }
+}
+
+bool RollbackSession::isPredictable(const Command &command) const
+{
+    switch (command.getCommandType())
+    {
+        case CommandTypes::ACTION_1:
+        case CommandTypes::ACTION_2:
+        case CommandTypes::SPECIAL_ACTION:
+        case CommandTypes::ACTION_START:
+        case CommandTypes::ACTION_STOP:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool RollbackSession::isSameCommands(const std::vector<Command> &commandsA,
+        const std::vector<Command> &commandsB) const
+{
+    if (commandsA.size() != commandsB.size())
+    {
+        return false;
+    }
+    for (std::size_t i{ 0 }; i < commandsA.size(); i++)
+    {
+        if (commandsA[i].getCommandType() != commandsB[i].getCommandType() ||
+                commandsA[i].getWorldObjectType() != 
+                commandsB[i].getWorldObjectType() ||
+                commandsA[i].getValues() != commandsB[i].getValues())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RollbackSession::compareChecksums(std::uint64_t step)
+{
+    const std::size_t Index{ static_cast<std::size_t>(step % BufferSize) };
+    if (m_checksumSteps[Index] != step || m_remoteChecksumSteps[Index] != step)
+    {
+        return;
+    }
+    if (m_checksums[Index] != m_remoteChecksums[Index] && 
+            (m_desyncStep == NoStep || step < m_desyncStep))
+    {
+        m_desyncStep = step;
+    }
+}
@@ -0,0 +1,258 @@
+#include "Network/SpectatorClient.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include <algorithm>
+
+namespace
+{
+    // The ack is also the keep alive, so it is sent at least this often
+    const std::chrono::milliseconds AckInterval{ 100 };
+}
+
+SpectatorClient::SpectatorClient()
+: m_serverPort{ 0 }
+, m_newestSequence{ 0 }
+, m_newestReceiveTime{ Clock::now() }
+, m_lastAckTime{ Clock::now() }
+, m_receivedBytes{ 0 }
+, m_receivedStates{ 0 }
+, m_droppedStates{ 0 }
+, m_windowStart{ Clock::now() }
+, m_windowBytes{ 0 }
+, m_bytesPerSecond{ 0.f }
+, m_receiveBuffer(sf::UdpSocket::MaxDatagramSize)
+{
+    m_socket.setBlocking(false);
+    for (SpectatorState &state : m_states)
+    {
+        state.clear();
+    }
+}
+
+bool SpectatorClient::open(const sf::IpAddress &serverAddress, 
+        unsigned short port)
+{
+    m_serverAddress = serverAddress;
+    m_serverPort = port;
+    m_socket.unbind();
+    if (m_socket.bind(sf::Socket::AnyPort) != sf::Socket::Done)
+    {
+        return false;
+    }
+    // Join the server
+    sendAck();
+    return true;
+}
+
+void SpectatorClient::update()
+{
+    const std::uint32_t LastNewest{ m_newestSequence };
+    receiveStates();
+    const Clock::time_point Now{ Clock::now() };
+    if (m_newestSequence != LastNewest || Now - m_lastAckTime >= AckInterval)
+    {
+        sendAck();
+    }
+    const float Elapsed{ std::chrono::duration<float>{ 
+        Now - m_windowStart }.count() };
+    if (Elapsed >= 1.f)
+    {
+        m_bytesPerSecond = m_windowBytes / Elapsed;
+        m_windowBytes = 0;
+        m_windowStart = Now;
+    }
+}
+
+bool SpectatorClient::interpolate(double time, 
+        std::vector<ViewEntity> &entities) const
+{
+    entities.clear();
+    if (!hasState())
+    {
+        return false;
+    }
+    // The newest state before the time and the oldest one after it
+    const std::uint64_t Time{ static_cast<std::uint64_t>(
+            std::max(time, 0.0) * 1000.0) };
+    const SpectatorState *before{ nullptr };
+    const SpectatorState *after{ nullptr };
+    const SpectatorState *oldest{ nullptr };
+    for (const SpectatorState &State : m_states)
+    {
+        if (State.sequence == 0 || 
+                m_newestSequence - State.sequence >= 
+                SpectatorState::HistorySize)
+        {
+            continue;
+        }
+        if (State.time <= Time && (!before || State.time > before->time))
+        {
+            before = &State;
+        }
+        if (State.time > Time && (!after || State.time < after->time))
+        {
+            after = &State;
+        }
+        if (!oldest || State.time < oldest->time)
+        {
+            oldest = &State;
+        }
+    }
+    if (!before)
+    {
+        // The time is before all received states
+        before = oldest;
+        after = nullptr;
+    }
+    const float Factor{ after ? static_cast<float>(Time - before->time) / 
+        (after->time - before->time) : 0.f };
+    for (const SpectatorState::Entity &Ent : before->entities)
+    {
+        ViewEntity view{ Ent.id, Ent.types, Ent.spawnerId, Ent.getPosition(),
+            Ent.getRotation(), Ent.getHealth(), Ent.getStanima() };
+        const SpectatorState::Entity *next{ 
+            after ? after->findEntity(Ent.id) : nullptr };
+        if (next && next->types == Ent.types)
+        {
+            view.position += (next->getPosition() - view.position) * Factor;
+            // Turn the shorter way
+            float rotationDelta{ next->getRotation() - view.rotation };
+            if (rotationDelta > 180.f)
+            {
+                rotationDelta -= 360.f;
+            }
+            else if (rotationDelta < -180.f)
+            {
+                rotationDelta += 360.f;
+            }
+            view.rotation += rotationDelta * Factor;
+            view.health += (next->getHealth() - view.health) * Factor;
+            view.stanima += (next->getStanima() - view.stanima) * Factor;
+        }
+        entities.push_back(view);
+    }
+    return true;
+}
+
+double SpectatorClient::getServerTime() const
+{
+    if (!hasState())
+    {
+        return 0.0;
+    }
+    const SpectatorState &Newest{ 
+        m_states[m_newestSequence % SpectatorState::HistorySize] };
+    return Newest.time / 1000.0 + std::chrono::duration<double>{ 
+        Clock::now() - m_newestReceiveTime }.count();
+}
+
+bool SpectatorClient::hasState() const
+{
+    return m_newestSequence != 0;
+}
+
+float SpectatorClient::getBytesPerSecond() const
+{
+    return m_bytesPerSecond;
+}
+
+std::string SpectatorClient::getReport() const
+{
+    return "Spectating " + m_serverAddress.toString() + ":" + 
+        std::to_string(m_serverPort) + (hasState() ? "" : " (waiting)") + 
+        "\nReceived " + std::to_string(m_receivedStates) + " states, " + 
+        std::to_string(m_receivedBytes) + " B (" + 
+        std::to_string(static_cast<int>(m_bytesPerSecond)) + " B/s), " + 
+        std::to_string(m_droppedStates) + " dropped";
+}
+
+void SpectatorClient::receiveStates()
+{
+    std::size_t received{ 0 };
+    sf::IpAddress sender;
+    unsigned short senderPort{ 0 };
+    while (m_socket.receive(m_receiveBuffer.data(), m_receiveBuffer.size(), 
+                received, sender, senderPort) == sf::Socket::Done)
+    {
+        if (sender != m_serverAddress || senderPort != m_serverPort)
+        {
+            continue;
+        }
+        m_receivedBytes += received;
+        m_windowBytes += received;
+        BinaryReader reader{ m_receiveBuffer.data(), received };
+        if (reader.readUInt32() != SpectatorState::StateMagic || 
+                reader.readUInt8() != SpectatorState::Version)
+        {
+            continue;
+        }
+        const std::uint32_t Sequence{ 
+            static_cast<std::uint32_t>(reader.readVarUInt()) };
+        const std::uint32_t BaseSequence{ 
+            static_cast<std::uint32_t>(reader.readVarUInt()) };
+        const bool IsOutsideHistory{ hasState() && 
+            (Sequence > m_newestSequence ? Sequence - m_newestSequence : 
+             m_newestSequence - Sequence) >= SpectatorState::HistorySize };
+        bool isUsable{ reader.isValid() && Sequence != 0 };
+        if (isUsable && hasState())
+        {
+            // Late states are not needed anymore. A full state outside of
+            // the history starts a new one (The viewer missed too many 
+            // states or the server was restarted with new sequences)
+            isUsable = BaseSequence == 0 ? 
+                Sequence > m_newestSequence || IsOutsideHistory : 
+                Sequence > m_newestSequence && !IsOutsideHistory;
+        }
+        if (!isUsable)
+        {
+            m_droppedStates++;
+            continue;
+        }
+        if (BaseSequence == 0 && IsOutsideHistory)
+        {
+            for (SpectatorState &state : m_states)
+            {
+                state.clear();
+            }
+        }
+        const SpectatorState *base{ nullptr };
+        if (BaseSequence != 0)
+        {
+            base = &m_states[BaseSequence % SpectatorState::HistorySize];
+            if (base->sequence != BaseSequence)
+            {
+                // The base was overwritten, the server sends a full state 
+                // after the next ack
+                m_droppedStates++;
+                continue;
+            }
+        }
+        SpectatorState &state{ 
+            m_states[Sequence % SpectatorState::HistorySize] };
+        if (base == &state)
+        {
+            m_droppedStates++;
+            continue;
+        }
+        if (!state.readDelta(base, reader))
+        {
+            state.clear();
+            m_droppedStates++;
+            continue;
+        }
+        state.sequence = Sequence;
+        m_newestSequence = Sequence;
+        m_newestReceiveTime = Clock::now();
+        m_receivedStates++;
+    }
+}
+
+void SpectatorClient::sendAck()
+{
+    m_packet.clear();
+    m_packet.writeUInt32(SpectatorState::AckMagic);
+    m_packet.writeUInt8(SpectatorState::Version);
+    m_packet.writeVarUInt(m_newestSequence);
+    m_socket.send(m_packet.getData(), m_packet.getSize(), m_serverAddress, 
+            m_serverPort);
+    m_lastAckTime = Clock::now();
+}
@@ -0,0 +1,201 @@
+#include "Network/SpectatorServer.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include <algorithm>
+
+namespace
+{
+    const std::size_t MaxClients{ 32 };
+    // A spectator which doesnt ack for this time has left
+    const std::chrono::seconds ClientTimeout{ 5 };
+}
+
+SpectatorServer::SpectatorServer()
+: m_isOpen{ false }
+, m_sequence{ 0 }
+, m_windowStart{ Clock::now() }
+, m_receiveBuffer(sf::UdpSocket::MaxDatagramSize)
+{
+    m_socket.setBlocking(false);
+    for (SpectatorState &state : m_states)
+    {
+        state.clear();
+    }
+}
+
+bool SpectatorServer::open(unsigned short port)
+{
+    m_socket.unbind();
+    m_isOpen = m_socket.bind(port) == sf::Socket::Done;
+    return m_isOpen;
+}
+
+bool SpectatorServer::isOpen() const
+{
+    return m_isOpen;
+}
+
+SpectatorState& SpectatorServer::beginState()
+{
+    // The sequence 0 means no state, so it is skipped
+    const std::uint32_t Sequence{ m_sequence + 1 == 0 ? 1 : m_sequence + 1 };
+    SpectatorState &state{ m_states[Sequence % SpectatorState::HistorySize] };
+    state.clear();
+    state.sequence = Sequence;
+    return state;
+}
+
+void SpectatorServer::publish()
+{
+    if (!m_isOpen)
+    {
+        return;
+    }
+    receiveAcks();
+    m_sequence = m_sequence + 1 == 0 ? 1 : m_sequence + 1;
+    const SpectatorState &State{ 
+        m_states[m_sequence % SpectatorState::HistorySize] };
+    const Clock::time_point Now{ Clock::now() };
+    // Forget the spectators which left
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), 
+                [Now] (const Client &client)
+                {
+                    return Now - client.lastPacketTime > ClientTimeout;
+                }), m_clients.end());
+    for (Client &client : m_clients)
+    {
+        const SpectatorState *base{ nullptr };
+        if (client.ackedSequence != 0 && 
+                m_sequence - client.ackedSequence < SpectatorState::HistorySize)
+        {
+            const SpectatorState &Acked{ m_states[client.ackedSequence % 
+                SpectatorState::HistorySize] };
+            if (Acked.sequence == client.ackedSequence)
+            {
+                base = &Acked;
+            }
+        }
+        m_packet.clear();
+        m_packet.writeUInt32(SpectatorState::StateMagic);
+        m_packet.writeUInt8(SpectatorState::Version);
+        m_packet.writeVarUInt(State.sequence);
+        m_packet.writeVarUInt(base ? base->sequence : 0);
+        State.writeDelta(base, m_packet);
+        if (m_packet.getSize() > sf::UdpSocket::MaxDatagramSize)
+        {
+            continue;
+        }
+        m_socket.send(m_packet.getData(), m_packet.getSize(), client.address,
+                client.port);
+        client.sentBytes += m_packet.getSize();
+        client.windowBytes += m_packet.getSize();
+        client.sentStates++;
+        if (!base)
+        {
+            client.fullStates++;
+        }
+    }
+    updateBandwidth();
+}
+
+std::size_t SpectatorServer::getClientCnt() const
+{
+    return m_clients.size();
+}
+
+float SpectatorServer::getBytesPerSecond() const
+{
+    float bytesPerSecond{ 0.f };
+    for (const Client &Cl : m_clients)
+    {
+        bytesPerSecond += Cl.bytesPerSecond;
+    }
+    return bytesPerSecond;
+}
+
+std::string SpectatorServer::getReport() const
+{
+    if (!m_isOpen)
+    {
+        return "Spectator server: port not bound";
+    }
+    std::string report{ "Spectators: " + std::to_string(m_clients.size()) + 
+        " (" + std::to_string(static_cast<int>(getBytesPerSecond())) + 
+        " B/s)" };
+    for (const Client &Cl : m_clients)
+    {
+        report += "\n" + Cl.address.toString() + ":" + 
+            std::to_string(Cl.port) + " " + 
+            std::to_string(static_cast<int>(Cl.bytesPerSecond)) + " B/s, " + 
+            std::to_string(Cl.sentStates) + " states (" + 
+            std::to_string(Cl.fullStates) + " full), " + 
+            std::to_string(Cl.sentBytes) + " B";
+    }
+    return report;
+}
+
+void SpectatorServer::receiveAcks()
+{
+    std::size_t received{ 0 };
+    sf::IpAddress sender;
+    unsigned short senderPort{ 0 };
+    while (m_socket.receive(m_receiveBuffer.data(), m_receiveBuffer.size(), 
+                received, sender, senderPort) == sf::Socket::Done)
+    {
+        BinaryReader reader{ m_receiveBuffer.data(), received };
+        if (reader.readUInt32() != SpectatorState::AckMagic || 
+                reader.readUInt8() != SpectatorState::Version)
+        {
+            continue;
+        }
+        const std::uint64_t Ack{ reader.readVarUInt() };
+        Client *client{ findClient(sender, senderPort) };
+        if (!reader.isValid() || !client)
+        {
+            continue;
+        }
+        client->lastPacketTime = Clock::now();
+        // Acks can arrive in another order, only newer ones are used
+        const std::uint32_t Sequence{ static_cast<std::uint32_t>(Ack) };
+        if (Sequence != 0 && Sequence <= m_sequence && 
+                (client->ackedSequence == 0 || 
+                 Sequence > client->ackedSequence))
+        {
+            client->ackedSequence = Sequence;
+        }
+    }
+}
+
+SpectatorServer::Client* SpectatorServer::findClient(
+        const sf::IpAddress &address, unsigned short port)
+{
+    for (Client &client : m_clients)
+    {
+        if (client.address == address && client.port == port)
+        {
+            return &client;
+        }
+    }
+    if (m_clients.size() >= MaxClients)
+    {
+        return nullptr;
+    }
+    m_clients.push_back({ address, port, 0, Clock::now(), 0, 0, 0, 0, 0.f });
+    return &m_clients.back();
+}
+
+void SpectatorServer::updateBandwidth()
+{
+    const Clock::time_point Now{ Clock::now() };
+    const float Elapsed{ std::chrono::duration<float>{ 
+        Now - m_windowStart }.count() };
+    if (Elapsed < 1.f)
+    {
+        return;
+    }
+    for (Client &client : m_clients)
+    {
+        client.bytesPerSecond = client.windowBytes / Elapsed;
+        client.windowBytes = 0;
+    }
+    m_windowStart = Now;
+}
@@ -0,0 +1,230 @@
+#include "Network/SpectatorState.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+    const float PositionScale{ 8.f };
+    const float RotationScale{ 65536.f / 360.f };
+    const float ValueScale{ 4.f };
+    // Limits the size of a corrupt state
+    const std::uint64_t MaxEntities{ 4096 };
+
+    // The fields which differ from the base entity
+    enum ChangeMask : std::uint8_t
+    {
+        NEW_ENTITY = 1 << 0,
+        POSITION = 1 << 1,
+        ROTATION = 1 << 2,
+        HEALTH = 1 << 3,
+        STANIMA = 1 << 4
+    };
+
+    std::uint16_t quantizeValue(float value)
+    {
+        return static_cast<std::uint16_t>(std::min(std::max(
+                        std::round(value * ValueScale), 0.f), 65535.f));
+    }
+}
+
+const std::uint32_t SpectatorState::StateMagic;
+const std::uint32_t SpectatorState::AckMagic;
+const std::uint8_t SpectatorState::Version;
+const std::size_t SpectatorState::HistorySize;
+
+sf::Vector2f SpectatorState::Entity::getPosition() const
+{
+    return { posX / PositionScale, posY / PositionScale };
+}
+
+float SpectatorState::Entity::getRotation() const
+{
+    return rotation / RotationScale;
+}
+
+float SpectatorState::Entity::getHealth() const
+{
+    return health / ValueScale;
+}
+
+float SpectatorState::Entity::getStanima() const
+{
+    return stanima / ValueScale;
+}
+
+void SpectatorState::clear()
+{
+    sequence = 0;
+    time = 0;
+    entities.clear();
+}
+
+void SpectatorState::addEntity(unsigned int id, unsigned int types, 
+        unsigned int spawnerId, sf::Vector2f pos, float rotation, 
+        float health, float stanima)
+{
+    assert(entities.empty() || entities.back().id < id);
+    // The rotation wraps around, so it is stored modulo a full turn
+    const float Turn{ std::fmod(std::fmod(rotation, 360.f) + 360.f, 360.f) };
+    entities.push_back({ id, types, spawnerId, 
+            static_cast<std::int32_t>(std::round(pos.x * PositionScale)), 
+            static_cast<std::int32_t>(std::round(pos.y * PositionScale)), 
+            static_cast<std::uint16_t>(static_cast<std::uint32_t>(
+                        std::round(Turn * RotationScale)) & 0xFFFF), 
+            quantizeValue(health), quantizeValue(stanima) });
+}
+
+const SpectatorState::Entity* SpectatorState::findEntity(unsigned int id) const
+{
+    auto found = std::lower_bound(entities.begin(), entities.end(), id, 
+            [] (const Entity &entity, unsigned int id)
+            {
+                return entity.id < id;
+            });
+    if (found != entities.end() && found->id == id)
+    {
+        return &*found;
+    }
+    return nullptr;
+}
+
+void SpectatorState::writeDelta(const SpectatorState *base, 
+        BinaryWriter &writer) const
+{
+    writer.writeVarUInt(time);
+    writer.writeVarUInt(entities.size());
+    unsigned int lastId{ 0 };
+    // Both lists are sorted, so the base entities are found by walking 
+    // through the base with the new entities
+    std::size_t baseIndex{ 0 };
+    for (const Entity &Ent : entities)
+    {
+        const Entity *baseEntity{ nullptr };
+        if (base)
+        {
+            while (baseIndex < base->entities.size() && 
+                    base->entities[baseIndex].id < Ent.id)
+            {
+                baseIndex++;
+            }
+            if (baseIndex < base->entities.size() && 
+                    base->entities[baseIndex].id == Ent.id)
+            {
+                baseEntity = &base->entities[baseIndex];
+            }
+        }
+        // New entities are written as delta to zero (Also when the id was 
+        // reused by another node)
+        const bool IsNew{ !baseEntity || baseEntity->types != Ent.types || 
+            baseEntity->spawnerId != Ent.spawnerId };
+        const Entity Zero{ Ent.id, 0, 0, 0, 0, 0, 0, 0 };
+        const Entity &Base{ IsNew ? Zero : *baseEntity };
+        std::uint8_t mask{ 0 };
+        if (IsNew)
+        {
+            mask |= NEW_ENTITY;
+        }
+        if (Ent.posX != Base.posX || Ent.posY != Base.posY)
+        {
+            mask |= POSITION;
+        }
+        if (Ent.rotation != Base.rotation)
+        {
+            mask |= ROTATION;
+        }
+        if (Ent.health != Base.health)
+        {
+            mask |= HEALTH;
+        }
+        if (Ent.stanima != Base.stanima)
+        {
+            mask |= STANIMA;
+        }
+        writer.writeVarUInt(Ent.id - lastId);
+        writer.writeUInt8(mask);
+        if (mask & NEW_ENTITY)
+        {
+            writer.writeVarUInt(Ent.types);
+            writer.writeVarUInt(Ent.spawnerId);
+        }
+        if (mask & POSITION)
+        {
+            writer.writeVarInt(static_cast<std::int64_t>(Ent.posX) - Base.posX);
+            writer.writeVarInt(static_cast<std::int64_t>(Ent.posY) - Base.posY);
+        }
+        if (mask & ROTATION)
+        {
+            // The shorter way around the circle
+            writer.writeVarInt(static_cast<std::int16_t>(
+                        static_cast<std::uint16_t>(Ent.rotation - Base.rotation)));
+        }
+        if (mask & HEALTH)
+        {
+            writer.writeVarInt(static_cast<std::int64_t>(Ent.health) - 
+                    Base.health);
+        }
+        if (mask & STANIMA)
+        {
+            writer.writeVarInt(static_cast<std::int64_t>(Ent.stanima) - 
+                    Base.stanima);
+        }
+        lastId = Ent.id;
+    }
+}
+
+bool SpectatorState::readDelta(const SpectatorState *base, 
+        BinaryReader &reader)
+{
+    time = reader.readVarUInt();
+    const std::uint64_t EntityCnt{ reader.readVarUInt() };
+    if (!reader.isValid() || EntityCnt > MaxEntities)
+    {
+        return false;
+    }
+    entities.clear();
+    unsigned int id{ 0 };
+    for (std::uint64_t i{ 0 }; i < EntityCnt; i++)
+    {
+        id += static_cast<unsigned int>(reader.readVarUInt());
+        const std::uint8_t Mask{ reader.readUInt8() };
+        const Entity *baseEntity{ base ? base->findEntity(id) : nullptr };
+        Entity ent{ id, 0, 0, 0, 0, 0, 0, 0 };
+        if (Mask & NEW_ENTITY)
+        {
+            ent.types = static_cast<unsigned int>(reader.readVarUInt());
+            ent.spawnerId = static_cast<unsigned int>(reader.readVarUInt());
+        }
+        else if (baseEntity)
+        {
+            ent = *baseEntity;
+        }
+        else
+        {
+            // The base is not the one of the delta
+            return false;
+        }
+        if (Mask & POSITION)
+        {
+            ent.posX = static_cast<std::int32_t>(ent.posX + reader.readVarInt());
+            ent.posY = static_cast<std::int32_t>(ent.posY + reader.readVarInt());
+        }
+        if (Mask & ROTATION)
+        {
+            ent.rotation = static_cast<std::uint16_t>(
+                    ent.rotation + reader.readVarInt());
+        }
+        if (Mask & HEALTH)
+        {
+            ent.health = static_cast<std::uint16_t>(
+                    ent.health + reader.readVarInt());
+        }
+        if (Mask & STANIMA)
+        {
+            ent.stanima = static_cast<std::uint16_t>(
+                    ent.stanima + reader.readVarInt());
+        }
+        entities.push_back(ent);
+    }
+    return reader.isValid();
+}
@@ -0,0 +1,59 @@
+#include "Network/UdpTransport.hpp"
+
+UdpTransport::UdpTransport()
+: m_remoteAddress{ sf::IpAddress::None }
+, m_remotePort{ 0 }
+, m_hasRemote{ false }
+, m_receiveBuffer(sf::UdpSocket::MaxDatagramSize)
+{
+    m_socket.setBlocking(false);
+}
+
+bool UdpTransport::open(unsigned short localPort, 
+        const sf::IpAddress &remoteAddress, unsigned short remotePort)
+{
+    m_socket.unbind();
+    m_remoteAddress = remoteAddress;
+    m_remotePort = remotePort;
+    m_hasRemote = remoteAddress != sf::IpAddress::None;
+    return m_socket.bind(localPort) == sf::Socket::Done;
+}
+
+void UdpTransport::send(const char *data, std::size_t size)
+{
+    if (!m_hasRemote)
+    {
+        return;
+    }
+    // Lost packets are handled by the protocol, so errors are ignored
+    m_socket.send(data, size, m_remoteAddress, m_remotePort);
+}
+
+bool UdpTransport::receive(std::vector<char> &packet)
+{
+    std::size_t received{ 0 };
+    sf::IpAddress sender;
+    unsigned short senderPort{ 0 };
+    while (m_socket.receive(m_receiveBuffer.data(), m_receiveBuffer.size(), 
+                received, sender, senderPort) == sf::Socket::Done)
+    {
+        if (!m_hasRemote)
+        {
+            m_remoteAddress = sender;
+            m_remotePort = senderPort;
+            m_hasRemote = true;
+        }
+        if (sender == m_remoteAddress && senderPort == m_remotePort)
+        {
+            packet.assign(m_receiveBuffer.begin(), 
+                    m_receiveBuffer.begin() + received);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UdpTransport::hasRemote() const
+{
+    return m_hasRemote;
+}
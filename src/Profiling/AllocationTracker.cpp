@@ -0,0 +1,299 @@
+#include "Profiling/AllocationTracker.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef ARENA_TRACK_ALLOCATIONS
+
+namespace
+{
+    struct ScopeCounter
+    {
+        std::atomic<const char*> name;
+        std::atomic<std::uint64_t> allocations;
+        std::atomic<std::uint64_t> bytes;
+        std::atomic<std::uint64_t> deallocations;
+    };
+
+    // Static storage is zero initialized before any allocation can happen, so
+    // the counters are usable even for allocations of other static objects.
+    // The first slot collects the allocations outside of a scope
+    ScopeCounter scopeCounters[AllocationTracker::MAX_SCOPES];
+    thread_local const char *currentScope{ nullptr };
+
+    // The results of the last frame, only used by the thread calling endFrame()
+    AllocationTracker::FrameStats lastFrame;
+    std::array<AllocationTracker::FrameStats, AllocationTracker::MAX_SCOPES>
+        lastFrameScopes;
+    std::array<std::size_t, AllocationTracker::MAX_SCOPES> lastFrameOrder;
+    std::size_t lastFrameScopeCnt{ 0 };
+    std::uint64_t frameBudget{ 0 };
+    std::uint64_t framesOverBudget{ 0 };
+
+    ScopeCounter& getScopeCounter(const char *name)
+    {
+        if (!name)
+        {
+            return scopeCounters[0];
+        }
+        // The scope names are string literals, so comparing the pointers is
+        // enough. Free slots get claimed by the first thread using the name
+        for (std::size_t i{ 1 }; i < AllocationTracker::MAX_SCOPES; i++)
+        {
+            const char *slotName{ scopeCounters[i].name.load(
+                    std::memory_order_acquire) };
+            if (slotName == name)
+            {
+                return scopeCounters[i];
+            }
+            if (!slotName)
+            {
+                const char *expected{ nullptr };
+                if (scopeCounters[i].name.compare_exchange_strong(expected, name)
+                        || expected == name)
+                {
+                    return scopeCounters[i];
+                }
+            }
+        }
+        return scopeCounters[0];
+    }
+
+    void countAllocation(std::size_t size)
+    {
+        ScopeCounter &counter{ getScopeCounter(currentScope) };
+        counter.allocations.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void countDeallocation()
+    {
+        ScopeCounter &counter{ getScopeCounter(currentScope) };
+        counter.deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* trackedAlloc(std::size_t size)
+    {
+        void *ptr{ std::malloc(size > 0 ? size : 1) };
+        if (ptr)
+        {
+            countAllocation(size);
+        }
+        return ptr;
+    }
+
+    void trackedFree(void *ptr)
+    {
+        if (ptr)
+        {
+            countDeallocation();
+            std::free(ptr);
+        }
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    void *ptr{ trackedAlloc(size) };
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    trackedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    trackedFree(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    trackedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    trackedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept
+{
+    trackedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept
+{
+    trackedFree(ptr);
+}
+
+const char* AllocationTracker::enterScope(const char *name)
+{
+    const char *previousName{ currentScope };
+    currentScope = name;
+    return previousName;
+}
+
+void AllocationTracker::leaveScope(const char *previousName)
+{
+    currentScope = previousName;
+}
+
+void AllocationTracker::endFrame()
+{
+    lastFrame = { 0, 0, 0 };
+    lastFrameScopeCnt = 0;
+    for (std::size_t i{ 0 }; i < MAX_SCOPES; i++)
+    {
+        FrameStats &stats{ lastFrameScopes[i] };
+        stats.allocations = scopeCounters[i].allocations.exchange(0);
+        stats.bytes = scopeCounters[i].bytes.exchange(0);
+        stats.deallocations = scopeCounters[i].deallocations.exchange(0);
+        lastFrame.allocations += stats.allocations;
+        lastFrame.bytes += stats.bytes;
+        lastFrame.deallocations += stats.deallocations;
+        if (stats.allocations > 0)
+        {
+            lastFrameOrder[lastFrameScopeCnt] = i;
+            lastFrameScopeCnt++;
+        }
+    }
+    std::sort(lastFrameOrder.begin(), lastFrameOrder.begin() + lastFrameScopeCnt,
+            [] (std::size_t a, std::size_t b)
+            {
+                return lastFrameScopes[a].bytes > lastFrameScopes[b].bytes;
+            });
+    if (lastFrame.allocations > frameBudget)
+    {
+        framesOverBudget++;
+    }
+}
+
+const AllocationTracker::FrameStats& AllocationTracker::getLastFrame()
+{
+    return lastFrame;
+}
+
+std::size_t AllocationTracker::getLastFrameScopeCnt()
+{
+    return lastFrameScopeCnt;
+}
+
+const char* AllocationTracker::getLastFrameScope(std::size_t index,
+        FrameStats &stats)
+{
+    if (index >= lastFrameScopeCnt)
+    {
+        stats = { 0, 0, 0 };
+        return nullptr;
+    }
+    std::size_t scopeIndex{ lastFrameOrder[index] };
+    stats = lastFrameScopes[scopeIndex];
+    const char *name{ scopeCounters[scopeIndex].name.load() };
+    return name ? name : "other";
+}
+
+void AllocationTracker::setFrameBudget(std::uint64_t allocations)
+{
+    frameBudget = allocations;
+}
+
+std::uint64_t AllocationTracker::getFramesOverBudget()
+{
+    return framesOverBudget;
+}
+
+std::string AllocationTracker::getReport(std::size_t maxScopes)
+{
+    std::string report{ "Allocs: " + std::to_string(lastFrame.allocations) +
+        " (" + std::to_string(lastFrame.bytes) + " B) Frees: " +
+        std::to_string(lastFrame.deallocations) + " Over budget: " +
+        std::to_string(framesOverBudget) };
+    for (std::size_t i{ 0 }; i < maxScopes && i < lastFrameScopeCnt; i++)
+    {
+        FrameStats stats;
+        const char *name{ getLastFrameScope(i, stats) };
+        report += "\n  " + std::string{ name } + ": " +
+            std::to_string(stats.allocations) + " (" +
+            std::to_string(stats.bytes) + " B)";
+    }
+    return report;
+}
+
+bool AllocationTracker::isEnabled()
+{
+    return true;
+}
+
+#else
+
+namespace
+{
+    AllocationTracker::FrameStats emptyFrame{ 0, 0, 0 };
+}
+
+void AllocationTracker::endFrame()
+{
+
+}
+
+const AllocationTracker::FrameStats& AllocationTracker::getLastFrame()
+{
+    return emptyFrame;
+}
+
+std::size_t AllocationTracker::getLastFrameScopeCnt()
+{
+    return 0;
+}
+
+const char* AllocationTracker::getLastFrameScope(std::size_t index,
+        FrameStats &stats)
+{
+    stats = emptyFrame;
+    return nullptr;
+}
+
+void AllocationTracker::setFrameBudget(std::uint64_t allocations)
+{
+
+}
+
+std::uint64_t AllocationTracker::getFramesOverBudget()
+{
+    return 0;
+}
+
+std::string AllocationTracker::getReport(std::size_t maxScopes)
+{
+    return "Allocation tracking disabled (ARENA_TRACK_ALLOCATIONS)";
+}
+
+bool AllocationTracker::isEnabled()
+{
+    return false;
+}
+
+#endif // ARENA_TRACK_ALLOCATIONS
@@ -0,0 +1,85 @@
+#include "Profiling/LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+{
+    clear();
+}
+
+void LatencyHistogram::add(float latency)
+{
+    const float LatencyMs{ std::max(0.f, latency * 1000.f) };
+    std::size_t bucket{ 0 };
+    while (bucket < BUCKET_CNT - 1 && LatencyMs >= getBucketLimit(bucket))
+    {
+        bucket++;
+    }
+    m_buckets[bucket]++;
+    m_cnt++;
+    m_totalMs += LatencyMs;
+    m_maxMs = std::max(m_maxMs, LatencyMs);
+}
+
+void LatencyHistogram::clear()
+{
+    m_buckets.fill(0);
+    m_cnt = 0;
+    m_totalMs = 0.f;
+    m_maxMs = 0.f;
+}
+
+std::uint64_t LatencyHistogram::getCnt() const
+{
+    return m_cnt;
+}
+
+std::uint64_t LatencyHistogram::getBucketCnt(std::size_t bucket) const
+{
+    return m_buckets[bucket];
+}
+
+float LatencyHistogram::getBucketLimit(std::size_t bucket)
+{
+    return std::ldexp(1.f, static_cast<int>(bucket));
+}
+
+float LatencyHistogram::getAverageMs() const
+{
+    return m_cnt > 0 ? m_totalMs / m_cnt : 0.f;
+}
+
+float LatencyHistogram::getMaxMs() const
+{
+    return m_maxMs;
+}
+
+float LatencyHistogram::getPercentileMs(float percentile) const
+{
+    const std::uint64_t Target{ static_cast<std::uint64_t>(
+            std::ceil(m_cnt * percentile)) };
+    std::uint64_t cnt{ 0 };
+    for (std::size_t i{ 0 }; i < BUCKET_CNT - 1; i++)
+    {
+        cnt += m_buckets[i];
+        if (cnt >= Target)
+        {
+            return std::min(getBucketLimit(i), m_maxMs);
+        }
+    }
+    return m_maxMs;
+}
+
+std::string LatencyHistogram::getReport(const std::string &name) const
+{
+    std::string report{ name + ": avg " + 
+        std::to_string(static_cast<int>(getAverageMs() + 0.5f)) + " ms, p95 <" +
+        std::to_string(static_cast<int>(std::ceil(getPercentileMs(0.95f)))) +
+        " ms, max " + std::to_string(static_cast<int>(m_maxMs + 0.5f)) + 
+        " ms |" };
+    for (std::size_t i{ 0 }; i < BUCKET_CNT; i++)
+    {
+        report += " " + std::to_string(m_buckets[i]);
+    }
+    return report;
+}
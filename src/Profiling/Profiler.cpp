@@ -0,0 +1,181 @@
+#include "Profiling/Profiler.hpp"
+#include "Profiling/AllocationTracker.hpp"
+#include <atomic>
+#include <fstream>
+#include <iostream>
+
+std::atomic<bool> Profiler::m_isCapturing{ false };
+std::vector<Profiler::Event> Profiler::m_events;
+std::mutex Profiler::m_eventsMutex;
+Profiler::ProfileClock::time_point Profiler::m_captureStart;
+std::uint64_t Profiler::m_frameNumber{ 0 };
+std::string Profiler::m_lastTraceFile;
+
+void Profiler::startCapture()
+{
+    std::lock_guard<std::mutex> lock{ m_eventsMutex };
+    m_events.clear();
+    // A few seconds of gameplay produce some ten thousand events, so reserve
+    // the memory once instead of growing the container while recording
+    m_events.reserve(1 << 16);
+    m_captureStart = ProfileClock::now();
+    m_isCapturing = true;
+}
+
+bool Profiler::stopCapture(const std::string &fileName)
+{
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock{ m_eventsMutex };
+        if (!m_isCapturing)
+        {
+            return false;
+        }
+        m_isCapturing = false;
+        events.swap(m_events);
+    }
+    if (!writeTrace(fileName, events))
+    {
+        return false;
+    }
+    m_lastTraceFile = fileName;
+    return true;
+}
+
+bool Profiler::stopCapture()
+{
+    static int traceCnt{ 0 };
+    traceCnt++;
+    return stopCapture("arena_trace_" + std::to_string(traceCnt) + ".json");
+}
+
+bool Profiler::isCapturing()
+{
+    return m_isCapturing;
+}
+
+const std::string& Profiler::getLastTraceFile()
+{
+    return m_lastTraceFile;
+}
+
+void Profiler::markFrame()
+{
+    m_frameNumber++;
+    if (!m_isCapturing)
+    {
+        return;
+    }
+    addEvent({ EventType::FRAME, "Frame", now(), 0,
+            static_cast<double>(m_frameNumber), getThreadId() });
+}
+
+std::uint64_t Profiler::getFrameNumber()
+{
+    return m_frameNumber;
+}
+
+void Profiler::setCounter(const char *name, double value)
+{
+    if (!m_isCapturing)
+    {
+        return;
+    }
+    addEvent({ EventType::COUNTER, name, now(), 0, value, getThreadId() });
+}
+
+std::int64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            ProfileClock::now() - m_captureStart).count();
+}
+
+void Profiler::addZone(const char *name, std::int64_t start, std::int64_t end)
+{
+    if (!m_isCapturing)
+    {
+        return;
+    }
+    addEvent({ EventType::ZONE, name, start, end - start, 0.0, getThreadId() });
+}
+
+unsigned int Profiler::getThreadId()
+{
+    // Give every thread a small, stable id, so the trace viewer shows one row
+    // per thread
+    static std::atomic<unsigned int> nextThreadId{ 1 };
+    thread_local unsigned int threadId{ nextThreadId++ };
+    return threadId;
+}
+
+void Profiler::addEvent(const Event &event)
+{
+    std::lock_guard<std::mutex> lock{ m_eventsMutex };
+    if (m_isCapturing)
+    {
+        m_events.push_back(event);
+    }
+}
+
+bool Profiler::writeTrace(const std::string &fileName,
+        const std::vector<Event> &events)
+{
+    std::ofstream file(fileName);
+    if (!file)
+    {
+        std::cerr << "Cannot open file: " << fileName << " to write trace"
+            << std::endl;
+        return false;
+    }
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool isFirst{ true };
+    for (const Event &event : events)
+    {
+        if (!isFirst)
+        {
+            file << ",\n";
+        }
+        isFirst = false;
+        file << "{\"pid\":1,\"tid\":" << event.threadId
+            << ",\"ts\":" << event.start;
+        switch (event.type)
+        {
+            case EventType::ZONE:
+                file << ",\"ph\":\"X\",\"name\":\"" << event.name
+                    << "\",\"dur\":" << event.duration << "}";
+                break;
+            case EventType::FRAME:
+                // Global instant event, the viewer draws it as vertical line
+                file << ",\"ph\":\"i\",\"s\":\"g\",\"name\":\"" << event.name
+                    << " " << static_cast<std::uint64_t>(event.value) << "\"}";
+                break;
+            case EventType::COUNTER:
+                file << ",\"ph\":\"C\",\"name\":\"" << event.name
+                    << "\",\"args\":{\"value\":" << event.value << "}}";
+                break;
+        }
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
+
+ProfileZone::ProfileZone(const char *name)
+: m_name{ name }
+, m_start{ 0 }
+, m_isRecording{ Profiler::isCapturing() }
+, m_previousAllocScope{ AllocationTracker::enterScope(name) }
+{
+    if (m_isRecording)
+    {
+        m_start = Profiler::now();
+    }
+}
+
+ProfileZone::~ProfileZone()
+{
+    AllocationTracker::leaveScope(m_previousAllocScope);
+    if (m_isRecording)
+    {
+        Profiler::addZone(m_name, m_start, Profiler::now());
+    }
+}
@@ -0,0 +1,32 @@
+#include "Random/RandomService.hpp"
+#include <random>
+
+RandomStream RandomService::m_streams[static_cast<std::size_t>(
+        RandomStreams::COUNT)];
+std::uint32_t RandomService::m_seed{ 0 };
+
+void RandomService::seed(std::uint32_t seed)
+{
+    m_seed = seed;
+    for (std::size_t i{ 0 }; i < static_cast<std::size_t>(RandomStreams::COUNT);
+            i++)
+    {
+        m_streams[i].seed(seed, i);
+    }
+}
+
+std::uint32_t RandomService::getSeed()
+{
+    return m_seed;
+}
+
+std::uint32_t RandomService::createSeed()
+{
+    std::random_device randDev;
+    return randDev();
+}
+
+RandomStream& RandomService::getStream(RandomStreams stream)
+{
+    return m_streams[static_cast<std::size_t>(stream)];
+}
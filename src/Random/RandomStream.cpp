@@ -0,0 +1,88 @@
+#include "Random/RandomStream.hpp"
+
+RandomStream::RandomStream()
+: RandomStream(0, 0)
+{
+
+}
+
+RandomStream::RandomStream(std::uint64_t seed, std::uint64_t streamId)
+{
+    this->seed(seed, streamId);
+}
+
+void RandomStream::seed(std::uint64_t seed, std::uint64_t streamId)
+{
+    // The initialization of the reference implementation
+    m_state.state = 0;
+    m_state.increment = (streamId << 1) | 1;
+    getUInt32();
+    m_state.state += seed;
+    getUInt32();
+}
+
+std::uint32_t RandomStream::getUInt32()
+{
+    const std::uint64_t OldState{ m_state.state };
+    m_state.state = OldState * 6364136223846793005ULL + m_state.increment;
+    const std::uint32_t XorShifted{ static_cast<std::uint32_t>(
+            ((OldState >> 18) ^ OldState) >> 27) };
+    const std::uint32_t Rotation{ static_cast<std::uint32_t>(OldState >> 59) };
+    return (XorShifted >> Rotation) | (XorShifted << ((32 - Rotation) & 31));
+}
+
+int RandomStream::getInt(int a, int b)
+{
+    if (b <= a)
+    {
+        return a;
+    }
+    const std::uint32_t Range{ static_cast<std::uint32_t>(
+            static_cast<std::int64_t>(b) - a + 1) };
+    if (Range == 0)
+    {
+        // The range is the whole 32 bit
+        return static_cast<int>(getUInt32());
+    }
+    // Multiply and take the high bits (Lemire), the low bits tell if the 
+    // number falls into the part which would be biased
+    std::uint64_t product{ static_cast<std::uint64_t>(getUInt32()) * Range };
+    std::uint32_t low{ static_cast<std::uint32_t>(product) };
+    if (low < Range)
+    {
+        const std::uint32_t Threshold{ (0u - Range) % Range };
+        while (low < Threshold)
+        {
+            product = static_cast<std::uint64_t>(getUInt32()) * Range;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<int>(static_cast<std::int64_t>(a) + 
+            static_cast<std::int64_t>(product >> 32));
+}
+
+float RandomStream::getFloat()
+{
+    // The 24 high bits fit exactly into the mantissa
+    return (getUInt32() >> 8) * (1.f / 16777216.f);
+}
+
+float RandomStream::getFloat(float a, float b)
+{
+    return a + (b - a) * getFloat();
+}
+
+bool RandomStream::getChance(float probability)
+{
+    return getFloat() < probability;
+}
+
+const RandomStream::State& RandomStream::getState() const
+{
+    return m_state;
+}
+
+void RandomStream::setState(const State &state)
+{
+    m_state = state;
+}
@@ -0,0 +1,89 @@
+#include "Render/RenderSnapshot.hpp"
+#include <algorithm>
+#include <cassert>
+
+const std::size_t RenderSnapshot::NoParent;
+
+void RenderSnapshot::clear()
+{
+    m_nodes.clear();
+    m_sprites.clear();
+}
+
+std::size_t RenderSnapshot::addNode(const Node &node)
+{
+    assert(node.parent == NoParent || node.parent < m_nodes.size());
+    m_nodes.push_back(node);
+    return m_nodes.size() - 1;
+}
+
+void RenderSnapshot::addSprite(const Sprite &sprite)
+{
+    assert(sprite.node < m_nodes.size());
+    m_sprites.push_back(sprite);
+}
+
+void RenderSnapshot::sortByLayer()
+{
+    // The sprites are added in the order of the scene graph, which is the
+    // order the RenderManager draws them in a layer
+    std::stable_sort(m_sprites.begin(), m_sprites.end(), 
+            [] (const Sprite &a, const Sprite &b)
+            {
+                return a.layer < b.layer;
+            });
+}
+
+std::size_t RenderSnapshot::getSpriteCnt() const
+{
+    return m_sprites.size();
+}
+
+void RenderSnapshot::draw(sf::RenderTarget &target, sf::RenderStates states,
+        float interpolation) const
+{
+    // The parents are before their children, so their world transforms are
+    // already computed
+    m_worldTransforms.clear();
+    for (const Node &Current : m_nodes)
+    {
+        const sf::Transform Local{ interpolate(Current, interpolation) };
+        m_worldTransforms.push_back(Current.parent == NoParent ? Local : 
+                m_worldTransforms[Current.parent] * Local);
+    }
+    const sf::Transform BaseTransform{ states.transform };
+    sf::Sprite sprite;
+    for (const Sprite &Data : m_sprites)
+    {
+        sprite.setTexture(*Data.texture);
+        sprite.setTextureRect(Data.textureRect);
+        sprite.setColor(Data.color);
+        states.transform = BaseTransform * m_worldTransforms[Data.node] * 
+            Data.transform;
+        target.draw(sprite, states);
+    }
+}
+
+sf::Transform RenderSnapshot::interpolate(const Node &node, 
+        float interpolation)
+{
+    // Turn the shorter way
+    float rotationDelta{ node.rotation - node.lastRotation };
+    if (rotationDelta > 180.f)
+    {
+        rotationDelta -= 360.f;
+    }
+    else if (rotationDelta < -180.f)
+    {
+        rotationDelta += 360.f;
+    }
+    sf::Transformable transformable;
+    transformable.setOrigin(node.origin);
+    transformable.setPosition(node.lastPosition + 
+            (node.position - node.lastPosition) * interpolation);
+    transformable.setRotation(node.lastRotation + 
+            rotationDelta * interpolation);
+    transformable.setScale(node.lastScale + 
+            (node.scale - node.lastScale) * interpolation);
+    return transformable.getTransform();
+}
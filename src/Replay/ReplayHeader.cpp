@@ -0,0 +1,35 @@
+#include "Replay/ReplayHeader.hpp"
+
+namespace
+{
+    // "ARPL"
+    const std::uint32_t ReplayMagic{ 0x4C505241 };
+    // Has to be increased, when the format of the file changes
+    const std::uint16_t ReplayVersion{ 1 };
+}
+
+void ReplayHeader::write(BinaryWriter &writer) const
+{
+    writer.writeUInt32(ReplayMagic);
+    writer.writeUInt16(ReplayVersion);
+    writer.writeUInt32(randomSeed);
+    writer.writeUInt8(gameMode);
+    writer.writeString(levelId);
+    writer.writeVarUInt(player1Warrior);
+    writer.writeVarUInt(player2Warrior);
+}
+
+bool ReplayHeader::read(BinaryReader &reader)
+{
+    if (reader.readUInt32() != ReplayMagic || 
+            reader.readUInt16() != ReplayVersion)
+    {
+        return false;
+    }
+    randomSeed = reader.readUInt32();
+    gameMode = reader.readUInt8();
+    levelId = reader.readString();
+    player1Warrior = static_cast<std::uint32_t>(reader.readVarUInt());
+    player2Warrior = static_cast<std::uint32_t>(reader.readVarUInt());
+    return reader.isValid();
+}
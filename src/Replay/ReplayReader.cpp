@@ -0,0 +1,75 @@
+#include "Replay/ReplayReader.hpp"
+#include <fstream>
+#include <iterator>
+
+ReplayReader::ReplayReader()
+: m_reader{ nullptr, 0 }
+, m_ticksBegin{ 0 }
+, m_isOpen{ false }
+{
+
+}
+
+bool ReplayReader::open(const std::string &fileName)
+{
+    m_isOpen = false;
+    std::ifstream file(fileName, std::ios_base::in | std::ios_base::binary);
+    if (!file)
+    {
+        return false;
+    }
+    m_data.assign(std::istreambuf_iterator<char>{ file }, 
+            std::istreambuf_iterator<char>{});
+    m_reader = BinaryReader{ m_data.data(), m_data.size() };
+    if (!m_header.read(m_reader))
+    {
+        return false;
+    }
+    m_ticksBegin = m_reader.getPosition();
+    m_isOpen = true;
+    return true;
+}
+
+bool ReplayReader::isOpen() const
+{
+    return m_isOpen;
+}
+
+const ReplayHeader& ReplayReader::getHeader() const
+{
+    return m_header;
+}
+
+bool ReplayReader::readTick(Tick &tick)
+{
+    if (!m_isOpen || m_reader.isAtEnd() || !m_reader.isValid())
+    {
+        return false;
+    }
+    tick.dt = m_reader.readFloat();
+    const std::uint64_t CommandCnt{ m_reader.readVarUInt() };
+    tick.commands.clear();
+    for (std::uint64_t i{ 0 }; i < CommandCnt && m_reader.isValid(); i++)
+    {
+        const CommandTypes Type{ 
+            static_cast<CommandTypes>(m_reader.readUInt8()) };
+        const WorldObjectTypes ObjectType{ 
+            static_cast<WorldObjectTypes>(m_reader.readVarUInt()) };
+        const float X{ m_reader.readFloat() };
+        const float Y{ m_reader.readFloat() };
+        tick.commands.push_back({ Type, ObjectType, { X, Y } });
+    }
+    tick.stateChecksum = m_reader.readUInt32();
+    return m_reader.isValid();
+}
+
+void ReplayReader::rewind()
+{
+    m_reader = BinaryReader{ m_data.data() + m_ticksBegin, 
+        m_data.size() - m_ticksBegin };
+}
+
+bool ReplayReader::isValid() const
+{
+    return m_reader.isValid();
+}
@@ -0,0 +1,75 @@
+#include "Replay/ReplayWriter.hpp"
+
+ReplayWriter::ReplayWriter()
+: m_commandCnt{ 0 }
+, m_tickCnt{ 0 }
+{
+
+}
+
+bool ReplayWriter::open(const std::string &fileName, 
+        const ReplayHeader &header)
+{
+    close();
+    m_file.open(fileName, std::ios_base::out | std::ios_base::binary | 
+            std::ios_base::trunc);
+    if (!m_file)
+    {
+        return false;
+    }
+    BinaryWriter headerWriter;
+    header.write(headerWriter);
+    m_file.write(headerWriter.getData(), headerWriter.getSize());
+    m_commands.clear();
+    m_commandCnt = 0;
+    m_tickCnt = 0;
+    return static_cast<bool>(m_file);
+}
+
+void ReplayWriter::close()
+{
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+bool ReplayWriter::isOpen() const
+{
+    return m_file.is_open();
+}
+
+void ReplayWriter::addCommand(const Command &command)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    m_commands.writeUInt8(static_cast<std::uint8_t>(command.getCommandType()));
+    m_commands.writeVarUInt(command.getWorldObjectType());
+    m_commands.writeFloat(command.getValues().x);
+    m_commands.writeFloat(command.getValues().y);
+    m_commandCnt++;
+}
+
+void ReplayWriter::endTick(float dt, std::uint32_t stateChecksum)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    m_tick.clear();
+    m_tick.writeFloat(dt);
+    m_tick.writeVarUInt(m_commandCnt);
+    m_tick.writeBytes(m_commands.getData(), m_commands.getSize());
+    m_tick.writeUInt32(stateChecksum);
+    m_file.write(m_tick.getData(), m_tick.getSize());
+    m_commands.clear();
+    m_commandCnt = 0;
+    m_tickCnt++;
+}
+
+std::uint64_t ReplayWriter::getTickCnt() const
+{
+    return m_tickCnt;
+}
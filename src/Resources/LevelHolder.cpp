@@ -62,6 +62,8 @@ void LevelHolder::load(const std::string &fileName)
     }
     file.close();
     level->name = settings.levelName;
+    level->tileSize = { static_cast<float>(settings.tileWidth), 
+        static_cast<float>(settings.tileHeight) };
     m_levels.insert(std::make_pair(settings.id, std::move(level)));
 }
 
@@ -1,7 +1,9 @@
 #include "Screens/MainGameScreen.hpp"
+#include "Collision/CollisionBenchmark.hpp"
 #include "Collision/CollisionShape.hpp"
 #include "Collision/CollisionCircle.hpp"
 #include "Collision/CollisionRect.hpp"
+#include "Components/EntityStore.hpp"
 #include "Components/Item.hpp"
 #include "Components/SpriteNode.hpp"
 #include "Components/Warrior.hpp"
@@ -11,17 +13,36 @@
 #include "Components/Wizard.hpp"
 #include "Calc.hpp"
 #include "Helpers.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Network/LatencySimulator.hpp"
+#include "Network/LoopbackTransport.hpp"
+#include "Network/UdpTransport.hpp"
+#include "Profiling/Profiler.hpp"
+#include "Random/RandomService.hpp"
 #include <memory>
 #include "Game.hpp"
+#include <chrono>
 #include <cmath>
+#include <cstring>
+
+namespace
+{
+    // The simulation thread runs at most this number of steps to catch up
+    const float MaxPendingSimSteps{ 5.f };
+    // Both peers of a net match need the same seed, it is used when no 
+    // random_seed is set
+    const std::uint32_t DefaultNetSeed{ 0x41524E41 };
+}
 
 MainGameScreen::GameData::GameData(GameMode gameMode, std::string levelId,  
     WorldObjectTypes player1Warrior, 
-    WorldObjectTypes player2Warrior)
+    WorldObjectTypes player2Warrior, 
+    std::string replayFile)
 : gameMode{ gameMode }
 , levelId{ levelId } 
 , player1Warrior{ player1Warrior }
 , player2Warrior{ player2Warrior }
+, replayFile{ replayFile }
 {
 
 }
@@ -41,15 +62,105 @@ MainGameScreen::MainGameScreen(ScreenStack *screenStack, Context &context,
 , m_stanimaBarWarr1{ nullptr }
 , m_stanimaBarWarr2{ nullptr }
 , m_winnerText{ nullptr }
+, m_contactSolver{ static_cast<std::size_t>(std::max(1, 
+            context.config->getInt("collision_solver_iterations", 4))), 0.01f }
+, m_isParallelUpdateOn{ context.config->getBool("parallel_update", false) }
+, m_deferredActions{ context.jobSystem->getThreadCnt() }
+, m_isPipelined{ context.config->getBool("pipelined_simulation", false) &&
+    gameData.replayFile.empty() && 
+        readNetMode(*context.config, gameData) == NetMode::NONE &&
+        !isSpectatorViewer(*context.config) }
+, m_simStepTime{ 1.f / std::max(1, 
+        context.config->getInt("simulation_rate", 60)) }
+, m_simTimeBudget{ 0.f }
+, m_isSimStopping{ false }
+, m_snapshotInterpolation{ 1.f }
+, m_isReplay{ false }
+, m_isReplayDone{ false }
+, m_simStep{ 0 }
+, m_netMode{ readNetMode(*context.config, gameData) }
+, m_localPlayer{ WorldObjectTypes::PLAYER_1 }
+, m_maxRollback{ 0 }
+, m_netTimeBudget{ 0.f }
+, m_spectatorInterval{ 1.f / std::max(1, 
+        context.config->getInt("spectator_rate", 20)) }
+, m_spectatorDelay{ std::max(0, 
+        context.config->getInt("spectator_delay", 100)) / 1000.f }
+, m_matchTime{ 0.0 }
+, m_lastSpectatorTime{ 0.0 }
 , m_worldBounds{ 0.f, 0.f, 6000.f, 6000.f }
+, m_knightArchetype{ WarriorArchetype::compile(*context.configRegistry, 
+        "assets/warrior_config/knight.ini") }
+, m_runnerArchetype{ WarriorArchetype::compile(*context.configRegistry, 
+        "assets/warrior_config/runner.ini") }
+, m_wizardArchetype{ WarriorArchetype::compile(*context.configRegistry, 
+        "assets/warrior_config/wizard.ini") }
 , m_warriorPlayer1{ nullptr }
 {
+    // The nodes of the screen are created in the arena and the entity store
+    // of the screen
+    NodeArena::Scope arenaScope{ m_nodeArena };
+    EntityStore::Scope storeScope{ m_entityStore };
+    // Seeds the random numbers, so it has to be done before the scene is 
+    // built
+    setupReplay();
+    buildCollisionLayers();
     buildScene();
+    setupNetwork();
+    setupSpectators();
+    // Start with the camera at the warriors, there is nothing to interpolate
+    buildHudState(m_shownHud);
+    m_shownHud.lastCameraCenter = m_shownHud.cameraCenter;
+    if (m_isPipelined)
+    {
+        // Show the start state, until the first step is done
+        buildFrameState(m_frameBuffer.getBackBuffer());
+        m_frameBuffer.publish();
+        m_frameBuffer.acquire();
+        m_simThread = std::thread{ &MainGameScreen::runSimulation, this };
+    }
 }
 
 MainGameScreen::~MainGameScreen()
 {
+    // The thread uses the members, so it has to stop before they are 
+    // destroyed
+    stopSimulationThread();
+}
 
+void MainGameScreen::buildCollisionLayers()
+{
+    // Only these layers can collide, so e.g. shields and weapons are never
+    // tested against the level
+    CollisionLayerMatrix &layerMatrix{ m_collisionWorld.getLayerMatrix() };
+    layerMatrix.setInteraction(CollisionLayers::WARRIOR, 
+            CollisionLayers::WARRIOR, 
+            [this] (SceneNode *first, SceneNode *second, CollisionInfo &info)
+            {
+                resolveEntityCollisions(first, second, info);
+            });
+    layerMatrix.setInteraction(CollisionLayers::WARRIOR, 
+            CollisionLayers::LEVEL, 
+            [this] (SceneNode *warrior, SceneNode *level, CollisionInfo &info)
+            {
+                handleLevelContact(warrior, level, info);
+            });
+    // Projectiles are weapons too, so they can damage warriors
+    const CollisionLayerMatrix::Handler WeaponHitHandler{ 
+        [this] (SceneNode *weapon, SceneNode *warrior, CollisionInfo &info)
+        {
+            handleWeaponHit(weapon, warrior, info);
+        } };
+    layerMatrix.setInteraction(CollisionLayers::WEAPON, 
+            CollisionLayers::WARRIOR, WeaponHitHandler);
+    layerMatrix.setInteraction(CollisionLayers::PROJECTILE, 
+            CollisionLayers::WARRIOR, WeaponHitHandler);
+    layerMatrix.setInteraction(CollisionLayers::PROJECTILE, 
+            CollisionLayers::LEVEL, 
+            [this] (SceneNode *projectile, SceneNode *level, CollisionInfo &info)
+            {
+                handleProjectileImpact(projectile, level, info);
+            });
 }
 
 void MainGameScreen::buildScene()
@@ -68,13 +179,13 @@ void MainGameScreen::buildScene()
     loadInputDeviceData();
     buildGuiElements();
     // Play music
-    switch (Helpers::getRandomNum(0, 1))
+    switch (Helpers::getRandomNum(0, 1, RandomStreams::AUDIO))
     {
         case 0: m_context.music->play("gametheme01"); break;
         case 1: m_context.music->play("gametheme02"); break;
     }
     
-    std::unique_ptr<Warrior> warriorPlayer1{ 
+    NodePtr<Warrior> warriorPlayer1{ 
         createWarrior(m_gameData.player1Warrior) };
     m_warriorPlayer1 = warriorPlayer1.get();
     m_warriorPlayer1->addType(WorldObjectTypes::PLAYER_1);
@@ -82,7 +193,7 @@ void MainGameScreen::buildScene()
     m_sceneGraph.attachChild(std::move(warriorPlayer1));
 
     // Player 2
-    std::unique_ptr<Warrior> warriorPlayer2{ 
+    NodePtr<Warrior> warriorPlayer2{ 
         createWarrior(m_gameData.player2Warrior) };
     if (m_gameData.gameMode == GameMode::TWO_PLAYER)
     {
@@ -125,33 +236,30 @@ void MainGameScreen::loadInputDeviceData()
                 WorldObjectTypes::PLAYER_2 });
 }
 
-std::unique_ptr<Warrior> MainGameScreen::createWarrior(
+NodePtr<Warrior> MainGameScreen::createWarrior(
         WorldObjectTypes warriorType) 
 {
-    std::unique_ptr<Warrior> warrior{ nullptr };
-    ConfigManager configKnight("assets/warrior_config/knight.ini");
-    ConfigManager configRunner("assets/warrior_config/runner.ini");
-    ConfigManager configWizard("assets/warrior_config/wizard.ini");
+    NodePtr<Warrior> warrior{ nullptr };
     switch(warriorType)
     {
         case WorldObjectTypes::KNIGHT:
-            warrior = std::make_unique<Knight>
+            warrior = NodeArena::create<Knight>
                 (RenderLayers::MAIN,
-                 configKnight,
+                 m_knightArchetype,
                  *m_context.sound, 100.f, "knight", 
                  *m_context.textureHolder, *m_context.spriteSheetMapHolder, 
                   m_possibleTargetWarriors);
             break;
         case WorldObjectTypes::RUNNER:
-            warrior = std::make_unique<Runner>
-                (RenderLayers::MAIN, configRunner,
+            warrior = NodeArena::create<Runner>
+                (RenderLayers::MAIN, m_runnerArchetype,
                  *m_context.sound, 100.f, "runner", 
                  *m_context.textureHolder, *m_context.spriteSheetMapHolder, 
                   m_possibleTargetWarriors);
             break;
         case WorldObjectTypes::WIZARD:
-            warrior = std::make_unique<Wizard>
-                (RenderLayers::MAIN, configWizard, 
+            warrior = NodeArena::create<Wizard>
+                (RenderLayers::MAIN, m_wizardArchetype, 
                  *m_context.sound, 100.f, "wizard", 
                  *m_context.textureHolder, *m_context.spriteSheetMapHolder, 
                  m_possibleTargetWarriors);
@@ -159,6 +267,8 @@ std::unique_ptr<Warrior> MainGameScreen::createWarrior(
         default:
             assert(false && "This block should be unreachable!");
     }
+    // Used by the AI for the line of sight
+    warrior->setCollisionWorld(&m_collisionWorld);
     return std::move(warrior);
 }
 
@@ -217,14 +327,29 @@ void MainGameScreen::buildGuiElements()
 void MainGameScreen::buildLevel()
 {
     Level &level{  getContext().levelHolder->getLevel(m_gameData.levelId) };
+    // The grid has to contain all tiles, so it is as big as the last tile
+    int columns{ 0 };
+    int rows{ 0 };
+    if (level.tileSize.x > 0.f && level.tileSize.y > 0.f)
+    {
+        for (const Level::TileData &tile : level.tiles)
+        {
+            columns = std::max(columns, 
+                    static_cast<int>(tile.position.x / level.tileSize.x) + 1);
+            rows = std::max(rows, 
+                    static_cast<int>(tile.position.y / level.tileSize.y) + 1);
+        }
+    }
+    TileGrid &tileGrid{ m_collisionWorld.getTileGrid() };
+    tileGrid.create(level.tileSize, columns, rows);
     // Load the tiles
     for (const Level::TileData &tile : level.tiles)
     {
         sf::Texture &texture{ m_context.textureHolder->get("level") };
         sf::IntRect textureRect{ m_context.spriteSheetMapHolder->getRectData(
                 "level", tile.id) };
-        std::unique_ptr<SpriteNode> sprite{ 
-            std::make_unique<SpriteNode>(
+        NodePtr<SpriteNode> sprite{ 
+            NodeArena::create<SpriteNode>(
                     RenderLayers::BACKGROUND, texture, textureRect, false) };
         sprite->setOrigin(
                 sprite->getSpriteWidth() / 2.f, sprite->getSpriteHeight() /2.f);
@@ -239,6 +364,7 @@ void MainGameScreen::buildLevel()
             // centered object
             collision->setPosition(size.x / 2.f, size.y / 2.f);
             sprite->setCollisionShape(std::move(collision));
+            tileGrid.setTile(tile.position, sprite.get());
         }
         sprite->addType(WorldObjectTypes::LEVEL);
         // Object is not moving, rotating etc, so its inactive
@@ -305,6 +431,245 @@ void MainGameScreen::handleConsoleCommands(gsf::Widget* widget, sf::String comma
             }
         }
     }
+    else if (mainCom == "TRACE")
+    {
+        // TRACE START or TRACE STOP [file]
+        if (comCnt > 1 && commands[1] == "START")
+        {
+            Profiler::startCapture();
+            m_consoleWidget->addTextToDisplay("Trace capture started");
+        }
+        else if (comCnt > 1 && commands[1] == "STOP")
+        {
+            // Use the original command, so the case of the file name is kept
+            std::vector<std::string> rawCommands{ 
+                Helpers::splitString(command, ' ') };
+            bool isWritten{ rawCommands.size() > 2 ? 
+                Profiler::stopCapture(rawCommands[2]) : 
+                Profiler::stopCapture() };
+            if (isWritten)
+            {
+                m_consoleWidget->addTextToDisplay("Trace written to " + 
+                        Profiler::getLastTraceFile());
+            }
+            else
+            {
+                m_consoleWidget->addTextToDisplay("No trace written");
+            }
+        }
+        else
+        {
+            m_consoleWidget->addTextToDisplay("Usage: TRACE START|STOP [file]");
+        }
+    }
+    else if (mainCom == "SOLVER")
+    {
+        // SOLVER [iterations], without a value the stats of the last frame are
+        // shown
+        if (comCnt > 1)
+        {
+            try
+            {
+                m_contactSolver.setMaxIterations(std::stoul(commands[1]));
+            }
+            catch (...)
+            {
+                m_consoleWidget->addTextToDisplay(
+                        "No valid value as second parameter");
+            }
+        }
+        const ContactSolver::Stats &Stats{ m_contactSolver.getStats() };
+        m_consoleWidget->addTextToDisplay("Solver: contacts " + 
+                std::to_string(Stats.contactCnt) + ", bodies " + 
+                std::to_string(Stats.bodyCnt) + ", iterations " + 
+                std::to_string(Stats.iterations) + "/" + 
+                std::to_string(m_contactSolver.getMaxIterations()) + 
+                ", penetration " + std::to_string(Stats.initialPenetration) + 
+                " -> " + std::to_string(Stats.remainingPenetration));
+    }
+    else if (mainCom == "PARALLEL")
+    {
+        // PARALLEL ON|OFF, without a value the actual mode is shown
+        if (comCnt > 1 && (commands[1] == "ON" || commands[1] == "OFF"))
+        {
+            m_isParallelUpdateOn = commands[1] == "ON";
+        }
+        m_consoleWidget->addTextToDisplay("Parallel update: " + 
+                std::string{ m_isParallelUpdateOn ? "on" : "off" } + 
+                ", workers " + 
+                std::to_string(m_context.jobSystem->getWorkerCnt()));
+    }
+    else if (mainCom == "PIPELINE")
+    {
+        // Show the state of the simulation thread
+        if (!m_isPipelined)
+        {
+            m_consoleWidget->addTextToDisplay(
+                    "Pipelined simulation off (pipelined_simulation)");
+        }
+        else
+        {
+            m_consoleWidget->addTextToDisplay("Simulation steps " + 
+                    std::to_string(m_frameBuffer.getPublishedCnt()) + 
+                    ", queue depth " + 
+                    std::to_string(m_frameBuffer.getLastQueueDepth()) + 
+                    ", latency " + 
+                    std::to_string(m_frameBuffer.getFrontAge() * 1000.f) + 
+                    " ms");
+        }
+    }
+    else if (mainCom == "BENCH")
+    {
+        // BENCH COLLISION [rounds]
+        if (comCnt > 1 && commands[1] == "COLLISION")
+        {
+            std::size_t rounds{ 1000 };
+            try
+            {
+                if (comCnt > 2)
+                {
+                    rounds = std::stoul(commands[2]);
+                }
+                m_consoleWidget->addTextToDisplay(
+                        CollisionBenchmark::runRectRect(rounds));
+            }
+            catch (...)
+            {
+                m_consoleWidget->addTextToDisplay(
+                        "No valid value as third parameter");
+            }
+        }
+        // BENCH RAYCAST [rounds]
+        else if (comCnt > 1 && commands[1] == "RAYCAST")
+        {
+            std::size_t rounds{ 10000 };
+            try
+            {
+                if (comCnt > 2)
+                {
+                    rounds = std::stoul(commands[2]);
+                }
+                // Cast in the level or when there is no level in the world
+                sf::FloatRect area{ m_collisionWorld.getTileGrid().isEmpty() ? 
+                    m_worldBounds : m_collisionWorld.getTileGrid().getBounds() };
+                m_consoleWidget->addTextToDisplay(
+                        CollisionBenchmark::runRaycast(m_collisionWorld, area, 
+                            rounds));
+            }
+            catch (...)
+            {
+                m_consoleWidget->addTextToDisplay(
+                        "No valid value as third parameter");
+            }
+        }
+        else
+        {
+            m_consoleWidget->addTextToDisplay(
+                    "Usage: BENCH COLLISION|RAYCAST [rounds]");
+        }
+    }
+    else if (mainCom == "REPLAY")
+    {
+        // The file name keeps its case
+        std::vector<std::string> args{ Helpers::splitString(command, ' ') };
+        std::string file{ comCnt > 1 ? args[1] : m_context.config->getString(
+                "replay_file", "last_match.replay") };
+        // The new screen is created after this one is closed, so a recording
+        // of this match is complete
+        MainGameScreen::GameData gameData{ m_gameData.gameMode, 
+            m_gameData.levelId, m_gameData.player1Warrior, 
+            m_gameData.player2Warrior, file };
+        m_screenStack->registerScreen<MainGameScreen, 
+            MainGameScreen::GameData>(ScreenID::GAME, gameData);
+        m_screenStack->popScreen();
+        m_screenStack->pushScreen(ScreenID::GAME);
+    }
+    else if (mainCom == "SNAPSHOT")
+    {
+        // SNAPSHOT SAVE
+        if (comCnt > 1 && commands[1] == "SAVE")
+        {
+            saveSnapshot(m_quickSave);
+            m_consoleWidget->addTextToDisplay("Saved step " + 
+                    std::to_string(m_quickSave.getStep()) + " (" + 
+                    std::to_string(m_quickSave.getSize()) + " B)");
+        }
+        // SNAPSHOT LOAD
+        else if (comCnt > 1 && commands[1] == "LOAD")
+        {
+            if (m_quickSave.isEmpty())
+            {
+                m_consoleWidget->addTextToDisplay("No snapshot saved");
+            }
+            else if (m_isReplay || m_replayWriter.isOpen() || m_netSession)
+            {
+                m_consoleWidget->addTextToDisplay("A snapshot cant be "
+                        "loaded during a replay or a net match");
+            }
+            else
+            {
+                const bool IsComplete{ restoreSnapshot(m_quickSave) };
+                if (isStillPlayer1InGame() && isStillPlayer2InGame())
+                {
+                    m_winnerText->setIsVisible(false);
+                }
+                m_consoleWidget->addTextToDisplay("Loaded step " + 
+                        std::to_string(m_quickSave.getStep()) + 
+                        (IsComplete ? "" : ", not all nodes were restored"));
+            }
+        }
+        // SNAPSHOT BENCH [rounds]
+        else if (comCnt > 1 && commands[1] == "BENCH")
+        {
+            std::size_t rounds{ 100 };
+            try
+            {
+                if (comCnt > 2)
+                {
+                    rounds = std::stoul(commands[2]);
+                }
+                m_consoleWidget->addTextToDisplay(
+                        runSnapshotBenchmark(rounds));
+            }
+            catch (...)
+            {
+                m_consoleWidget->addTextToDisplay(
+                        "No valid value as third parameter");
+            }
+        }
+        else
+        {
+            m_consoleWidget->addTextToDisplay(
+                    "Usage: SNAPSHOT SAVE|LOAD|BENCH [rounds]");
+        }
+    }
+    else if (mainCom == "SPECTATORS")
+    {
+        if (m_spectatorServer)
+        {
+            m_consoleWidget->addTextToDisplay(m_spectatorServer->getReport());
+        }
+        else if (m_spectatorClient)
+        {
+            m_consoleWidget->addTextToDisplay(m_spectatorClient->getReport());
+        }
+        else
+        {
+            m_consoleWidget->addTextToDisplay(
+                    "No spectator server or viewer (see spectator_mode)");
+        }
+    }
+    else if (mainCom == "NET")
+    {
+        if (!m_netSession)
+        {
+            m_consoleWidget->addTextToDisplay("No net match (see net_mode)");
+        }
+        else
+        {
+            m_consoleWidget->addTextToDisplay(m_netSession->getReport());
+        }
+    }
 };
 
 void MainGameScreen::safeSceneNodeTrasform()
@@ -314,6 +679,7 @@ void MainGameScreen::safeSceneNodeTrasform()
 
 bool MainGameScreen::handleInput(Input &input, float dt)
 {
+    std::unique_lock<std::mutex> simLock{ lockSimulation() };
     // Check from which player the command is
     WorldObjectTypes inputPlayer{ WorldObjectTypes::NONE };
     InputDevice inputDevice{ input.getInputDevice() };
@@ -424,6 +790,8 @@ bool MainGameScreen::handleInput(Input &input, float dt)
 
 bool MainGameScreen::handleEvent(sf::Event &event, float dt)
 {
+    // The console commands change the simulation
+    std::unique_lock<std::mutex> simLock{ lockSimulation() };
     m_window.setView(m_guiView);
     m_guiEnvironment.handleEvent(event);
     m_window.setView(m_gameView);
@@ -432,17 +800,237 @@ bool MainGameScreen::handleEvent(sf::Event &event, float dt)
 
 void MainGameScreen::handleCommands(float dt)
 {
-    while(!m_commandQueue.isEmpty())
+    ProfileZone zone{ "MainGameScreen::handleCommands" };
+    if (m_isReplay)
     {
-        m_sceneGraph.onCommand(m_commandQueue.pop(), dt);
+        for (const Command &command : m_replayTick.commands)
+        {
+            m_sceneGraph.onCommand(command, dt);
+        }
+        return;
     }
+    if (m_netSession)
+    {
+        // The queue is drained into the session by advanceNetStep()
+        for (const Command &command : m_netCommands)
+        {
+            m_sceneGraph.onCommand(command, dt);
+        }
+        return;
+    }
+    m_commandQueue.drain([this, dt] (const Command &command)
+    {
+        m_replayWriter.addCommand(command);
+        m_sceneGraph.onCommand(command, dt);
+    });
 }
 
 bool MainGameScreen::update(float dt)
 {
+    ProfileZone zone{ "MainGameScreen::update" };
+    if (m_isPipelined)
+    {
+        updatePipelined(dt);
+        return false;
+    }
+    if (m_isReplay)
+    {
+        if (!m_isReplayDone)
+        {
+            runReplay();
+        }
+        // The replay is only controlled by the recorded commands
+        m_commandQueue.clear();
+    }
+    else if (m_spectatorClient)
+    {
+        updateSpectatorView(dt);
+    }
+    else if (m_netSession)
+    {
+        updateNetwork(dt);
+    }
+    else
+    {
+        simulate(dt);
+    }
+    HudState hud;
+    buildHudState(hud);
+    applyHudState(hud, dt);
+    return false;
+}
+
+void MainGameScreen::updatePipelined(float dt)
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_simTimeMutex };
+        // When the simulation cant keep up, it drops the time instead of 
+        // running behind forever
+        m_simTimeBudget = std::min(m_simTimeBudget + dt, 
+                m_simStepTime * MaxPendingSimSteps);
+    }
+    m_simTimeCondition.notify_one();
+    if (m_frameBuffer.acquire())
+    {
+        Profiler::setCounter("snapshot queue depth", 
+                m_frameBuffer.getLastQueueDepth());
+    }
+    // The snapshot shows the step which ended when it was published, so it
+    // is interpolated over the time of one step
+    m_snapshotInterpolation = std::min(1.f, 
+            m_frameBuffer.getFrontAge() / m_simStepTime);
+    applyHudState(m_frameBuffer.getFrontBuffer().hud, dt);
+}
+
+void MainGameScreen::runSimulation()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{ m_simTimeMutex };
+            m_simTimeCondition.wait(lock, [this] ()
+                    {
+                        return m_isSimStopping || 
+                            m_simTimeBudget >= m_simStepTime;
+                    });
+            if (m_isSimStopping)
+            {
+                return;
+            }
+            m_simTimeBudget -= m_simStepTime;
+        }
+        {
+            std::lock_guard<std::mutex> lock{ m_simMutex };
+            simulate(m_simStepTime);
+            buildFrameState(m_frameBuffer.getBackBuffer());
+        }
+        m_frameBuffer.publish();
+    }
+}
+
+void MainGameScreen::stopSimulationThread()
+{
+    if (!m_simThread.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{ m_simTimeMutex };
+        m_isSimStopping = true;
+    }
+    m_simTimeCondition.notify_all();
+    m_simThread.join();
+}
 
+std::unique_lock<std::mutex> MainGameScreen::lockSimulation()
+{
+    if (!m_isPipelined)
+    {
+        // There is no other thread, which uses the simulation
+        return std::unique_lock<std::mutex>{ m_simMutex, std::defer_lock };
+    }
+    return std::unique_lock<std::mutex>{ m_simMutex };
+}
+
+void MainGameScreen::buildFrameState(FrameState &frameState)
+{
+    ProfileZone zone{ "MainGameScreen::buildFrameState" };
+    frameState.scene.clear();
+    m_sceneGraph.addToRenderSnapshot(frameState.scene, 
+            RenderSnapshot::NoParent);
+    frameState.scene.sortByLayer();
+    buildHudState(frameState.hud);
+}
+
+void MainGameScreen::buildHudState(HudState &hud)
+{
+    hud.isPlayer1InGame = m_warriorPlayer1 != nullptr;
+    hud.isPlayer2InGame = m_warriorPlayer2 != nullptr;
+    if (m_warriorPlayer1)
+    {
+        hud.player1Health = m_warriorPlayer1->getCurrentHealth();
+        hud.player1Stanima = m_warriorPlayer1->getCurrentStanima();
+    }
+    if (m_warriorPlayer2)
+    {
+        hud.player2Health = m_warriorPlayer2->getCurrentHealth();
+        hud.player2Stanima = m_warriorPlayer2->getCurrentStanima();
+    }
+    hud.lastCameraCenter = m_cameraCenter;
+    hud.hasCameraCenter = getCameraCenter(m_cameraCenter);
+    hud.cameraCenter = m_cameraCenter;
+}
+
+void MainGameScreen::applyHudState(const HudState &hud, float dt)
+{
+    m_window.setView(m_guiView);
+    m_guiEnvironment.update(dt);
+    m_window.setView(m_gameView);
+    if (hud.isPlayer1InGame)
+    {
+        m_healthBarWarr1->setProgress(hud.player1Health);
+        m_stanimaBarWarr1->setProgress(hud.player1Stanima);
+    }
+    if (hud.isPlayer2InGame)
+    {
+        m_healthBarWarr2->setProgress(hud.player2Health);
+        m_stanimaBarWarr2->setProgress(hud.player2Stanima);
+    }
+    showWinner(hud);
+    if (hud.hasCameraCenter)
+    {
+        // The sounds of the combat are heard from the camera, the warriors
+        // outside of the view are quieter
+        m_context.sound->setListener(hud.cameraCenter, m_gameView.getSize().x);
+    }
+    m_shownHud = hud;
+}
+
+void MainGameScreen::updateCamera(float interpolation)
+{
+    if (m_shownHud.hasCameraCenter)
+    {
+        m_gameView.setCenter(m_shownHud.lastCameraCenter + 
+                (m_shownHud.cameraCenter - m_shownHud.lastCameraCenter) * 
+                interpolation);
+    }
+}
+
+void MainGameScreen::simulate(float dt)
+{
+    ProfileZone zone{ "MainGameScreen::simulate" };
+    // Nodes created by the warriors (e.g. fireballs) go into the arena
+    NodeArena::Scope arenaScope{ m_nodeArena };
+    EntityStore::Scope storeScope{ m_entityStore };
     safeSceneNodeTrasform();
     handleCommands(dt);
+    removeDestroyedNodes();
+    updateSceneGraph(dt);
+    {
+        // The systems process the state of all entities at once
+        ProfileZone systemsZone{ "EntityStore::systems" };
+        m_entityStore.integrateMovement(dt);
+        m_entityStore.regenerateStamina(dt);
+    }
+    // Counting the nodes walks the whole scene graph
+    if (Profiler::isCapturing())
+    {
+        Profiler::setCounter("scene nodes", m_sceneGraph.getNodeCount());
+        Profiler::setCounter("entities", m_entityStore.getEntityCnt());
+    }
+    
+    handleCollision(dt);
+    if (m_replayWriter.isOpen())
+    {
+        m_replayWriter.endTick(dt, computeStateChecksum());
+    }
+    m_simStep++;
+    m_matchTime += dt;
+    publishSpectatorState();
+}
+
+void MainGameScreen::removeDestroyedNodes()
+{
     // Get iterator, pointing on the first element which should get erased
     auto destroyBegin = std::remove_if(m_possibleTargetWarriors.begin(), 
             m_possibleTargetWarriors.end(), 
@@ -451,35 +1039,128 @@ bool MainGameScreen::update(float dt)
     m_possibleTargetWarriors.erase(destroyBegin, m_possibleTargetWarriors.end());
     handleWinner();
 
+    // The collision world must not keep the removed nodes for the queries
+    m_collisionWorld.removeDestroyed();
     m_sceneGraph.removeDestroyed();
-    m_sceneGraph.update(dt);
-    
-    handleCollision(dt);
-    
-    m_window.setView(m_guiView);
-    m_guiEnvironment.update(dt);
-    m_window.setView(m_gameView);
-    if (m_warriorPlayer1)
+}
+
+void MainGameScreen::saveSnapshot(WorldSnapshot &snapshot)
+{
+    ProfileZone zone{ "MainGameScreen::saveSnapshot" };
+    snapshot.save(m_sceneGraph, m_simStep);
+}
+
+bool MainGameScreen::restoreSnapshot(WorldSnapshot &snapshot)
+{
+    ProfileZone zone{ "MainGameScreen::restoreSnapshot" };
+    // The created nodes go into the arena like the ones of the simulation
+    NodeArena::Scope arenaScope{ m_nodeArena };
+    EntityStore::Scope storeScope{ m_entityStore };
+    const bool IsComplete{ snapshot.restore(m_sceneGraph, 
+            [this] (unsigned int types, SceneNode *spawner)
+            {
+                return createSnapshotNode(types, spawner);
+            }) };
+    m_simStep = snapshot.getStep();
+    removeDestroyedNodes();
+    // The contacts begin again, the hit ids of the weapons prevent that an
+    // attack hits twice
+    m_collisionWorld.clearContacts();
+    return IsComplete;
+}
+
+SceneNode::Ptr MainGameScreen::createSnapshotNode(unsigned int types, 
+        SceneNode *spawner)
+{
+    if (types & WorldObjectTypes::PROJECTILE)
     {
-        m_healthBarWarr1->setProgress(m_warriorPlayer1->getCurrentHealth());
-        m_stanimaBarWarr1->setProgress(m_warriorPlayer1->getCurrentStanima());
+        if (spawner && spawner->getType() & WorldObjectTypes::WARRIOR)
+        {
+            return static_cast<Warrior*>(spawner)->createProjectile();
+        }
+        return nullptr;
     }
-    if (m_warriorPlayer2)
+    // A killed warrior
+    const unsigned int WarriorType{ types & (WorldObjectTypes::KNIGHT | 
+            WorldObjectTypes::RUNNER | WorldObjectTypes::WIZARD) };
+    if (!(types & WorldObjectTypes::WARRIOR) || 
+            (WarriorType != WorldObjectTypes::KNIGHT && 
+             WarriorType != WorldObjectTypes::RUNNER &&
+             WarriorType != WorldObjectTypes::WIZARD))
     {
-        m_healthBarWarr2->setProgress(m_warriorPlayer2->getCurrentHealth());
-        m_stanimaBarWarr2->setProgress(m_warriorPlayer2->getCurrentStanima());
+        return nullptr;
     }
-    
-    updateCamera(dt);
-    
-    return false;
+    NodePtr<Warrior> warrior{ 
+        createWarrior(static_cast<WorldObjectTypes>(WarriorType)) };
+    warrior->addType(types & (WorldObjectTypes::PLAYER_1 | 
+                WorldObjectTypes::PLAYER_2 | WorldObjectTypes::ENEMY));
+    if (types & WorldObjectTypes::PLAYER_1)
+    {
+        m_warriorPlayer1 = warrior.get();
+    }
+    else
+    {
+        m_warriorPlayer2 = warrior.get();
+    }
+    m_possibleTargetWarriors.push_back(warrior.get());
+    return std::move(warrior);
 }
 
-void MainGameScreen::updateCamera(float dt)
+std::string MainGameScreen::runSnapshotBenchmark(std::size_t rounds)
+{
+    rounds = std::max<std::size_t>(rounds, 1);
+    WorldSnapshot snapshot;
+    // The first save allocates the buffers
+    saveSnapshot(snapshot);
+    const auto SaveStart = std::chrono::steady_clock::now();
+    for (std::size_t i{ 0 }; i < rounds; i++)
+    {
+        saveSnapshot(snapshot);
+    }
+    const auto RestoreStart = std::chrono::steady_clock::now();
+    bool isComplete{ true };
+    for (std::size_t i{ 0 }; i < rounds; i++)
+    {
+        isComplete = restoreSnapshot(snapshot) && isComplete;
+    }
+    const auto EndTime = std::chrono::steady_clock::now();
+    const float SaveTime{ std::chrono::duration<float, std::micro>{ 
+        RestoreStart - SaveStart }.count() / rounds };
+    const float RestoreTime{ std::chrono::duration<float, std::micro>{ 
+        EndTime - RestoreStart }.count() / rounds };
+    return "Snapshot: " + std::to_string(snapshot.getNodeCnt()) + 
+        " nodes, " + std::to_string(snapshot.getSize()) + " B\nSave: " + 
+        std::to_string(static_cast<int>(SaveTime)) + " us Restore: " + 
+        std::to_string(static_cast<int>(RestoreTime)) + " us" + 
+        (isComplete ? "" : " (incomplete)");
+}
+
+void MainGameScreen::updateSceneGraph(float dt)
+{
+    ProfileZone sceneZone{ "SceneNode::update" };
+    if (!m_isParallelUpdateOn || m_context.jobSystem->getWorkerCnt() == 0)
+    {
+        m_sceneGraph.update(dt);
+        return;
+    }
+    m_sceneGraph.updateParallel(dt, *m_context.jobSystem, m_deferredActions, 
+            m_parallelChildren);
+    // Spawn the nodes etc. on this thread, after all nodes are updated
+    ProfileZone deferredZone{ "DeferredActions::execute" };
+    m_deferredActions.execute();
+    Profiler::setCounter("deferred actions", 
+            m_deferredActions.getLastActionCnt());
+}
+
+bool MainGameScreen::getCameraCenter(sf::Vector2f &center) const
 {
     if (m_gameData.gameMode == GameMode::ONE_PLAYER)
     {
-        m_gameView.setCenter(m_warriorPlayer1->getWorldPosition());
+        if (m_warriorPlayer1)
+        {
+            center = m_warriorPlayer1->getWorldPosition();
+            return true;
+        }
     }
     else if (m_gameData.gameMode == GameMode::TWO_PLAYER)
     {
@@ -488,19 +1169,539 @@ void MainGameScreen::updateCamera(float dt)
         {
             sf::Vector2f pos1{ m_warriorPlayer1->getWorldPosition() };
             sf::Vector2f pos2{ m_warriorPlayer2->getWorldPosition() };
-            sf::Vector2f center{  pos1 + ((pos2 - pos1) / 2.f) };
-            m_gameView.setCenter(center);
+            center = pos1 + ((pos2 - pos1) / 2.f);
+            return true;
         }
         // Place camera to the left warrior
         else if (m_warriorPlayer1)
         {
-            m_gameView.setCenter(m_warriorPlayer1->getWorldPosition());
+            center = m_warriorPlayer1->getWorldPosition();
+            return true;
         }
         else if (m_warriorPlayer2)
         {
-            m_gameView.setCenter(m_warriorPlayer2->getWorldPosition());
+            center = m_warriorPlayer2->getWorldPosition();
+            return true;
+        }
+    }
+    return false;
+}
+
+void MainGameScreen::setupReplay()
+{
+    const std::string ReplayFile{ m_gameData.replayFile };
+    if (!ReplayFile.empty())
+    {
+        if (m_replayReader.open(ReplayFile))
+        {
+            const ReplayHeader &Header{ m_replayReader.getHeader() };
+            m_gameData = GameData{ static_cast<GameMode>(Header.gameMode), 
+                Header.levelId, 
+                static_cast<WorldObjectTypes>(Header.player1Warrior),
+                static_cast<WorldObjectTypes>(Header.player2Warrior), 
+                ReplayFile };
+            RandomService::seed(Header.randomSeed);
+            m_isReplay = true;
+            return;
+        }
+        std::cout << "Could not open replay: " << ReplayFile << std::endl;
+    }
+    // Every match gets a new seed, which is stored in the replay, unless a 
+    // fixed seed is set
+    const int ConfigSeed{ m_context.config->getInt("random_seed", 0) };
+    std::uint32_t seed{ ConfigSeed != 0 ? 
+        static_cast<std::uint32_t>(ConfigSeed) : RandomService::createSeed() };
+    if (m_netMode != NetMode::NONE && ConfigSeed == 0)
+    {
+        seed = DefaultNetSeed;
+    }
+    RandomService::seed(seed);
+    // The rollbacks would record the steps twice
+    if (m_context.config->getBool("record_replay", false) && 
+            m_netMode == NetMode::NONE && 
+            !isSpectatorViewer(*m_context.config))
+    {
+        const std::string File{ m_context.config->getString("replay_file", 
+                "last_match.replay") };
+        ReplayHeader header{ seed, static_cast<std::uint8_t>(
+                m_gameData.gameMode), m_gameData.levelId, 
+            m_gameData.player1Warrior, m_gameData.player2Warrior };
+        if (!m_replayWriter.open(File, header))
+        {
+            std::cout << "Could not write replay: " << File << std::endl;
+        }
+    }
+}
+
+void MainGameScreen::runReplay()
+{
+    ProfileZone zone{ "MainGameScreen::runReplay" };
+    std::uint64_t tickCnt{ 0 };
+    std::uint64_t firstDifferentTick{ 0 };
+    bool isDifferent{ false };
+    const auto StartTime = std::chrono::steady_clock::now();
+    while (m_replayReader.readTick(m_replayTick))
+    {
+        simulate(m_replayTick.dt);
+        tickCnt++;
+        if (!isDifferent && 
+                computeStateChecksum() != m_replayTick.stateChecksum)
+        {
+            isDifferent = true;
+            firstDifferentTick = tickCnt;
+        }
+    }
+    const float Time{ std::chrono::duration<float>{ 
+        std::chrono::steady_clock::now() - StartTime }.count() };
+    m_isReplayDone = true;
+
+    std::string report{ "Replayed " + std::to_string(tickCnt) + " steps in " +
+        std::to_string(static_cast<int>(Time * 1000.f)) + " ms (" +
+        std::to_string(static_cast<int>(tickCnt / std::max(Time, 0.001f))) +
+        " steps/s)" };
+    if (!m_replayReader.isValid())
+    {
+        report += ", the file is corrupt";
+    }
+    report += isDifferent ? ", state differs from step " + 
+        std::to_string(firstDifferentTick) : ", state matches the recording";
+    std::cout << report << std::endl;
+    m_consoleWidget->addTextToDisplay(report);
+}
+
+MainGameScreen::NetMode MainGameScreen::readNetMode(
+        const ConfigManager &config, const GameData &gameData)
+{
+    if (gameData.gameMode != GameMode::TWO_PLAYER || 
+            !gameData.replayFile.empty() || isSpectatorViewer(config))
+    {
+        return NetMode::NONE;
+    }
+    const std::string Mode{ config.getString("net_mode", "none") };
+    if (Mode == "host")
+    {
+        return NetMode::HOST;
+    }
+    if (Mode == "client")
+    {
+        return NetMode::CLIENT;
+    }
+    if (Mode == "loopback")
+    {
+        return NetMode::LOOPBACK;
+    }
+    return NetMode::NONE;
+}
+
+void MainGameScreen::setupNetwork()
+{
+    if (m_netMode == NetMode::NONE)
+    {
+        return;
+    }
+    const ConfigManager &Config{ *m_context.config };
+    const std::size_t InputDelay{ static_cast<std::size_t>(
+            std::max(0, Config.getInt("net_input_delay", 2))) };
+    // The session cant predict more steps than its buffer holds
+    m_maxRollback = static_cast<std::uint64_t>(std::min(std::max(1, 
+                    Config.getInt("net_max_rollback", 8)), 
+                static_cast<int>(RollbackSession::BufferSize / 2)));
+    m_rollbackSnapshots.resize(static_cast<std::size_t>(m_maxRollback) + 1);
+    const float Delay{ Config.getInt("net_delay", 0) / 1000.f };
+    const float Jitter{ Config.getInt("net_jitter", 0) / 1000.f };
+    const float Loss{ Config.getInt("net_loss", 0) / 100.f };
+    const bool IsLatencySimulated{ Delay > 0.f || Jitter > 0.f || Loss > 0.f };
+    auto simulateLatency = [=] (std::unique_ptr<NetTransport> transport)
+    {
+        if (!IsLatencySimulated)
+        {
+            return transport;
+        }
+        return std::unique_ptr<NetTransport>{ new LatencySimulator{ 
+            std::move(transport), Delay, Jitter, Loss } };
+    };
+
+    if (m_netMode == NetMode::LOOPBACK)
+    {
+        std::unique_ptr<LoopbackTransport> transport{ new LoopbackTransport };
+        std::unique_ptr<LoopbackTransport> loopbackTransport{ 
+            new LoopbackTransport };
+        LoopbackTransport::connect(*transport, *loopbackTransport);
+        m_netTransport = simulateLatency(std::move(transport));
+        m_loopbackTransport = simulateLatency(std::move(loopbackTransport));
+        m_netSession.reset(new RollbackSession{ *m_netTransport, 
+                WorldObjectTypes::PLAYER_2, InputDelay });
+        m_loopbackSession.reset(new RollbackSession{ *m_loopbackTransport, 
+                WorldObjectTypes::PLAYER_1, InputDelay });
+        return;
+    }
+
+    // The host waits for the first packet of the client, the client can 
+    // use any port, so both games can run on the same machine
+    const bool IsHost{ m_netMode == NetMode::HOST };
+    const unsigned short Port{ static_cast<unsigned short>(
+            Config.getInt("net_port", 41230)) };
+    const unsigned short LocalPort{ IsHost ? Port : 
+        static_cast<unsigned short>(sf::Socket::AnyPort) };
+    const sf::IpAddress RemoteAddress{ IsHost ? sf::IpAddress::None : 
+        sf::IpAddress{ Config.getString("net_remote_address", "127.0.0.1") } };
+    std::unique_ptr<UdpTransport> transport{ new UdpTransport };
+    if (!transport->open(LocalPort, RemoteAddress, Port))
+    {
+        std::cout << "Could not bind the net port: " << LocalPort << std::endl;
+    }
+    m_netTransport = simulateLatency(std::move(transport));
+    m_localPlayer = IsHost ? WorldObjectTypes::PLAYER_1 : 
+        WorldObjectTypes::PLAYER_2;
+    m_netSession.reset(new RollbackSession{ *m_netTransport, IsHost ? 
+            WorldObjectTypes::PLAYER_2 : WorldObjectTypes::PLAYER_1, 
+            InputDelay });
+    // Every input device of this game controls the local player
+    for (auto &device : m_deviceMap)
+    {
+        device.second = m_localPlayer;
+    }
+}
+
+void MainGameScreen::updateNetwork(float dt)
+{
+    m_netTimeBudget = std::min(m_netTimeBudget + dt, 
+            m_simStepTime * MaxPendingSimSteps);
+    while (m_netTimeBudget >= m_simStepTime)
+    {
+        if (!advanceNetStep())
+        {
+            break;
+        }
+        m_netTimeBudget -= m_simStepTime;
+    }
+    Profiler::setCounter("net predicted steps", 
+            m_simStep - std::min(m_simStep, 
+                m_netSession->getConfirmedStep()));
+}
+
+bool MainGameScreen::advanceNetStep()
+{
+    ProfileZone zone{ "MainGameScreen::advanceNetStep" };
+    m_netSession->receive();
+    if (m_loopbackSession)
+    {
+        m_loopbackSession->receive();
+    }
+    const bool CanAddCommands{ m_netSession->canAddLocalCommands() && 
+        (!m_loopbackSession || m_loopbackSession->canAddLocalCommands()) };
+    if (!CanAddCommands || 
+            m_simStep >= m_netSession->getConfirmedStep() + m_maxRollback)
+    {
+        // Wait until the remote peer catches up, the inputs of the waiting
+        // time are dropped
+        m_commandQueue.clear();
+        m_netSession->send();
+        if (m_loopbackSession)
+        {
+            m_loopbackSession->send();
+        }
+        m_netSession->countStall();
+        return false;
+    }
+
+    m_localCommands.clear();
+    m_loopbackCommands.clear();
+    m_commandQueue.drain([this] (const Command &command)
+    {
+        if (command.getWorldObjectType() == m_localPlayer)
+        {
+            m_localCommands.push_back(command);
+        }
+        else if (m_loopbackSession && 
+                command.getWorldObjectType() == WorldObjectTypes::PLAYER_2)
+        {
+            m_loopbackCommands.push_back(command);
+        }
+    });
+    m_netSession->addLocalCommands(m_localCommands);
+    m_netSession->send();
+    if (m_loopbackSession)
+    {
+        m_loopbackSession->addLocalCommands(m_loopbackCommands);
+        m_loopbackSession->send();
+    }
+
+    const std::uint64_t RollbackStep{ m_netSession->popRollbackStep() };
+    if (RollbackStep < m_simStep)
+    {
+        rollback(RollbackStep);
+    }
+    simulateNetStep();
+    return true;
+}
+
+void MainGameScreen::simulateNetStep()
+{
+    saveSnapshot(m_rollbackSnapshots[m_simStep % m_rollbackSnapshots.size()]);
+    if (!m_netSession->getCommands(m_simStep, m_netCommands))
+    {
+        assert(false && "The local commands of the step are missing!");
+    }
+    simulate(m_simStepTime);
+    // Only the states of confirmed steps are the same in both games
+    const std::uint64_t Step{ m_simStep - 1 };
+    if (Step < m_netSession->getConfirmedStep())
+    {
+        m_netSession->setChecksum(Step, computeStateChecksum());
+    }
+}
+
+void MainGameScreen::rollback(std::uint64_t step)
+{
+    ProfileZone zone{ "MainGameScreen::rollback" };
+    WorldSnapshot &snapshot{ 
+        m_rollbackSnapshots[step % m_rollbackSnapshots.size()] };
+    if (snapshot.isEmpty() || snapshot.getStep() != step)
+    {
+        // Cant happen, because the game waits before it predicts more steps
+        // than it has snapshots
+        std::cout << "No snapshot for the rollback to step " << step << 
+            std::endl;
+        return;
+    }
+    const std::uint64_t CurrentStep{ m_simStep };
+    restoreSnapshot(snapshot);
+    // The steps are simulated again with the same time
+    m_matchTime -= (CurrentStep - step) * m_simStepTime;
+    // The sounds of the steps were already played
+    m_context.sound->setIsMuted(true);
+    while (m_simStep < CurrentStep)
+    {
+        simulateNetStep();
+    }
+    m_context.sound->setIsMuted(false);
+    if (isStillPlayer1InGame() && isStillPlayer2InGame())
+    {
+        m_winnerText->setIsVisible(false);
+    }
+    m_netSession->countRollback(CurrentStep - step);
+    Profiler::setCounter("rollback depth", CurrentStep - step);
+}
+
+bool MainGameScreen::isSpectatorViewer(const ConfigManager &config)
+{
+    return config.getString("spectator_mode", "none") == "viewer";
+}
+
+void MainGameScreen::setupSpectators()
+{
+    const ConfigManager &Config{ *m_context.config };
+    const std::string Mode{ Config.getString("spectator_mode", "none") };
+    const unsigned short Port{ static_cast<unsigned short>(
+            Config.getInt("spectator_port", 41240)) };
+    if (Mode == "server" && m_gameData.replayFile.empty())
+    {
+        m_spectatorServer.reset(new SpectatorServer);
+        if (!m_spectatorServer->open(Port))
+        {
+            std::cout << "Could not bind the spectator port: " << Port << 
+                std::endl;
+        }
+    }
+    else if (Mode == "viewer")
+    {
+        m_spectatorClient.reset(new SpectatorClient);
+        const sf::IpAddress Address{ 
+            Config.getString("spectator_address", "127.0.0.1") };
+        if (!m_spectatorClient->open(Address, Port))
+        {
+            std::cout << "Could not open the spectator socket" << std::endl;
+        }
+    }
+}
+
+void MainGameScreen::publishSpectatorState()
+{
+    if (!m_spectatorServer || 
+            m_matchTime - m_lastSpectatorTime < m_spectatorInterval)
+    {
+        return;
+    }
+    ProfileZone zone{ "MainGameScreen::publishSpectatorState" };
+    m_lastSpectatorTime = m_matchTime;
+    SpectatorState &state{ m_spectatorServer->beginState() };
+    state.time = static_cast<std::uint64_t>(m_matchTime * 1000.0);
+    // The warriors and the projectiles are the top level nodes
+    m_spectatorScratch.clear();
+    m_sceneGraph.collectNodes(m_spectatorScratch);
+    auto removeBegin = std::remove_if(m_spectatorScratch.begin(), 
+            m_spectatorScratch.end(), [this] (const SceneNode *node)
+            {
+                return node->getParent() != &m_sceneGraph || 
+                    !(node->getType() & (WorldObjectTypes::WARRIOR | 
+                                WorldObjectTypes::PROJECTILE));
+            });
+    m_spectatorScratch.erase(removeBegin, m_spectatorScratch.end());
+    std::sort(m_spectatorScratch.begin(), m_spectatorScratch.end(), 
+            [] (const SceneNode *a, const SceneNode *b)
+            {
+                return a->getNodeId() < b->getNodeId();
+            });
+    for (const SceneNode *node : m_spectatorScratch)
+    {
+        float health{ 0.f };
+        float stanima{ 0.f };
+        unsigned int spawnerId{ 0 };
+        if (node->getType() & WorldObjectTypes::WARRIOR)
+        {
+            const Warrior *warrior{ static_cast<const Warrior*>(node) };
+            health = warrior->getCurrentHealth();
+            stanima = warrior->getCurrentStanima();
+        }
+        else
+        {
+            spawnerId = static_cast<const Weapon*>(node)->getSpawnerId();
+        }
+        state.addEntity(node->getNodeId(), node->getType(), spawnerId, 
+                node->getPosition(), node->getRotation(), health, stanima);
+    }
+    m_spectatorServer->publish();
+    Profiler::setCounter("spectator bytes/s", 
+            m_spectatorServer->getBytesPerSecond());
+}
+
+void MainGameScreen::updateSpectatorView(float dt)
+{
+    ProfileZone zone{ "MainGameScreen::updateSpectatorView" };
+    // The viewer cant control the match
+    m_commandQueue.clear();
+    m_spectatorClient->update();
+    Profiler::setCounter("spectator bytes/s", 
+            m_spectatorClient->getBytesPerSecond());
+    NodeArena::Scope arenaScope{ m_nodeArena };
+    EntityStore::Scope storeScope{ m_entityStore };
+    // The render interpolates from the last update to this one
+    safeSceneNodeTrasform();
+    if (m_spectatorClient->interpolate(
+                m_spectatorClient->getServerTime() - m_spectatorDelay, 
+                m_spectatorView))
+    {
+        applySpectatorView();
+    }
+    removeDestroyedNodes();
+}
+
+void MainGameScreen::applySpectatorView()
+{
+    const unsigned int WarriorTypes{ WorldObjectTypes::KNIGHT | 
+        WorldObjectTypes::RUNNER | WorldObjectTypes::WIZARD };
+    std::vector<std::pair<unsigned int, SceneNode*>> shownNodes;
+    for (const SpectatorClient::ViewEntity &View : m_spectatorView)
+    {
+        SceneNode *node{ findSpectatorNode(View.id) };
+        if (View.types & WorldObjectTypes::WARRIOR)
+        {
+            // The warriors of the viewer are matched by the player
+            Warrior *&player{ View.types & WorldObjectTypes::PLAYER_1 ? 
+                m_warriorPlayer1 : m_warriorPlayer2 };
+            const unsigned int WarriorType{ View.types & WarriorTypes };
+            if (player && (player->getType() & WarriorTypes) != WarriorType)
+            {
+                player->setStatus(WorldObjectStatus::DESTORYED);
+                player = nullptr;
+            }
+            if (!player && WarriorType != 0)
+            {
+                NodePtr<Warrior> warrior{ createWarrior(
+                        static_cast<WorldObjectTypes>(WarriorType)) };
+                warrior->addType(View.types & (WorldObjectTypes::PLAYER_1 | 
+                            WorldObjectTypes::PLAYER_2 | 
+                            WorldObjectTypes::ENEMY));
+                warrior->setIsAiActive(false);
+                player = warrior.get();
+                m_possibleTargetWarriors.push_back(player);
+                m_sceneGraph.attachChild(std::move(warrior));
+            }
+            if (!player)
+            {
+                continue;
+            }
+            player->setCurrentHealth(View.health);
+            player->setCurrentStanima(View.stanima);
+            player->setRotation(View.rotation);
+            node = player;
+        }
+        else if (View.types & WorldObjectTypes::PROJECTILE)
+        {
+            SceneNode *spawner{ findSpectatorNode(View.spawnerId) };
+            if (!node && spawner && 
+                    spawner->getType() & WorldObjectTypes::WARRIOR)
+            {
+                NodePtr<Weapon> projectile{ 
+                    static_cast<Warrior*>(spawner)->createProjectile() };
+                if (projectile)
+                {
+                    node = projectile.get();
+                    m_sceneGraph.attachChild(std::move(projectile));
+                }
+            }
+            if (!node)
+            {
+                continue;
+            }
+            static_cast<Weapon*>(node)->setRotationDefault(View.rotation);
+        }
+        node->setPosition(View.position);
+        shownNodes.push_back({ View.id, node });
+    }
+    // The nodes which are gone on the server
+    for (const auto &Shown : m_spectatorNodes)
+    {
+        if (std::find(shownNodes.begin(), shownNodes.end(), Shown) == 
+                shownNodes.end())
+        {
+            Shown.second->setStatus(WorldObjectStatus::DESTORYED);
         }
     }
+    m_spectatorNodes.swap(shownNodes);
+}
+
+SceneNode* MainGameScreen::findSpectatorNode(unsigned int serverId) const
+{
+    for (const auto &Shown : m_spectatorNodes)
+    {
+        if (Shown.first == serverId)
+        {
+            return Shown.second;
+        }
+    }
+    return nullptr;
+}
+
+std::uint32_t MainGameScreen::computeStateChecksum() const
+{
+    // FNV-1a over the bits of the values
+    std::uint32_t hash{ 2166136261u };
+    auto addValue = [&hash] (std::uint32_t value)
+    {
+        for (int i{ 0 }; i < 4; i++)
+        {
+            hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 16777619u;
+        }
+    };
+    auto addFloat = [&addValue] (float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        addValue(bits);
+    };
+    addValue(static_cast<std::uint32_t>(m_sceneGraph.getNodeCount()));
+    for (const Warrior *warrior : m_possibleTargetWarriors)
+    {
+        const sf::Vector2f Position{ warrior->getWorldPosition() };
+        addFloat(Position.x);
+        addFloat(Position.y);
+        addFloat(warrior->getRotation());
+        addFloat(warrior->getCurrentHealth());
+        addFloat(warrior->getCurrentStanima());
+    }
+    return hash;
 }
 
 void MainGameScreen::handleWinner()
@@ -514,17 +1715,21 @@ void MainGameScreen::handleWinner()
     {
         m_warriorPlayer2 = nullptr;
     }
+}
+
+void MainGameScreen::showWinner(const HudState &hud)
+{
     // If the winner is already set, nothing to do
     if (m_winnerText->isVisible())
     {
         return;
     }
-    if (!m_warriorPlayer1)
+    if (!hud.isPlayer1InGame)
     {
         m_winnerText->setText("PLAYER2 WINS");
         m_winnerText->setIsVisible(true);
     }
-    else if (!m_warriorPlayer2)
+    else if (!hud.isPlayer2InGame)
     {
         m_winnerText->setText("PLAYER1 WINS");
         m_winnerText->setIsVisible(true);
@@ -572,121 +1777,138 @@ void MainGameScreen::resolveEntityCollisions(SceneNode *sceneNodeFirst,
 void MainGameScreen::resolveEntityCollisions(SceneNode *sceneNodeFirst, 
         SceneNode *sceneNodeSecond, CollisionInfo &collisionInfo)
 {
-    Entity *entityOne{ static_cast<Entity*>(sceneNodeFirst) };
-    Entity *entityTwo{ static_cast<Entity*>(sceneNodeSecond) };
-    float massEntityOne{ entityOne->getMass() };
-    float massEntityTwo{ entityTwo->getMass() };
-    float massSum{ massEntityOne + massEntityTwo };
-    if (massSum <= 0.f)
+    // The contact is only collected here and resolved together with the other
+    // contacts of the frame by the solver
+    m_contactSolver.addContact(static_cast<Entity*>(sceneNodeFirst), 
+            static_cast<Entity*>(sceneNodeSecond), 
+            collisionInfo.getResolveDirOfFirst(), collisionInfo.getLength());
+}
+
+void MainGameScreen::handleWeaponHit(SceneNode *weaponNode, 
+        SceneNode *warriorNode, CollisionInfo &collisionInfo)
+{
+    // The game logic only reacts once to a contact
+    if (collisionInfo.getContactState() == ContactStates::STAY)
     {
         return;
     }
-    float massProp1{ massEntityOne / massSum };
-    float massProp2{ massEntityTwo / massSum };
-    float overlap{ collisionInfo.getLength() };
-    entityOne->moveInDirection(collisionInfo.getResolveDirOfFirst(), 
-            overlap * massProp2);
-    entityTwo->moveInDirection(collisionInfo.getResolveDirOfSecond(), 
-            overlap * massProp1);
+    Weapon *weapon{ static_cast<Weapon*>(weaponNode) };
+    Warrior *warrior{ static_cast<Warrior*>(warriorNode) };
+    std::string warriorID{ warrior->getID() };
+    // Only damage warrior if the weapon is not its own
+    // Alternative implementation for future (?): no collision check with 
+    // parent nodes
+    if (warrior->getWeapon() != weapon && 
+            !weapon->wasIDAlreadyAttacked(warriorID))
+    {
+        warrior->handleDamage(weapon);
+        // If the weapon was a projectile it should get destroyed after
+        // colliding with warrior
+        if (weapon->getType() & WorldObjectTypes::PROJECTILE)
+        {
+            weapon->setStatus(WorldObjectStatus::DESTORYED);
+        }
+    }
+}
+
+void MainGameScreen::handleLevelContact(SceneNode *warriorNode, 
+        SceneNode *levelNode, CollisionInfo &collisionInfo)
+{
+    // The positions of touching nodes have to be corrected in every frame
+    sf::Vector2f resolveDir{ collisionInfo.getCollidedFirst() == warriorNode ? 
+        collisionInfo.getResolveDirOfFirst() : 
+        collisionInfo.getResolveDirOfSecond() };
+    m_contactSolver.addStaticContact(static_cast<Entity*>(warriorNode), 
+            resolveDir, collisionInfo.getLength());
+}
+
+void MainGameScreen::handleProjectileImpact(SceneNode *projectileNode, 
+        SceneNode *levelNode, CollisionInfo &collisionInfo)
+{
+    if (collisionInfo.getContactState() == ContactStates::STAY)
+    {
+        return;
+    }
+    projectileNode->setStatus(WorldObjectStatus::DESTORYED);
 }
 
 void MainGameScreen::handleCollision(float dt)
 {
+    ProfileZone zone{ "MainGameScreen::handleCollision" };
     // Here are the collision information stored, which we use later and 
     // the affected SceneNodes
     std::vector<CollisionInfo> collisionData;
 
-    m_sceneGraph.checkSceneCollision(m_sceneGraph, collisionData);
-    for (CollisionInfo collisionInfo : collisionData)
-    {
-        SceneNode *sceneNodeFirst{ collisionInfo.getCollidedFirst() };
-        SceneNode *sceneNodeSecond{ collisionInfo.getCollidedSecond() };
-        SceneNode::Pair sceneNodes{ collisionInfo.getCollidedFirst(), 
-            collisionInfo.getCollidedSecond() };
-        if (matchesCategories(sceneNodes, 
-                    WorldObjectTypes::WARRIOR, WorldObjectTypes::WARRIOR))
-        {
-            resolveEntityCollisions(sceneNodeFirst, sceneNodeSecond, collisionInfo);
-        }
-        else if (matchesCategories(sceneNodes, 
-                    WorldObjectTypes::WEAPON, WorldObjectTypes::WARRIOR))
-        {
-            Weapon *weapon{ static_cast<Weapon*>
-                (getSceneNodeOfType(sceneNodes, WorldObjectTypes::WEAPON)) };
-            Warrior *warrior{ static_cast<Warrior*>
-                (getSceneNodeOfType(sceneNodes, WorldObjectTypes::WARRIOR)) };
-            std::string warriorID{ warrior->getID() };
-            // Only damage warrior if the weapon is not its own
-            // Alternative implementation for future (?): no collision check with 
-            // parent nodes
-            if (warrior->getWeapon() != weapon && 
-                    !weapon->wasIDAlreadyAttacked(warriorID))
-            {
-                warrior->handleDamage(weapon);
-                // If the weapon was a projectile it should get destroyed after
-                // colliding with warrior
-                if (weapon->getType() & WorldObjectTypes::PROJECTILE)
-                {
-                    weapon->setStatus(WorldObjectStatus::DESTORYED);
-                }
-            }
-        }
-        else if (matchesCategories(sceneNodes, 
-                    WorldObjectTypes::WARRIOR, WorldObjectTypes::LEVEL))
-        {
-            Warrior *warrior{ static_cast<Warrior*>
-                (getSceneNodeOfType(sceneNodes, WorldObjectTypes::WARRIOR)) };
-
-            float overlap{ collisionInfo.getLength() };
-            warrior->moveInDirection(collisionInfo.getResolveDirOfFirst(), 
-                    overlap);
-        }
-        else if (matchesCategories(sceneNodes, 
-                    WorldObjectTypes::PROJECTILE, WorldObjectTypes::LEVEL))
+    {
+        ProfileZone checkZone{ "CollisionWorld::findCollisions" };
+        // The transforms are fixed from here on, so the shapes can cache them
+        CollisionShape::collisionFrame++;
+        m_collisionWorld.update(m_sceneGraph);
+        // First stop the fast nodes at obstacles they would pass in this frame
+        std::vector<CollisionWorld::SweepHit> sweepHits;
+        m_collisionWorld.findSweepHits(sweepHits);
+        if (!sweepHits.empty())
         {
-            Entity *entity{ static_cast<Entity*>
-                (getSceneNodeOfType(sceneNodes, WorldObjectTypes::PROJECTILE)) };
-            entity->setStatus(WorldObjectStatus::DESTORYED);
+            handleSweepHits(sweepHits);
+            // The nodes were moved, so the shapes have to get updated
+            CollisionShape::collisionFrame++;
+            m_collisionWorld.update(m_sceneGraph);
         }
+        m_collisionWorld.findCollisions(collisionData);
     }
-}
-
-SceneNode* MainGameScreen::getSceneNodeOfType(SceneNode::Pair sceneNodePair, WorldObjectTypes type)
-{
-    SceneNode *sceneNodeOne = sceneNodePair.first;
-    SceneNode *sceneNodeTwo = sceneNodePair.second;
-    if (sceneNodeOne->getType() & type)
+    Profiler::setCounter("broadphase pairs", 
+            m_collisionWorld.getBroadPhasePairCnt());
+    Profiler::setCounter("collision pairs", collisionData.size());
+    Profiler::setCounter("contact begins", 
+            m_collisionWorld.getContactStats().beginCnt);
+    Profiler::setCounter("contact ends", 
+            m_collisionWorld.getContactStats().endCnt);
+    for (CollisionInfo &collisionInfo : collisionData)
     {
-        return sceneNodeOne;
+        m_collisionWorld.getLayerMatrix().dispatch(collisionInfo);
     }
-    else if (sceneNodeTwo->getType() & type)
     {
-        return sceneNodeTwo;
+        ProfileZone solverZone{ "ContactSolver::solve" };
+        m_contactSolver.solve();
     }
-    return nullptr;
+    const ContactSolver::Stats &SolverStats{ m_contactSolver.getStats() };
+    Profiler::setCounter("solver iterations", SolverStats.iterations);
+    Profiler::setCounter("solver remaining penetration", 
+            SolverStats.remainingPenetration);
 }
 
-bool MainGameScreen::matchesCategories(SceneNode::Pair &colliders, unsigned int type1, unsigned int type2)
+void MainGameScreen::handleSweepHits(
+        const std::vector<CollisionWorld::SweepHit> &sweepHits)
 {
-    unsigned int category1 = colliders.first->getType();
-    unsigned int category2 = colliders.second->getType();
-
-    if (type1 & category1 && type2 & category2)
-    {
-        return true;
-    }
-    else if (type1 & category2 && type2 & category1)
+    for (const CollisionWorld::SweepHit &SweepHit : sweepHits)
     {
-        std::swap(colliders.first, colliders.second);
-        return true;
+        SceneNode *node{ SweepHit.node };
+        // Move the node back to the point where it hits the obstacle. Keep a 
+        // small distance, so the node is not stuck in the obstacle
+        const sf::Vector2f LastPos{ node->getLastPosition() };
+        const sf::Vector2f Movement{ node->getPosition() - LastPos };
+        const float MovementLength{ Calc::getVec2Length(Movement) };
+        const float TimeOfImpact{ std::max(0.f, 
+                SweepHit.timeOfImpact - 0.1f / MovementLength) };
+        node->setPosition(LastPos + Movement * TimeOfImpact);
+        // Projectiles get destroyed at the wall, other nodes just stop there
+        if (node->getType() & WorldObjectTypes::PROJECTILE && 
+                SweepHit.obstacle->getType() & WorldObjectTypes::LEVEL)
+        {
+            node->setStatus(WorldObjectStatus::DESTORYED);
+        }
     }
-    return false;
 }
 
 void MainGameScreen::render()
 {
+    ProfileZone zone{ "MainGameScreen::render" };
     // If the MainGameScreen is not in foreground it is paused
     bool isGamePaused{ !m_screenStack->isInForeground(this) };
+    // While paused there is no update, so the last one is shown completely
+    const float Interpolation{ isGamePaused ? 1.f : 
+        (m_isPipelined ? m_snapshotInterpolation : m_renderInterpolation) };
+    updateCamera(Interpolation);
     if (isGamePaused && sf::Shader::isAvailable() && m_isRenderTextureAvailable)
     {
         // Draw first to a RenderTexture and then draw the RenderTexture whith the
@@ -694,7 +1916,7 @@ void MainGameScreen::render()
         m_renderTexture.clear();
         m_renderTexture.setView(m_gameView);
         m_renderTexture.draw(*m_context.background);
-        m_renderTexture.draw(m_renderManager);
+        drawScene(m_renderTexture, Interpolation);
         
         m_renderTexture.setView(m_guiView);
         m_renderTexture.draw(m_guiEnvironment);
@@ -710,7 +1932,7 @@ void MainGameScreen::render()
     {
         m_window.setView(m_gameView);
         m_window.draw(*m_context.background);
-        m_window.draw(m_renderManager);
+        drawScene(m_window, Interpolation);
         
         m_window.setView(m_guiView);
         m_window.draw(m_guiEnvironment);
@@ -718,6 +1940,33 @@ void MainGameScreen::render()
     m_window.setView(m_gameView);
 }
 
+void MainGameScreen::drawScene(sf::RenderTarget &target, float interpolation)
+{
+    if (!m_isPipelined)
+    {
+        // The snapshot dont contain the collision shapes
+        if (interpolation >= 1.f || 
+                CollisionShape::drawCollisionShapes)
+        {
+            target.draw(m_renderManager);
+            return;
+        }
+        // Draw the scene between the transforms of the last two updates
+        m_renderSnapshot.clear();
+        m_sceneGraph.addToRenderSnapshot(m_renderSnapshot, 
+                RenderSnapshot::NoParent);
+        m_renderSnapshot.sortByLayer();
+        m_renderSnapshot.draw(target, sf::RenderStates::Default, 
+                interpolation);
+        return;
+    }
+    // The simulation thread works on the nodes, so only the snapshot is used
+    m_frameBuffer.getFrontBuffer().scene.draw(target, sf::RenderStates::Default,
+            interpolation);
+    Profiler::setCounter("frame latency ms", 
+            m_frameBuffer.getFrontAge() * 1000.f);
+}
+
 void MainGameScreen::windowSizeChanged()
 {
     calcGuiSizeAndPos();
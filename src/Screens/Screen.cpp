@@ -15,12 +15,14 @@ Screen::Screen(ScreenStack *screenStack, Context &context)
 : m_context{ context }
 , m_screenStack{ screenStack }
 , m_renderManager{ &m_sceneGraph }
+, m_renderInterpolation{ 1.f }
 {
 
 }
 
 Screen::Context::Context(
     ConfigManager *config,
+    ConfigRegistry *configRegistry,
     sf::RenderWindow *window, 
     ResourceHolder<sf::Font> *fontHolder,
     ResourceHolder<sf::Texture> *textureHolder, 
@@ -29,8 +31,10 @@ Screen::Context::Context(
     LevelHolder *levelHolder,
     MusicPlayer *music,
     SoundPlayer *sound,
-    sf::RectangleShape *background)
+    sf::RectangleShape *background,
+    JobSystem *jobSystem)
 : config{ config }
+, configRegistry{ configRegistry }
 , window{ window }
 , gameView{ window->getView() }
 , guiView{ window->getView() }
@@ -42,6 +46,7 @@ Screen::Context::Context(
 , music{ music }
 , sound{ sound }
 , background{ background }
+, jobSystem{ jobSystem }
 {
 
 }
@@ -66,6 +71,11 @@ void Screen::windowSizeChanged()
     // Do nothing by default
 }
 
+void Screen::setRenderInterpolation(float interpolation)
+{
+    m_renderInterpolation = interpolation;
+}
+
 bool Screen::handleInput(Input &input, float dt)
 {
     return true;
@@ -1,4 +1,5 @@
 #include "Screens/ScreenStack.hpp"
+#include "Profiling/Profiler.hpp"
 
 
 ScreenStack::ScreenStack(Screen::Context &context)
@@ -45,6 +46,7 @@ void ScreenStack::handleEvent(sf::Event &event, float dt)
 
 void ScreenStack::update(float dt)
 {
+    ProfileZone zone{ "ScreenStack::update" };
     for (auto itr = m_stack.rbegin(); itr != m_stack.rend(); itr++)
     {
         if (!(*itr)->update(dt))
@@ -58,6 +60,7 @@ void ScreenStack::update(float dt)
 
 void ScreenStack::render()
 {
+    ProfileZone zone{ "ScreenStack::render" };
     //for (Screen::Ptr screen : m_stack)
     for (std::unique_ptr<Screen> &screen : m_stack)
     {
@@ -136,3 +139,11 @@ void ScreenStack::windowSizeChanged()
         screen->windowSizeChanged();
     }
 }
+
+void ScreenStack::setRenderInterpolation(float interpolation)
+{
+    for (std::unique_ptr<Screen> &screen : m_stack)
+    {
+        screen->setRenderInterpolation(interpolation);
+    }
+}
@@ -0,0 +1,136 @@
+#include "Serialization/BinaryReader.hpp"
+#include <cstring>
+
+BinaryReader::BinaryReader(const char *data, std::size_t size)
+: m_data{ data }
+, m_size{ size }
+, m_pos{ 0 }
+, m_isValid{ true }
+{
+
+}
+
+std::uint8_t BinaryReader::readUInt8()
+{
+    if (m_pos >= m_size)
+    {
+        m_isValid = false;
+        return 0;
+    }
+    std::uint8_t value{ static_cast<std::uint8_t>(m_data[m_pos]) };
+    m_pos++;
+    return value;
+}
+
+std::uint16_t BinaryReader::readUInt16()
+{
+    const std::uint16_t Low{ readUInt8() };
+    const std::uint16_t High{ readUInt8() };
+    return static_cast<std::uint16_t>(Low | (High << 8));
+}
+
+std::uint32_t BinaryReader::readUInt32()
+{
+    const std::uint32_t Low{ readUInt16() };
+    const std::uint32_t High{ readUInt16() };
+    return Low | (High << 16);
+}
+
+std::uint64_t BinaryReader::readUInt64()
+{
+    const std::uint64_t Low{ readUInt32() };
+    const std::uint64_t High{ readUInt32() };
+    return Low | (High << 32);
+}
+
+std::uint64_t BinaryReader::readVarUInt()
+{
+    std::uint64_t value{ 0 };
+    for (unsigned int shift{ 0 }; shift < 64; shift += 7)
+    {
+        const std::uint8_t Byte{ readUInt8() };
+        value |= static_cast<std::uint64_t>(Byte & 0x7F) << shift;
+        if ((Byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    // Too many bytes, the data is corrupt
+    m_isValid = false;
+    return 0;
+}
+
+std::int64_t BinaryReader::readVarInt()
+{
+    const std::uint64_t Value{ readVarUInt() };
+    return static_cast<std::int64_t>((Value >> 1) ^ (~(Value & 1) + 1));
+}
+
+float BinaryReader::readFloat()
+{
+    const std::uint32_t Bits{ readUInt32() };
+    float value;
+    std::memcpy(&value, &Bits, sizeof(value));
+    return value;
+}
+
+bool BinaryReader::readBool()
+{
+    return readUInt8() != 0;
+}
+
+std::string BinaryReader::readString()
+{
+    const std::uint64_t Size{ readVarUInt() };
+    if (Size > getRemainingSize())
+    {
+        m_isValid = false;
+        return "";
+    }
+    std::string value(m_data + m_pos, static_cast<std::size_t>(Size));
+    m_pos += static_cast<std::size_t>(Size);
+    return value;
+}
+
+bool BinaryReader::readBytes(char *data, std::size_t size)
+{
+    if (size > getRemainingSize())
+    {
+        m_isValid = false;
+        return false;
+    }
+    std::memcpy(data, m_data + m_pos, size);
+    m_pos += size;
+    return true;
+}
+
+bool BinaryReader::skipBytes(std::size_t size)
+{
+    if (size > getRemainingSize())
+    {
+        m_isValid = false;
+        return false;
+    }
+    m_pos += size;
+    return true;
+}
+
+bool BinaryReader::isValid() const
+{
+    return m_isValid;
+}
+
+bool BinaryReader::isAtEnd() const
+{
+    return m_pos >= m_size;
+}
+
+std::size_t BinaryReader::getPosition() const
+{
+    return m_pos;
+}
+
+std::size_t BinaryReader::getRemainingSize() const
+{
+    return m_size - m_pos;
+}
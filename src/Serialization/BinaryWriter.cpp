@@ -0,0 +1,88 @@
+#include "Serialization/BinaryWriter.hpp"
+#include <cstring>
+
+void BinaryWriter::writeUInt8(std::uint8_t value)
+{
+    m_buffer.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeUInt16(std::uint16_t value)
+{
+    writeUInt8(static_cast<std::uint8_t>(value));
+    writeUInt8(static_cast<std::uint8_t>(value >> 8));
+}
+
+void BinaryWriter::writeUInt32(std::uint32_t value)
+{
+    writeUInt16(static_cast<std::uint16_t>(value));
+    writeUInt16(static_cast<std::uint16_t>(value >> 16));
+}
+
+void BinaryWriter::writeUInt64(std::uint64_t value)
+{
+    writeUInt32(static_cast<std::uint32_t>(value));
+    writeUInt32(static_cast<std::uint32_t>(value >> 32));
+}
+
+void BinaryWriter::writeVarUInt(std::uint64_t value)
+{
+    // 7 bits per byte, the highest bit marks that another byte follows
+    while (value >= 0x80)
+    {
+        writeUInt8(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    writeUInt8(static_cast<std::uint8_t>(value));
+}
+
+void BinaryWriter::writeVarInt(std::int64_t value)
+{
+    // 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+    writeVarUInt((static_cast<std::uint64_t>(value) << 1) ^ 
+            static_cast<std::uint64_t>(value >> 63));
+}
+
+void BinaryWriter::writeFloat(float value)
+{
+    static_assert(sizeof(float) == sizeof(std::uint32_t), 
+            "Floats have to be 32 bit");
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeUInt32(bits);
+}
+
+void BinaryWriter::writeBool(bool value)
+{
+    writeUInt8(value ? 1 : 0);
+}
+
+void BinaryWriter::writeString(const std::string &value)
+{
+    writeVarUInt(value.size());
+    writeBytes(value.data(), value.size());
+}
+
+void BinaryWriter::writeBytes(const char *data, std::size_t size)
+{
+    m_buffer.insert(m_buffer.end(), data, data + size);
+}
+
+const std::vector<char>& BinaryWriter::getBuffer() const
+{
+    return m_buffer;
+}
+
+const char* BinaryWriter::getData() const
+{
+    return m_buffer.data();
+}
+
+std::size_t BinaryWriter::getSize() const
+{
+    return m_buffer.size();
+}
+
+void BinaryWriter::clear()
+{
+    m_buffer.clear();
+}
@@ -0,0 +1,272 @@
+#include "Snapshot/WorldSnapshot.hpp"
+#include "Components/Weapon.hpp"
+#include "Random/RandomService.hpp"
+#include "Serialization/BinaryReader.hpp"
+#include <algorithm>
+
+namespace
+{
+    // "ASNP" in the file
+    const std::uint32_t Magic{ 0x504E5341 };
+    // Has to be increased, when the state of a node changes
+    const std::uint16_t Version{ 1 };
+    const std::size_t StreamCnt{
+        static_cast<std::size_t>(RandomStreams::COUNT) };
+
+    bool isIdLess(const std::pair<unsigned int, SceneNode*> &entry,
+            unsigned int nodeId)
+    {
+        return entry.first < nodeId;
+    }
+}
+
+WorldSnapshot::WorldSnapshot()
+: m_step{ 0 }
+, m_nodeCnt{ 0 }
+{
+
+}
+
+void WorldSnapshot::save(SceneNode &sceneGraph, std::uint64_t step)
+{
+    m_writer.clear();
+    m_writer.writeUInt32(Magic);
+    m_writer.writeUInt16(Version);
+    m_writer.writeUInt64(step);
+    for (std::size_t i{ 0 }; i < StreamCnt; i++)
+    {
+        const RandomStream::State &State{ RandomService::getStream(
+                static_cast<RandomStreams>(i)).getState() };
+        m_writer.writeUInt64(State.state);
+        m_writer.writeUInt64(State.increment);
+    }
+    m_nodes.clear();
+    sceneGraph.collectNodes(m_nodes);
+    m_writer.writeVarUInt(m_nodes.size());
+    for (const SceneNode *node : m_nodes)
+    {
+        const SceneNode *Parent{ node->getParent() };
+        unsigned int spawnerId{ 0 };
+        if (node->getType() & WorldObjectTypes::PROJECTILE)
+        {
+            spawnerId = static_cast<const Weapon*>(node)->getSpawnerId();
+        }
+        m_writer.writeVarUInt(node->getNodeId());
+        m_writer.writeVarUInt(Parent ? Parent->getNodeId() : 0);
+        m_writer.writeVarUInt(node->getType());
+        m_writer.writeVarUInt(spawnerId);
+        m_nodeWriter.clear();
+        node->saveState(m_nodeWriter);
+        m_writer.writeVarUInt(m_nodeWriter.getSize());
+        m_writer.writeBytes(m_nodeWriter.getData(), m_nodeWriter.getSize());
+    }
+    m_step = step;
+    m_nodeCnt = m_nodes.size();
+    m_createdIds.clear();
+}
+
+bool WorldSnapshot::restore(SceneNode &sceneGraph,
+        const NodeFactory &nodeFactory)
+{
+    BinaryReader reader{ m_writer.getData(), m_writer.getSize() };
+    if (reader.readUInt32() != Magic || reader.readUInt16() != Version)
+    {
+        return false;
+    }
+    const std::uint64_t Step{ reader.readUInt64() };
+    RandomStream::State streamStates[StreamCnt];
+    for (RandomStream::State &state : streamStates)
+    {
+        state.state = reader.readUInt64();
+        state.increment = reader.readUInt64();
+    }
+    const std::uint64_t NodeCnt{ reader.readVarUInt() };
+    if (!reader.isValid())
+    {
+        return false;
+    }
+
+    m_nodes.clear();
+    sceneGraph.collectNodes(m_nodes);
+    m_nodesById.clear();
+    for (SceneNode *node : m_nodes)
+    {
+        m_nodesById.push_back({ node->getNodeId(), node });
+    }
+    std::sort(m_nodesById.begin(), m_nodesById.end(),
+            [] (const std::pair<unsigned int, SceneNode*> &a,
+                const std::pair<unsigned int, SceneNode*> &b)
+            {
+                return a.first < b.first;
+            });
+    m_isNodeRestored.assign(m_nodesById.size(), 0);
+    m_createdNodes.clear();
+    m_createdSubtree.clear();
+    std::size_t nextSubtreeNode{ 0 };
+    bool isComplete{ true };
+    for (std::uint64_t i{ 0 }; i < NodeCnt; i++)
+    {
+        const unsigned int NodeId{
+            static_cast<unsigned int>(reader.readVarUInt()) };
+        const unsigned int ParentId{
+            static_cast<unsigned int>(reader.readVarUInt()) };
+        const unsigned int Types{
+            static_cast<unsigned int>(reader.readVarUInt()) };
+        const unsigned int SpawnerId{
+            static_cast<unsigned int>(reader.readVarUInt()) };
+        const std::size_t StateSize{
+            static_cast<std::size_t>(reader.readVarUInt()) };
+        const char *StateData{ m_writer.getData() + reader.getPosition() };
+        if (!reader.skipBytes(StateSize))
+        {
+            return false;
+        }
+
+        SceneNode *parent{ findNode(ParentId) };
+        SceneNode *node{ nullptr };
+        // The children of a created node (e.g. the body parts of a warrior)
+        // were created with it and are in the same order as in the snapshot
+        if (nextSubtreeNode < m_createdSubtree.size() &&
+                m_createdSubtree[nextSubtreeNode]->getParent() == parent)
+        {
+            node = m_createdSubtree[nextSubtreeNode];
+            nextSubtreeNode++;
+            addCreatedNode(NodeId, node);
+        }
+        else
+        {
+            nextSubtreeNode = m_createdSubtree.size();
+            node = findNode(NodeId);
+        }
+        if (!node)
+        {
+            SceneNode::Ptr createdNode{ nullptr };
+            if (parent)
+            {
+                createdNode = nodeFactory(Types,
+                        SpawnerId != 0 ? findNode(SpawnerId) : nullptr);
+            }
+            if (!createdNode)
+            {
+                isComplete = false;
+                continue;
+            }
+            node = createdNode.get();
+            addCreatedNode(NodeId, node);
+            m_createdSubtree.clear();
+            node->collectNodes(m_createdSubtree);
+            nextSubtreeNode = 1;
+            parent->attachChild(std::move(createdNode));
+        }
+        markAsRestored(node);
+        BinaryReader stateReader{ StateData, StateSize };
+        node->loadState(stateReader);
+        if (!stateReader.isValid())
+        {
+            isComplete = false;
+        }
+    }
+    // The nodes which didnt exist, when the snapshot was saved
+    for (std::size_t i{ 0 }; i < m_nodesById.size(); i++)
+    {
+        if (!m_isNodeRestored[i])
+        {
+            m_nodesById[i].second->setStatus(WorldObjectStatus::DESTORYED);
+        }
+    }
+    // Creating the nodes can draw random numbers (e.g. the ids of the 
+    // warriors), so the streams are restored at last
+    for (std::size_t i{ 0 }; i < StreamCnt; i++)
+    {
+        RandomService::getStream(static_cast<RandomStreams>(i)).setState(
+                streamStates[i]);
+    }
+    m_step = Step;
+    m_nodeCnt = static_cast<std::size_t>(NodeCnt);
+    return isComplete && reader.isValid();
+}
+
+void WorldSnapshot::setData(const char *data, std::size_t size)
+{
+    m_writer.clear();
+    m_writer.writeBytes(data, size);
+    m_nodeCnt = 0;
+    m_createdIds.clear();
+}
+
+const char* WorldSnapshot::getData() const
+{
+    return m_writer.getData();
+}
+
+std::size_t WorldSnapshot::getSize() const
+{
+    return m_writer.getSize();
+}
+
+bool WorldSnapshot::isEmpty() const
+{
+    return m_writer.getSize() == 0;
+}
+
+std::uint64_t WorldSnapshot::getStep() const
+{
+    return m_step;
+}
+
+std::size_t WorldSnapshot::getNodeCnt() const
+{
+    return m_nodeCnt;
+}
+
+SceneNode* WorldSnapshot::findNode(unsigned int nodeId) const
+{
+    // Only a few nodes are created by a restore
+    for (const auto &Created : m_createdNodes)
+    {
+        if (Created.first == nodeId)
+        {
+            return Created.second;
+        }
+    }
+    // The node could be created by an earlier restore
+    for (const auto &CreatedId : m_createdIds)
+    {
+        if (CreatedId.first == nodeId)
+        {
+            nodeId = CreatedId.second;
+            break;
+        }
+    }
+    auto found = std::lower_bound(m_nodesById.begin(), m_nodesById.end(),
+            nodeId, isIdLess);
+    if (found != m_nodesById.end() && found->first == nodeId)
+    {
+        return found->second;
+    }
+    return nullptr;
+}
+
+void WorldSnapshot::markAsRestored(const SceneNode *node)
+{
+    auto found = std::lower_bound(m_nodesById.begin(), m_nodesById.end(),
+            node->getNodeId(), isIdLess);
+    if (found != m_nodesById.end() && found->second == node)
+    {
+        m_isNodeRestored[found - m_nodesById.begin()] = 1;
+    }
+}
+
+void WorldSnapshot::addCreatedNode(unsigned int savedId, SceneNode *node)
+{
+    m_createdNodes.push_back({ savedId, node });
+    for (auto &createdId : m_createdIds)
+    {
+        if (createdId.first == savedId)
+        {
+            createdId.second = node->getNodeId();
+            return;
+        }
+    }
+    m_createdIds.push_back({ savedId, node->getNodeId() });
+}
@@ -1,35 +1,133 @@
 #include "Sound/MusicPlayer.hpp"
+#include <algorithm>
 #include <iostream>
 
+const std::size_t MusicPlayer::StreamCnt;
+
 MusicPlayer::MusicPlayer()
-: m_music{ }
-, m_fileNames{ }
+: m_fileNames{ }
+, m_current{ nullptr }
+, m_pending{ nullptr }
+, m_fadeTime{ 1.f }
 , m_volume{ 100.f }
+, m_isPaused{ false }
+, m_useCnt{ 0 }
+, m_isStopping{ false }
 {
-
+    for (Stream &stream : m_streams)
+    {
+        stream.state = StreamState::EMPTY;
+        stream.fade = 0.f;
+        stream.lastUse = 0;
+    }
+    m_loaderThread = std::thread{ &MusicPlayer::runLoader, this };
 }
 
-void MusicPlayer::play(const std::string &id)
+MusicPlayer::~MusicPlayer()
 {
-    std::string fileName = m_fileNames[id];
-
-    if (!m_music.openFromFile(fileName))
     {
-        throw std::runtime_error("Music " + fileName + " could not be loaded.");
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_isStopping = true;
     }
+    m_loadCondition.notify_all();
+    m_loaderThread.join();
+}
 
-    m_music.setVolume(m_volume);
-    m_music.setLoop(true);
-    m_music.play();
+void MusicPlayer::play(const std::string &id, float fadeTime)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    if (m_fileNames.find(id) == m_fileNames.end())
+    {
+        throw std::runtime_error("Music " + id + " is not added.");
+    }
     m_currentPlayed = id;
+    m_fadeTime = fadeTime;
+    if (m_current && m_current->id == id && 
+            m_current->state == StreamState::PLAYING)
+    {
+        m_pending = nullptr;
+        return;
+    }
+    m_pending = requestStream(id);
+    if (!m_pending)
+    {
+        // All streams are used, the fading track is cut
+        for (Stream &stream : m_streams)
+        {
+            if (stream.state == StreamState::FADING_OUT)
+            {
+                stream.music.stop();
+                stream.state = StreamState::READY;
+            }
+        }
+        m_pending = requestStream(id);
+    }
 }
 
-void MusicPlayer::stop()
+void MusicPlayer::stop(float fadeTime)
 {
-    m_music.stop();
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_fadeTime = fadeTime;
+    if (m_current)
+    {
+        m_current->state = StreamState::FADING_OUT;
+        m_current = nullptr;
+    }
+    m_pending = nullptr;
     m_currentPlayed = "";
 }
 
+void MusicPlayer::preload(const std::string &id)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    if (m_fileNames.find(id) != m_fileNames.end())
+    {
+        requestStream(id);
+    }
+}
+
+void MusicPlayer::update(float dt)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    if (m_pending && (m_pending->state == StreamState::READY || 
+                m_pending->state == StreamState::FADING_OUT))
+    {
+        startStream(*m_pending);
+        m_pending = nullptr;
+    }
+    else if (m_pending && m_pending->state == StreamState::FAILED)
+    {
+        std::cout << "Music " << m_pending->fileName << 
+            " could not be loaded." << std::endl;
+        m_pending = nullptr;
+    }
+    if (m_isPaused)
+    {
+        return;
+    }
+    const float FadeStep{ m_fadeTime > 0.f ? dt / m_fadeTime : 1.f };
+    for (Stream &stream : m_streams)
+    {
+        if (stream.state == StreamState::PLAYING && stream.fade < 1.f)
+        {
+            stream.fade = std::min(stream.fade + FadeStep, 1.f);
+            applyVolume(stream);
+        }
+        else if (stream.state == StreamState::FADING_OUT)
+        {
+            stream.fade -= FadeStep;
+            if (stream.fade <= 0.f)
+            {
+                // The stream stays open, so the track can be played again
+                stream.fade = 0.f;
+                stream.music.stop();
+                stream.state = StreamState::READY;
+            }
+            applyVolume(stream);
+        }
+    }
+}
+
 std::string MusicPlayer::getCurrentId() const
 {
     return m_currentPlayed;
@@ -37,20 +135,38 @@ std::string MusicPlayer::getCurrentId() const
 
 void MusicPlayer::setPaused(bool paused)
 {
-    if (paused)
-    {
-        m_music.pause();
-    }
-    else
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_isPaused = paused;
+    for (Stream &stream : m_streams)
     {
-        m_music.play();
+        if (stream.state != StreamState::PLAYING && 
+                stream.state != StreamState::FADING_OUT)
+        {
+            continue;
+        }
+        if (paused)
+        {
+            stream.music.pause();
+        }
+        else
+        {
+            stream.music.play();
+        }
     }
 }
 
 void MusicPlayer::setVolume(float volume)
 {
+    std::lock_guard<std::mutex> lock{ m_mutex };
     m_volume = volume;
-    m_music.setVolume(volume);
+    for (Stream &stream : m_streams)
+    {
+        if (stream.state == StreamState::PLAYING || 
+                stream.state == StreamState::FADING_OUT)
+        {
+            applyVolume(stream);
+        }
+    }
 }
 
 float MusicPlayer::getVolume() const
@@ -60,5 +176,124 @@ float MusicPlayer::getVolume() const
 
 void MusicPlayer::add(const std::string &id, const std::string &fileName)
 {
+    std::lock_guard<std::mutex> lock{ m_mutex };
     m_fileNames[id] = fileName;
 }
+
+void MusicPlayer::setFollowUps(const std::string &id, 
+        const std::vector<std::string> &followUps)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_followUps[id] = followUps;
+}
+
+void MusicPlayer::runLoader()
+{
+    std::unique_lock<std::mutex> lock{ m_mutex };
+    while (true)
+    {
+        m_loadCondition.wait(lock, [this] ()
+                {
+                    return m_isStopping || !m_loadQueue.empty();
+                });
+        if (m_isStopping)
+        {
+            return;
+        }
+        Stream &stream{ *m_loadQueue.front() };
+        m_loadQueue.pop_front();
+        const std::string FileName{ stream.fileName };
+        // The stream is LOADING, so the other threads dont touch it
+        lock.unlock();
+        const bool IsOpen{ stream.music.openFromFile(FileName) };
+        lock.lock();
+        stream.state = IsOpen ? StreamState::READY : StreamState::FAILED;
+    }
+}
+
+MusicPlayer::Stream* MusicPlayer::requestStream(const std::string &id)
+{
+    for (Stream &stream : m_streams)
+    {
+        if (stream.id == id && stream.state != StreamState::EMPTY && 
+                stream.state != StreamState::FAILED)
+        {
+            stream.lastUse = ++m_useCnt;
+            return &stream;
+        }
+    }
+    Stream *stream{ findFreeStream() };
+    if (!stream)
+    {
+        return nullptr;
+    }
+    stream->id = id;
+    stream->fileName = m_fileNames[id];
+    stream->state = StreamState::LOADING;
+    stream->fade = 0.f;
+    stream->lastUse = ++m_useCnt;
+    m_loadQueue.push_back(stream);
+    m_loadCondition.notify_one();
+    return stream;
+}
+
+MusicPlayer::Stream* MusicPlayer::findFreeStream()
+{
+    Stream *found{ nullptr };
+    for (Stream &stream : m_streams)
+    {
+        if (stream.state == StreamState::EMPTY)
+        {
+            return &stream;
+        }
+        // A ready stream can be replaced, unless it waits to be played
+        const bool IsReplaceable{ (stream.state == StreamState::READY && 
+                &stream != m_pending) || 
+            stream.state == StreamState::FAILED };
+        if (IsReplaceable && (!found || stream.lastUse < found->lastUse))
+        {
+            found = &stream;
+        }
+    }
+    return found;
+}
+
+void MusicPlayer::startStream(Stream &stream)
+{
+    if (m_current && m_current != &stream)
+    {
+        m_current->state = StreamState::FADING_OUT;
+    }
+    m_current = &stream;
+    // When the track was fading out, it fades in from its current volume
+    if (stream.state != StreamState::FADING_OUT)
+    {
+        stream.fade = m_fadeTime > 0.f ? 0.f : 1.f;
+        stream.music.setLoop(true);
+        stream.music.play();
+        if (m_isPaused)
+        {
+            stream.music.pause();
+        }
+    }
+    stream.state = StreamState::PLAYING;
+    stream.lastUse = ++m_useCnt;
+    applyVolume(stream);
+    // Open the next tracks, while this one plays
+    auto found = m_followUps.find(stream.id);
+    if (found != m_followUps.end())
+    {
+        for (const std::string &FollowUp : found->second)
+        {
+            if (m_fileNames.find(FollowUp) != m_fileNames.end())
+            {
+                requestStream(FollowUp);
+            }
+        }
+    }
+}
+
+void MusicPlayer::applyVolume(Stream &stream)
+{
+    stream.music.setVolume(m_volume * stream.fade);
+}
@@ -1,43 +1,216 @@
 #include "Sound/SoundPlayer.hpp"
-#include <iostream>
+#include "Profiling/Profiler.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+const std::size_t SoundPlayer::VoiceCnt;
 
 SoundPlayer::SoundPlayer()
 : m_soundHolder{ }
-, m_sounds{ }
+, m_voices(VoiceCnt)
+, m_frame{ 1 }
+, m_startOrder{ 0 }
+, m_stats{}
 , m_volume{ 100.f }
+, m_listenerPosition{ 0.f, 0.f }
+, m_audibleRange{ 2000.f }
+, m_isMuted{ false }
 {
 
 }
 
-void SoundPlayer::load(const std::string &id, const std::string file)
+void SoundPlayer::load(const std::string &id, const std::string file, 
+        int priority, std::size_t maxInstances)
 {
+    std::lock_guard<std::mutex> lock{ m_mutex };
     m_soundHolder.load(id, file);
+    m_soundIndices[id] = m_soundInfos.size();
+    m_soundInfos.push_back({ &m_soundHolder.get(id), priority, 
+            std::max<std::size_t>(maxInstances, 1), 0 });
 }
 
 void SoundPlayer::play(const std::string &id)
 {
-    m_sounds.push_back(sf::Sound(m_soundHolder.get(id)));
-    m_sounds.back().setVolume(m_volume);
-    m_sounds.back().play();
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    start(id, 1.f, 0.f);
 }
 
-void SoundPlayer::removeStoppedSounds()
+void SoundPlayer::play(const std::string &id, sf::Vector2f position)
 {
-    m_sounds.remove_if([] (const sf::Sound &s)
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    const sf::Vector2f Offset{ position - m_listenerPosition };
+    const float Distance{ std::sqrt(Offset.x * Offset.x + 
+            Offset.y * Offset.y) };
+    if (Distance >= m_audibleRange)
     {
-        return s.getStatus() == sf::Sound::Stopped;
-    });
+        // Dont take a voice for a sound, which cant be heard
+        m_stats.culledSounds++;
+        return;
+    }
+    // Full volume near the listener, then fading out linear
+    const float FullVolumeRange{ m_audibleRange * 0.25f };
+    const float Gain{ Distance <= FullVolumeRange ? 1.f : 
+        1.f - (Distance - FullVolumeRange) / 
+            (m_audibleRange - FullVolumeRange) };
+    const float Pan{ std::min(std::max(
+                Offset.x / (m_audibleRange * 0.5f), -1.f), 1.f) };
+    start(id, Gain, Pan);
+}
+
+void SoundPlayer::update()
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_frame++;
+    m_stats.activeVoices = 0;
+    for (const Voice &V : m_voices)
+    {
+        if (isActive(V))
+        {
+            m_stats.activeVoices++;
+        }
+    }
+    Profiler::setCounter("active voices", m_stats.activeVoices);
+    Profiler::setCounter("played sounds", m_stats.playedSounds);
+    Profiler::setCounter("coalesced sounds", m_stats.coalescedSounds);
+    Profiler::setCounter("stolen voices", m_stats.stolenVoices);
+    Profiler::setCounter("dropped sounds", m_stats.droppedSounds);
+    Profiler::setCounter("culled sounds", m_stats.culledSounds);
 }
 
 void SoundPlayer::setVolume(float volume)
 {
+    std::lock_guard<std::mutex> lock{ m_mutex };
     m_volume = volume;
-    for (sf::Sound &sound : m_sounds) {
-        sound.setVolume(volume);
+    for (Voice &voice : m_voices) {
+        voice.sound.setVolume(volume * voice.gain);
     }
 }
 
 float SoundPlayer::getVolume() const
 {
+    std::lock_guard<std::mutex> lock{ m_mutex };
     return m_volume;
 }
+
+void SoundPlayer::setIsMuted(bool isMuted)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_isMuted = isMuted;
+}
+
+bool SoundPlayer::isMuted() const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    return m_isMuted;
+}
+
+void SoundPlayer::setListener(sf::Vector2f position, float audibleRange)
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_listenerPosition = position;
+    m_audibleRange = std::max(audibleRange, 1.f);
+}
+
+void SoundPlayer::start(const std::string &id, float gain, float pan)
+{
+    if (m_isMuted)
+    {
+        return;
+    }
+    auto found = m_soundIndices.find(id);
+    assert(found != m_soundIndices.end());
+    SoundInfo &info{ m_soundInfos[found->second] };
+    // Two attacks in the same frame sound like one, but would take two 
+    // voices
+    if (info.lastPlayFrame == m_frame)
+    {
+        m_stats.coalescedSounds++;
+        return;
+    }
+    Voice *voice{ findVoice(found->second) };
+    if (!voice)
+    {
+        m_stats.droppedSounds++;
+        return;
+    }
+    info.lastPlayFrame = m_frame;
+    voice->sound.stop();
+    if (voice->sound.getBuffer() != info.buffer)
+    {
+        voice->sound.setBuffer(*info.buffer);
+    }
+    voice->gain = gain;
+    voice->sound.setVolume(m_volume * gain);
+    // The sound is placed relative to the listener and isnt attenuated by
+    // OpenAL, so the position only pans it (Only works for mono sounds)
+    voice->sound.setRelativeToListener(true);
+    voice->sound.setAttenuation(0.f);
+    voice->sound.setPosition(pan, 0.f, -1.f);
+    voice->soundIndex = found->second;
+    voice->priority = info.priority;
+    voice->startOrder = ++m_startOrder;
+    voice->sound.play();
+    m_stats.playedSounds++;
+}
+
+SoundPlayer::Voice* SoundPlayer::findVoice(std::size_t soundIndex)
+{
+    const SoundInfo &Info{ m_soundInfos[soundIndex] };
+    std::size_t instanceCnt{ 0 };
+    Voice *oldestInstance{ nullptr };
+    Voice *freeVoice{ nullptr };
+    Voice *victim{ nullptr };
+    for (Voice &voice : m_voices)
+    {
+        if (!isActive(voice))
+        {
+            if (!freeVoice)
+            {
+                freeVoice = &voice;
+            }
+            continue;
+        }
+        if (voice.soundIndex == soundIndex)
+        {
+            instanceCnt++;
+            if (!oldestInstance || 
+                    voice.startOrder < oldestInstance->startOrder)
+            {
+                oldestInstance = &voice;
+            }
+        }
+        if (voice.priority > Info.priority)
+        {
+            continue;
+        }
+        // The lowest priority, then the quietest, then the oldest voice
+        if (!victim || voice.priority < victim->priority || 
+                (voice.priority == victim->priority && 
+                 (voice.sound.getVolume() < victim->sound.getVolume() || 
+                  (voice.sound.getVolume() == victim->sound.getVolume() && 
+                   voice.startOrder < victim->startOrder))))
+        {
+            victim = &voice;
+        }
+    }
+    if (instanceCnt >= Info.maxInstances)
+    {
+        m_stats.stolenVoices++;
+        return oldestInstance;
+    }
+    if (freeVoice)
+    {
+        return freeVoice;
+    }
+    if (victim)
+    {
+        m_stats.stolenVoices++;
+    }
+    return victim;
+}
+
+bool SoundPlayer::isActive(const Voice &voice) const
+{
+    return voice.sound.getStatus() != sf::Sound::Stopped;
+}